@@ -0,0 +1,93 @@
+#include <carise/audio/audio_thread.hpp>
+#include <carise/audio/voice_manager.hpp>
+#include <carise/core/random.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <numbers>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Game-thread cost of a sound heavy frame (dozens of hits, footsteps and creature noises), driving the
+// voice_manager directly vs posting to the audio_thread. Reports mean and spread of the per-frame time.
+// Needs an audio device; OpenAL Soft's null backend is enough (ALSOFT_DRIVERS=null).
+
+namespace {
+using namespace carise;
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t frames_v{600};
+constexpr std::size_t requests_per_frame_v{48};
+constexpr std::size_t sound_count_v{16};
+constexpr auto frame_period_v = std::chrono::microseconds{16'667};
+
+auto make_buffers() -> std::vector<sf::SoundBuffer> {
+	auto ret = std::vector<sf::SoundBuffer>(sound_count_v);
+	auto samples = std::vector<std::int16_t>(22050 / 4);
+	for (std::size_t s = 0; s < sound_count_v; ++s) {
+		auto const frequency = 220.0 * static_cast<double>(s + 1);
+		for (std::size_t i = 0; i < samples.size(); ++i) {
+			samples[i] = static_cast<std::int16_t>(8000.0 * std::sin(2.0 * std::numbers::pi * frequency * static_cast<double>(i) / 22050.0));
+		}
+		if (!ret[s].loadFromSamples(samples.data(), samples.size(), 1, 22050)) { std::fputs("failed to create sound buffer\n", stderr); }
+	}
+	return ret;
+}
+
+template <typename Frame>
+void measure(std::string_view const name, Frame&& frame) {
+	auto times = std::vector<double>{};
+	times.reserve(frames_v);
+	for (std::size_t i = 0; i < frames_v; ++i) {
+		auto random = rng{i};
+		auto const t0 = clock_type::now();
+		frame(random);
+		times.push_back(std::chrono::duration<double, std::micro>(clock_type::now() - t0).count());
+		// rest of a 60 Hz frame, so the audio thread runs between frames as it would in game
+		std::this_thread::sleep_until(t0 + frame_period_v);
+	}
+	auto mean = 0.0;
+	for (auto const t : times) { mean += t; }
+	mean /= static_cast<double>(times.size());
+	auto variance = 0.0;
+	for (auto const t : times) { variance += (t - mean) * (t - mean); }
+	std::sort(times.begin(), times.end());
+	std::printf("  %-14.*s mean %8.2f us  sd %8.2f us  p99 %8.2f us  max %8.2f us\n", static_cast<int>(name.size()), name.data(), mean,
+				std::sqrt(variance / static_cast<double>(times.size() - 1)), times[times.size() * 99 / 100], times.back());
+}
+
+auto random_request(rng& random) -> audio::play_request {
+	return audio::play_request{
+		.sound = static_cast<audio::sound_id>(random.range(0, static_cast<int>(sound_count_v) - 1)),
+		.group = static_cast<audio::category>(random.range(1, static_cast<int>(audio::category_count_v) - 1)),
+		.importance = static_cast<audio::priority>(random.range(0, 255)),
+		.volume = random.range(0.2f, 1.0f),
+		.pitch = random.range(0.9f, 1.1f),
+	};
+}
+} // namespace
+
+int main() {
+	auto const buffers = make_buffers();
+	std::printf("%zu frames, %zu sound requests per frame\n", frames_v, requests_per_frame_v);
+	{
+		auto voices = audio::voice_manager{};
+		for (auto const& buffer : buffers) { static_cast<void>(voices.add_sound(buffer)); }
+		measure("game thread", [&](rng& random) {
+			for (std::size_t r = 0; r < requests_per_frame_v; ++r) { voices.play(random_request(random)); }
+			voices.update();
+		});
+		voices.stop_all();
+	}
+	{
+		auto audio = audio::audio_thread{};
+		for (auto const& buffer : buffers) { static_cast<void>(audio.add_sound(buffer)); }
+		measure("audio thread", [&](rng& random) {
+			for (std::size_t r = 0; r < requests_per_frame_v; ++r) { audio.play(random_request(random)); }
+			audio.end_frame();
+		});
+	}
+}
@@ -0,0 +1,188 @@
+#include "scenes.hpp"
+#include "stats.hpp"
+#include <carise/render/tile_atlas.hpp>
+#include <SFML/Graphics.hpp>
+#include <SFML/OpenGL.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Plays each benchmark scene for a fixed number of frames into an offscreen render target and compares the
+// frame times against a stored baseline.
+//
+// Needs an OpenGL context but no window: on a headless CI box run under a virtual display with software GL,
+// eg `xvfb-run -a env LIBGL_ALWAYS_SOFTWARE=1 carise-framebench --baseline framebench.txt`.
+// Compare runs from the same machine and driver only.
+
+namespace {
+using namespace carise;
+using clock_type = std::chrono::steady_clock;
+
+constexpr auto usage_v = R"(usage: carise-framebench [options]
+  --frames N              measured frames per scene (default 600)
+  --warmup N              unmeasured frames per scene before measuring (default 60)
+  --size WxH              render target size (default 1280x720)
+  --scene NAME            run only this scene (repeatable)
+  --font PATH             font for text in the crowded_ui scenes
+  --baseline PATH         compare against this baseline; exit code 1 on regression
+  --write-baseline PATH   store this run's samples as a new baseline
+  --threshold X           relative median change to report (default 0.05)
+  --alpha X               significance level of the rank test (default 0.01)
+  --list                  print scene names and exit
+)";
+
+struct options {
+	std::size_t frames{600};
+	std::size_t warmup{60};
+	sf::Vector2u size{1280, 720};
+	std::vector<std::string> scenes{};
+	std::string font{};
+	std::string baseline{};
+	std::string write_baseline{};
+	double threshold{0.05};
+	double alpha{0.01};
+	bool list{};
+};
+
+auto parse(int argc, char** argv) -> std::optional<options> {
+	auto ret = options{};
+	for (int i = 1; i < argc; ++i) {
+		auto const arg = std::string_view{argv[i]};
+		auto const value = [&]() -> char const* { return i + 1 < argc ? argv[++i] : nullptr; };
+		char const* v{};
+		if (arg == "--list") {
+			ret.list = true;
+			continue;
+		}
+		if (!(v = value())) { return std::nullopt; }
+		if (arg == "--frames") {
+			ret.frames = std::strtoull(v, nullptr, 10);
+		} else if (arg == "--warmup") {
+			ret.warmup = std::strtoull(v, nullptr, 10);
+		} else if (arg == "--size") {
+			unsigned int w{}, h{};
+			if (std::sscanf(v, "%ux%u", &w, &h) != 2 || w == 0 || h == 0) { return std::nullopt; }
+			ret.size = {w, h};
+		} else if (arg == "--scene") {
+			ret.scenes.emplace_back(v);
+		} else if (arg == "--font") {
+			ret.font = v;
+		} else if (arg == "--baseline") {
+			ret.baseline = v;
+		} else if (arg == "--write-baseline") {
+			ret.write_baseline = v;
+		} else if (arg == "--threshold") {
+			ret.threshold = std::strtod(v, nullptr);
+		} else if (arg == "--alpha") {
+			ret.alpha = std::strtod(v, nullptr);
+		} else {
+			return std::nullopt;
+		}
+	}
+	if (ret.frames < 2) { return std::nullopt; }
+	return ret;
+}
+
+auto selected(options const& opts, std::string_view const name) -> bool {
+	if (opts.scenes.empty()) { return true; }
+	for (auto const& s : opts.scenes) {
+		if (s == name) { return true; }
+	}
+	return false;
+}
+
+/// \brief Frame time of one tick + draw + display, in milliseconds.
+auto run_frame(framebench::scene& scene, sf::RenderTexture& target, std::size_t const frame) -> double {
+	auto const start = clock_type::now();
+	scene.tick(frame);
+	target.clear(sf::Color::Black);
+	scene.draw(target);
+	target.display();
+	// drivers queue GL work asynchronously; wait for the GPU so the sample covers the frame's rendering
+	glFinish();
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+void print_summary(std::string_view const name, framebench::summary const& s) {
+	std::printf("%-16.*s mean %7.3f  median %7.3f  p95 %7.3f  p99 %7.3f  sd %6.3f  mad %6.3f ms\n", static_cast<int>(name.size()), name.data(), s.mean,
+				s.median, s.p95, s.p99, s.stddev, s.mad);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+	auto const opts = parse(argc, argv);
+	if (!opts) {
+		std::fputs(usage_v, stderr);
+		return 2;
+	}
+
+	auto atlas_texture = sf::Texture{};
+	if (!atlas_texture.loadFromImage(make_debug_atlas_image({16, 16}, 128))) {
+		std::fputs("failed to create atlas texture\n", stderr);
+		return 2;
+	}
+	auto const atlas = tile_atlas{atlas_texture, {16, 16}};
+	auto font = sf::Font{};
+	auto const has_font = !opts->font.empty() && font.loadFromFile(opts->font);
+	auto const ctx = framebench::context{.size = opts->size, .atlas = atlas, .font = has_font ? &font : nullptr};
+
+	auto target = sf::RenderTexture{};
+	if (!target.create(opts->size)) {
+		std::fputs("failed to create render target (is an OpenGL context available?)\n", stderr);
+		return 2;
+	}
+
+	auto scenes = framebench::make_scenes(ctx);
+	if (opts->list) {
+		for (auto const& scene : scenes) { std::printf("%.*s\n", static_cast<int>(scene->name().size()), scene->name().data()); }
+		return 0;
+	}
+
+	auto baseline = framebench::sample_set{};
+	if (!opts->baseline.empty() && !framebench::load_baseline(opts->baseline, baseline)) {
+		std::fprintf(stderr, "failed to read baseline %s\n", opts->baseline.c_str());
+		return 2;
+	}
+
+	auto results = framebench::sample_set{};
+	auto regressions = 0;
+	std::printf("%zu frames per scene (%zu warmup) at %ux%u\n", opts->frames, opts->warmup, opts->size.x, opts->size.y);
+	for (auto const& scene : scenes) {
+		if (!selected(*opts, scene->name())) { continue; }
+		auto& samples = results[std::string{scene->name()}];
+		samples.reserve(opts->frames);
+		for (std::size_t frame = 0; frame < opts->warmup + opts->frames; ++frame) {
+			auto const ms = run_frame(*scene, target, frame);
+			if (frame >= opts->warmup) { samples.push_back(ms); }
+		}
+		print_summary(scene->name(), framebench::summarize(samples));
+
+		auto const it = baseline.find(scene->name());
+		if (it == baseline.end()) {
+			if (!opts->baseline.empty()) { std::printf("  no baseline\n"); }
+			continue;
+		}
+		auto const result = framebench::compare(it->second, samples, opts->threshold, opts->alpha);
+		auto const* label = "unchanged";
+		if (result.result == framebench::verdict::slower) {
+			label = "REGRESSION";
+			++regressions;
+		} else if (result.result == framebench::verdict::faster) {
+			label = "improved";
+		}
+		std::printf("  vs baseline: median x%.3f (p = %.2g) %s\n", result.ratio, result.p_value, label);
+	}
+
+	if (!opts->write_baseline.empty()) {
+		if (!framebench::save_baseline(opts->write_baseline, results)) {
+			std::fprintf(stderr, "failed to write baseline %s\n", opts->write_baseline.c_str());
+			return 2;
+		}
+		std::printf("baseline written to %s\n", opts->write_baseline.c_str());
+	}
+	return regressions > 0 ? 1 : 0;
+}
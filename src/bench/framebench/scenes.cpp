@@ -0,0 +1,1212 @@
+#include "scenes.hpp"
+#include <carise/core/job_pool.hpp>
+#include <carise/core/random.hpp>
+#include <carise/render/action_queue.hpp>
+#include <carise/render/animation.hpp>
+#include <carise/render/camera.hpp>
+#include <carise/render/light_overlay.hpp>
+#include <carise/render/lod_map_renderer.hpp>
+#include <carise/render/minimap.hpp>
+#include <carise/render/palette.hpp>
+#include <carise/render/particle_system.hpp>
+#include <carise/render/pixel_target.hpp>
+#include <carise/render/render_queue.hpp>
+#include <carise/render/sdf_font.hpp>
+#include <carise/render/shader_tile_map.hpp>
+#include <carise/render/shape_batcher.hpp>
+#include <carise/render/static_layer_cache.hpp>
+#include <carise/render/text_cache.hpp>
+#include <carise/render/tile_map_renderer.hpp>
+#include <carise/render/vertices.hpp>
+#include <carise/ui/canvas.hpp>
+#include <carise/world/light_grid.hpp>
+#include <carise/world/tile_map.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <numbers>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace carise::framebench {
+namespace {
+constexpr float dt_v{1.0f / 60.0f};
+
+/// \brief Random floors with scattered wall clusters over a large map.
+auto make_map(sf::Vector2i const size, tile_atlas const& atlas, std::uint64_t const seed) -> tile_map {
+	auto ret = tile_map{size};
+	auto random = rng{seed};
+	auto const last = static_cast<int>(atlas.tile_count()) - 1;
+	for (int y = 0; y < size.y; ++y) {
+		for (int x = 0; x < size.x; ++x) {
+			ret.set_floor({x, y}, static_cast<tile_id>(random.range(0, last / 2)));
+			if (random.chance(0.15f)) { ret.set_wall({x, y}, static_cast<tile_id>(random.range(last / 2 + 1, last))); }
+		}
+	}
+	return ret;
+}
+
+///
+/// \brief Whole-screen 512x512 map panned along a Lissajous path, zoomed out so ~20k tiles are visible.
+///
+/// Variants draw the same frames through static_layer_cache or shader_tile_map, to compare renderers.
+///
+class huge_map : public scene {
+  public:
+	enum class mode : std::uint8_t { vertices, cached, shader };
+
+	huge_map(context const& ctx, mode const m)
+		: m_map(make_map({512, 512}, ctx.atlas, 1)), m_renderer(ctx.atlas), m_shader(ctx.atlas), m_mode(m), m_size(ctx.size) {
+		if (m_mode == mode::cached) { m_cache.emplace(m_renderer); }
+		if (m_mode == mode::shader && !m_shader.create(m_map)) { throw std::runtime_error{"shader tile map unavailable"}; }
+	}
+
+	auto name() const -> std::string_view override {
+		switch (m_mode) {
+		case mode::cached: return "huge_map_cached";
+		case mode::shader: return "huge_map_shader";
+		default: return "huge_map";
+		}
+	}
+
+	void tick(std::size_t const frame) override {
+		auto const t = static_cast<float>(frame) * dt_v;
+		auto const tile = m_renderer.atlas().tile_size();
+		auto const world = sf::Vector2f{static_cast<float>(m_map.size().x) * tile.x, static_cast<float>(m_map.size().y) * tile.y};
+		m_view = sf::View{{world.x * (0.5f + 0.3f * std::sin(t * 0.7f)), world.y * (0.5f + 0.3f * std::cos(t * 0.4f))},
+						  sf::Vector2f{static_cast<float>(m_size.x), static_cast<float>(m_size.y)} * 2.0f};
+		if (m_mode == mode::shader) {
+			m_shader.update(m_map);
+			return;
+		}
+		m_renderer.update(m_map);
+		if (m_cache) { m_cache->update(m_map, m_view); }
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		target.setView(m_view);
+		if (m_mode == mode::shader) {
+			m_shader.draw(target);
+		} else if (m_cache) {
+			m_cache->draw(target);
+		} else {
+			m_renderer.draw(target, tile_layer::floor);
+			m_renderer.draw(target, tile_layer::walls);
+		}
+		target.setView(target.getDefaultView());
+	}
+
+  private:
+	tile_map m_map;
+	tile_map_renderer m_renderer;
+	shader_tile_map m_shader;
+	mode m_mode;
+	std::optional<static_layer_cache> m_cache{};
+	sf::Vector2u m_size;
+	sf::View m_view{};
+};
+
+///
+/// \brief The same 384x216 world-unit window onto a map, drawn at full resolution or into a pixel_target.
+///
+/// "pixel_integer" and "pixel_sharp" render 384x216 pixels and upscale them, so fill cost no longer grows
+/// with the output size.
+///
+class pixel_world : public scene {
+  public:
+	enum class mode : std::uint8_t { native, integer, sharp };
+
+	pixel_world(context const& ctx, mode const m)
+		: m_map(make_map({256, 256}, ctx.atlas, 18)), m_renderer(ctx.atlas),
+		  m_target(pixel_target::config{.resolution = {384, 216},
+										.upscale = m == mode::integer ? pixel_target::filter::integer : pixel_target::filter::sharp_bilinear}),
+		  m_mode(m) {}
+
+	auto name() const -> std::string_view override {
+		switch (m_mode) {
+		case mode::integer: return "pixel_integer";
+		case mode::sharp: return "pixel_sharp";
+		default: return "pixel_native";
+		}
+	}
+
+	void tick(std::size_t const frame) override {
+		auto const t = static_cast<float>(frame) * dt_v;
+		auto const tile = m_renderer.atlas().tile_size();
+		auto const world = sf::Vector2f{static_cast<float>(m_map.size().x) * tile.x, static_cast<float>(m_map.size().y) * tile.y};
+		m_view = sf::View{{world.x * (0.5f + 0.3f * std::sin(t * 0.3f)), world.y * (0.5f + 0.3f * std::cos(t * 0.2f))}, {384.0f, 216.0f}};
+		m_renderer.update(m_map);
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		if (m_mode == mode::native) {
+			target.setView(m_view);
+			m_renderer.draw(target, tile_layer::floor);
+			m_renderer.draw(target, tile_layer::walls);
+			target.setView(target.getDefaultView());
+			return;
+		}
+		if (auto* world = m_target.begin()) {
+			world->setView(m_view);
+			m_renderer.draw(*world, tile_layer::floor);
+			m_renderer.draw(*world, tile_layer::walls);
+		}
+		m_target.present(target);
+	}
+
+  private:
+	tile_map m_map;
+	tile_map_renderer m_renderer;
+	pixel_target m_target;
+	mode m_mode;
+	sf::View m_view{};
+};
+
+/// \brief 1024x1024 map with the camera zooming from 1:1 out to the whole map and back, through lod_map_renderer.
+class map_zoom : public scene {
+  public:
+	explicit map_zoom(context const& ctx)
+		: m_map(make_map({1024, 1024}, ctx.atlas, 6)), m_renderer(ctx.atlas), m_lod(m_renderer),
+		  m_camera({static_cast<float>(ctx.size.x), static_cast<float>(ctx.size.y)}) {}
+
+	auto name() const -> std::string_view override { return "map_zoom_lod"; }
+
+	void tick(std::size_t const frame) override {
+		auto const t = static_cast<float>(frame) * dt_v;
+		auto const tile = m_renderer.atlas().tile_size();
+		auto const world = sf::Vector2f{static_cast<float>(m_map.size().x) * tile.x, static_cast<float>(m_map.size().y) * tile.y};
+		// 1 down to 1/64 screen pixels per texel on a 10 s cycle
+		m_camera.set_zoom(std::exp2(-3.0f * (1.0f - std::cos(t * 2.0f * std::numbers::pi_v<float> / 10.0f))));
+		m_camera.set_center({world.x * (0.5f + 0.2f * std::sin(t * 0.3f)), world.y * (0.5f + 0.2f * std::cos(t * 0.2f))});
+		m_renderer.update(m_map);
+		m_lod.update(m_map, m_camera);
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		target.setView(m_camera.view());
+		m_lod.draw(target);
+		target.setView(target.getDefaultView());
+	}
+
+  private:
+	tile_map m_map;
+	tile_map_renderer m_renderer;
+	lod_map_renderer m_lod;
+	camera m_camera;
+};
+
+///
+/// \brief 1,000 monster sprites wandering randomly over a map.
+///
+/// Drawn one sf::Sprite at a time, or as depth-sorted quads through a render_queue ("monsters_queued").
+///
+class monsters : public scene {
+  public:
+	static constexpr std::size_t count_v{1000};
+
+	enum class mode : std::uint8_t { sprites, queued };
+
+	monsters(context const& ctx, mode const m) : m_map(make_map({96, 64}, ctx.atlas, 2)), m_renderer(ctx.atlas), m_mode(m) {
+		auto random = rng{3};
+		auto const tile = ctx.atlas.tile_size();
+		auto const bounds = sf::Vector2f{static_cast<float>(ctx.size.x), static_cast<float>(ctx.size.y)};
+		m_monsters.reserve(count_v);
+		for (std::size_t i = 0; i < count_v; ++i) {
+			auto const id = static_cast<tile_id>(random.range(0, static_cast<int>(ctx.atlas.tile_count()) - 1));
+			auto const uv = ctx.atlas.uv(id);
+			auto& sprite = m_monsters.emplace_back(
+				*ctx.atlas.texture(),
+				sf::IntRect{{static_cast<int>(uv.x), static_cast<int>(uv.y)}, {static_cast<int>(tile.x), static_cast<int>(tile.y)}});
+			sprite.setPosition({random.range(0.0f, bounds.x), random.range(0.0f, bounds.y)});
+			m_uvs.push_back(uv);
+			m_velocities.push_back({random.range(-60.0f, 60.0f), random.range(-60.0f, 60.0f)});
+		}
+		m_bounds = bounds;
+	}
+
+	auto name() const -> std::string_view override { return m_mode == mode::queued ? "monsters_queued" : "monsters"; }
+
+	void tick(std::size_t const frame) override {
+		m_renderer.update(m_map);
+		auto random = rng{frame};
+		for (std::size_t i = 0; i < m_monsters.size(); ++i) {
+			auto& velocity = m_velocities[i];
+			if (random.chance(0.02f)) { velocity = {random.range(-60.0f, 60.0f), random.range(-60.0f, 60.0f)}; }
+			auto pos = m_monsters[i].getPosition() + velocity * dt_v;
+			if (pos.x < 0.0f || pos.x > m_bounds.x) { velocity.x = -velocity.x; }
+			if (pos.y < 0.0f || pos.y > m_bounds.y) { velocity.y = -velocity.y; }
+			m_monsters[i].setPosition(pos);
+		}
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		m_renderer.draw(target, tile_layer::floor);
+		if (m_mode == mode::sprites) {
+			for (auto const& sprite : m_monsters) { target.draw(sprite); }
+			return;
+		}
+		auto const tile = m_renderer.atlas().tile_size();
+		for (std::size_t i = 0; i < m_monsters.size(); ++i) {
+			auto const pos = m_monsters[i].getPosition();
+			auto const key = draw_key{.layer = 1, .depth = static_cast<std::uint32_t>(std::max(pos.y, 0.0f)), .texture = m_renderer.atlas().texture()};
+			m_queue.submit_quad(key, pos, tile, sf::Color::White, m_uvs[i], tile);
+		}
+		m_queue.flush(target);
+	}
+
+  private:
+	tile_map m_map;
+	tile_map_renderer m_renderer;
+	mode m_mode;
+	render_queue m_queue{};
+	std::vector<sf::Sprite> m_monsters{};
+	std::vector<sf::Vector2f> m_uvs{};
+	std::vector<sf::Vector2f> m_velocities{};
+	sf::Vector2f m_bounds{};
+};
+
+///
+/// \brief 5,000 animated sprites in one vertex array over a map whose floor is mostly animated water.
+///
+/// Sprite frames advance in one animation_system pass that patches texture coordinates in place; water
+/// tiles follow a looping clip evaluated from the scene clock.
+///
+class animated_sprites : public scene {
+  public:
+	static constexpr std::size_t count_v{5000};
+	static constexpr std::size_t clips_v{8};
+	static constexpr std::size_t frames_v{4};
+
+	explicit animated_sprites(context const& ctx)
+		: m_map(make_map({96, 64}, ctx.atlas, 9)), m_renderer(ctx.atlas), m_animator(m_library), m_atlas(ctx.atlas),
+		  m_bounds(static_cast<float>(ctx.size.x), static_cast<float>(ctx.size.y)) {
+		auto frames = std::array<tile_id, frames_v>{};
+		for (std::size_t c = 0; c < clips_v; ++c) {
+			for (std::size_t f = 0; f < frames_v; ++f) { frames[f] = static_cast<tile_id>((c * frames_v + f) % ctx.atlas.tile_count()); }
+			m_clips.push_back(m_library.add_clip(frames, 6.0f + static_cast<float>(c)));
+		}
+		// every floor tile in the lower half of the atlas is "water"
+		for (tile_id id = 0; id < ctx.atlas.tile_count() / 2; ++id) { m_library.set_tile_animation(id, m_clips[id % clips_v]); }
+		m_renderer.set_animations(&m_library);
+
+		auto random = rng{10};
+		auto const tile = ctx.atlas.tile_size();
+		for (std::size_t i = 0; i < count_v; ++i) {
+			append_quad(m_vertices, {random.range(0.0f, m_bounds.x), random.range(0.0f, m_bounds.y)}, tile, sf::Color::White, {}, tile);
+			auto const clip = m_clips[static_cast<std::size_t>(random.range(0, static_cast<int>(clips_v) - 1))];
+			[[maybe_unused]] auto const id = m_animator.play(clip, static_cast<std::uint32_t>(i), random.range(0.5f, 2.0f), random.range(0.0f, 1.0f));
+		}
+	}
+
+	auto name() const -> std::string_view override { return "animated_sprites"; }
+
+	void tick(std::size_t const frame) override {
+		m_renderer.update(m_map);
+		m_renderer.animate(static_cast<float>(frame) * dt_v);
+		m_animator.update(dt_v);
+		m_animator.write_uvs(m_vertices, m_atlas);
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		m_renderer.draw(target, tile_layer::floor);
+		m_renderer.draw(target, tile_layer::walls);
+		target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, sf::RenderStates{m_atlas.texture()});
+	}
+
+  private:
+	tile_map m_map;
+	tile_map_renderer m_renderer;
+	animation_library m_library{};
+	animation_system m_animator;
+	tile_atlas const& m_atlas;
+	sf::Vector2f m_bounds;
+	std::vector<clip_id> m_clips{};
+	std::vector<sf::Vertex> m_vertices{};
+};
+
+///
+/// \brief A screen of lava, water and glowing runes whose colours cycle continuously.
+///
+/// The baseline rewrites a coloured quad per visible tile every frame; "lava_field_palette" draws an indexed
+/// atlas through palette_shader, so after the first frame the CPU only sets a time uniform.
+///
+class lava_field : public scene {
+  public:
+	enum class mode : std::uint8_t { vertex_colours, palette };
+	static constexpr unsigned int tile_px_v{16};
+
+	lava_field(context const& ctx, mode const m)
+		: m_map({static_cast<int>(ctx.size.x / tile_px_v) + 1, static_cast<int>(ctx.size.y / tile_px_v) + 1}), m_renderer(m_atlas), m_mode(m) {
+		for (int y = 0; y < m_map.size().y; ++y) {
+			for (int x = 0; x < m_map.size().x; ++x) {
+				auto const field = std::sin(static_cast<float>(x) * 0.11f) + std::cos(static_cast<float>(y) * 0.13f);
+				auto const id = field > 0.6f ? lava_v : field < -0.6f ? water_v : m_random.chance(0.05f) ? rune_v : rock_v;
+				m_map.set_floor({x, y}, id);
+			}
+		}
+		if (m_mode == mode::vertex_colours) { return; }
+
+		m_palette.set_colour(1, sf::Color{70, 64, 60});
+		m_palette.set_colour(2, sf::Color{90, 84, 78});
+		for (std::uint8_t i = 0; i < 16; ++i) {
+			// triangle ramps, so the cycle wraps without a seam
+			auto const ramp = static_cast<float>(i < 8 ? i : 16 - i) / 8.0f;
+			m_palette.set_colour(static_cast<std::uint8_t>(16 + i), sf::Color{static_cast<std::uint8_t>(160 + 95 * ramp), static_cast<std::uint8_t>(40 + 180 * ramp), 0});
+			m_palette.set_colour(static_cast<std::uint8_t>(32 + i), sf::Color{0, static_cast<std::uint8_t>(60 + 80 * ramp), static_cast<std::uint8_t>(140 + 100 * ramp)});
+		}
+		for (std::uint8_t i = 0; i < 8; ++i) {
+			auto const ramp = static_cast<float>(i < 4 ? i : 8 - i) / 4.0f;
+			m_palette.set_colour(static_cast<std::uint8_t>(48 + i), sf::Color{static_cast<std::uint8_t>(90 + 150 * ramp), static_cast<std::uint8_t>(40 + 80 * ramp), 255});
+		}
+		m_palette.add_cycle({.first = 16, .count = 16, .steps_per_second = 12.0f});
+		m_palette.add_cycle({.first = 32, .count = 16, .steps_per_second = -8.0f});
+		m_palette.add_cycle({.first = 48, .count = 8, .steps_per_second = 6.0f});
+
+		auto image = sf::Image{};
+		image.create({tile_px_v * 4, tile_px_v}, sf::Color::Transparent);
+		for (auto y = 0u; y < tile_px_v; ++y) {
+			for (auto x = 0u; x < tile_px_v; ++x) {
+				auto const index = [&](tile_id const id) -> unsigned int {
+					switch (id) {
+					case lava_v: return 16 + (x + y * 2) % 16;
+					case water_v: return 32 + (x * 3 + y) % 16;
+					case rune_v: return x == y || x + y == tile_px_v - 1 ? 48 + (x % 8) : 1;
+					default: return 1 + (x * 7 + y * 3) % 2;
+					}
+				};
+				for (tile_id id = 0; id < 4; ++id) { image.setPixel({id * tile_px_v + x, y}, sf::Color{static_cast<std::uint8_t>(index(id)), 0, 0}); }
+			}
+		}
+		if (!m_texture.loadFromImage(image) || !m_palette.update() || !m_shader.create()) { throw std::runtime_error{"palette shader unavailable"}; }
+		m_atlas = tile_atlas{m_texture, {tile_px_v, tile_px_v}};
+		m_renderer.update(m_map);
+	}
+
+	auto name() const -> std::string_view override { return m_mode == mode::palette ? "lava_field_palette" : "lava_field"; }
+
+	void tick(std::size_t const frame) override {
+		auto const t = static_cast<float>(frame) * dt_v;
+		if (m_mode == mode::palette) {
+			m_shader.apply(m_palette, t);
+			return;
+		}
+		m_vertices.clear();
+		for (int y = 0; y < m_map.size().y; ++y) {
+			for (int x = 0; x < m_map.size().x; ++x) {
+				auto const phase = t * 4.0f + static_cast<float>(x + y * 2) * 0.4f;
+				auto const ramp = 0.5f + 0.5f * std::sin(phase);
+				auto colour = sf::Color{80, 74, 68};
+				switch (m_map.floor({x, y})) {
+				case lava_v: colour = sf::Color{static_cast<std::uint8_t>(160 + 95 * ramp), static_cast<std::uint8_t>(40 + 180 * ramp), 0}; break;
+				case water_v: colour = sf::Color{0, static_cast<std::uint8_t>(60 + 80 * ramp), static_cast<std::uint8_t>(140 + 100 * ramp)}; break;
+				case rune_v: colour = sf::Color{static_cast<std::uint8_t>(90 + 150 * ramp), static_cast<std::uint8_t>(40 + 80 * ramp), 255}; break;
+				default: break;
+				}
+				append_quad(m_vertices, {static_cast<float>(x * static_cast<int>(tile_px_v)), static_cast<float>(y * static_cast<int>(tile_px_v))},
+							{static_cast<float>(tile_px_v), static_cast<float>(tile_px_v)}, colour);
+			}
+		}
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		if (m_mode == mode::vertex_colours) {
+			target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles);
+			return;
+		}
+		auto states = sf::RenderStates{};
+		states.shader = &m_shader.shader();
+		m_renderer.draw(target, tile_layer::floor, states);
+	}
+
+  private:
+	static constexpr tile_id rock_v{0};
+	static constexpr tile_id lava_v{1};
+	static constexpr tile_id water_v{2};
+	static constexpr tile_id rune_v{3};
+
+	tile_map m_map;
+	sf::Texture m_texture{};
+	tile_atlas m_atlas{};
+	tile_map_renderer m_renderer;
+	palette m_palette{};
+	palette_shader m_shader{};
+	mode m_mode;
+	rng m_random{17};
+	std::vector<sf::Vertex> m_vertices{};
+};
+
+///
+/// \brief 500 actors whose turns resolve in bursts far faster than they can be shown.
+///
+/// Every half second the simulation resolves twelve turns at once (moves, attacks, arrows); the action_queue
+/// plays them back, skipping the oldest when it falls behind and everything when simulated input arrives.
+///
+class turn_burst : public scene {
+  public:
+	static constexpr std::size_t count_v{500};
+
+	explicit turn_burst(context const& ctx) : m_map(make_map({96, 64}, ctx.atlas, 11)), m_renderer(ctx.atlas), m_atlas(ctx.atlas) {
+		auto random = rng{12};
+		auto const tile = ctx.atlas.tile_size();
+		auto const cells = sf::Vector2i{static_cast<int>(static_cast<float>(ctx.size.x) / tile.x), static_cast<int>(static_cast<float>(ctx.size.y) / tile.y)};
+		m_cells = cells;
+		for (std::size_t i = 0; i < count_v; ++i) {
+			m_actors.push_back({random.range(0, cells.x - 1), random.range(0, cells.y - 1)});
+			m_sprites.push_back(static_cast<tile_id>(random.range(0, static_cast<int>(ctx.atlas.tile_count()) - 1)));
+		}
+	}
+
+	auto name() const -> std::string_view override { return "turn_burst"; }
+
+	void tick(std::size_t const frame) override {
+		m_renderer.update(m_map);
+		if (frame % 30 == 0) {
+			for (int i = 0; i < 12; ++i) { resolve_turn(); }
+		}
+		m_playback.update(dt_v, frame % 180 == 179);
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		m_renderer.draw(target, tile_layer::floor);
+		m_vertices.clear();
+		auto const tile = m_atlas.tile_size();
+		for (std::size_t i = 0; i < m_actors.size(); ++i) {
+			auto const pos = m_playback.position(static_cast<actor_id>(i), to_world(m_actors[i]));
+			append_quad(m_vertices, pos, tile, sf::Color::White, m_atlas.uv(m_sprites[i]), tile);
+		}
+		for (auto const& arrow : m_playback.projectiles()) { append_quad(m_vertices, arrow.position, tile * 0.25f, sf::Color::Yellow); }
+		target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, sf::RenderStates{m_atlas.texture()});
+	}
+
+  private:
+	auto to_world(sf::Vector2i const cell) const -> sf::Vector2f {
+		return {static_cast<float>(cell.x) * m_atlas.tile_size().x, static_cast<float>(cell.y) * m_atlas.tile_size().y};
+	}
+
+	void resolve_turn() {
+		auto random = rng{m_turn};
+		for (std::size_t i = 0; i < m_actors.size(); ++i) {
+			auto& cell = m_actors[i];
+			auto const from = to_world(cell);
+			auto const target = to_world(m_actors[static_cast<std::size_t>(random.range(0, static_cast<int>(m_actors.size()) - 1))]);
+			auto const actor = static_cast<actor_id>(i);
+			if (random.chance(0.1f)) {
+				m_playback.push({.kind = action_kind::attack, .actor = actor, .from = from, .to = target, .turn = m_turn});
+			} else if (random.chance(0.05f)) {
+				m_playback.push({.kind = action_kind::projectile, .actor = actor, .from = from, .to = target, .turn = m_turn});
+			} else {
+				cell.x = std::clamp(cell.x + random.range(-1, 1), 0, m_cells.x - 1);
+				cell.y = std::clamp(cell.y + random.range(-1, 1), 0, m_cells.y - 1);
+				m_playback.push({.kind = action_kind::move, .actor = actor, .from = from, .to = to_world(cell), .turn = m_turn});
+			}
+		}
+		++m_turn;
+	}
+
+	tile_map m_map;
+	tile_map_renderer m_renderer;
+	tile_atlas const& m_atlas;
+	action_queue m_playback{};
+	std::vector<sf::Vector2i> m_actors{};
+	std::vector<tile_id> m_sprites{};
+	std::vector<sf::Vertex> m_vertices{};
+	sf::Vector2i m_cells{};
+	std::uint32_t m_turn{};
+};
+
+///
+/// \brief 10,000 bouncing circles of random size and colour.
+///
+/// Drawn as one sf::CircleShape each ("circles"), or through one shape_batcher flush ("circles_batched").
+///
+class circles : public scene {
+  public:
+	static constexpr std::size_t count_v{10'000};
+	static constexpr std::size_t points_v{24};
+
+	enum class mode : std::uint8_t { shapes, batched };
+
+	circles(context const& ctx, mode const m) : m_mode(m), m_bounds(static_cast<float>(ctx.size.x), static_cast<float>(ctx.size.y)) {
+		auto random = rng{8};
+		for (std::size_t i = 0; i < count_v; ++i) {
+			m_circles.push_back(circle{
+				.position = {random.range(0.0f, m_bounds.x), random.range(0.0f, m_bounds.y)},
+				.velocity = {random.range(-80.0f, 80.0f), random.range(-80.0f, 80.0f)},
+				.radius = random.range(2.0f, 12.0f),
+				.colour = sf::Color{static_cast<std::uint8_t>(random.range(32, 255)), static_cast<std::uint8_t>(random.range(32, 255)),
+									static_cast<std::uint8_t>(random.range(32, 255)), 192},
+			});
+			if (m_mode == mode::shapes) {
+				auto& shape = m_shapes.emplace_back(m_circles.back().radius, points_v);
+				shape.setFillColor(m_circles.back().colour);
+				shape.setOrigin({m_circles.back().radius, m_circles.back().radius});
+			}
+		}
+	}
+
+	auto name() const -> std::string_view override { return m_mode == mode::batched ? "circles_batched" : "circles"; }
+
+	void tick(std::size_t) override {
+		for (auto& c : m_circles) {
+			c.position += c.velocity * dt_v;
+			if (c.position.x < 0.0f || c.position.x > m_bounds.x) { c.velocity.x = -c.velocity.x; }
+			if (c.position.y < 0.0f || c.position.y > m_bounds.y) { c.velocity.y = -c.velocity.y; }
+		}
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		if (m_mode == mode::batched) {
+			for (auto const& c : m_circles) { m_batcher.circle(c.position, c.radius, c.colour, points_v); }
+			m_batcher.flush(target);
+			return;
+		}
+		for (std::size_t i = 0; i < m_circles.size(); ++i) {
+			m_shapes[i].setPosition(m_circles[i].position);
+			target.draw(m_shapes[i]);
+		}
+	}
+
+  private:
+	struct circle {
+		sf::Vector2f position{};
+		sf::Vector2f velocity{};
+		float radius{};
+		sf::Color colour{};
+	};
+
+	mode m_mode;
+	sf::Vector2f m_bounds;
+	std::vector<circle> m_circles{};
+	std::vector<sf::CircleShape> m_shapes{};
+	shape_batcher m_batcher{};
+};
+
+///
+/// \brief 192x128 cached map lit on the CPU by 48 flickering torches and 4 wandering lights, panned slowly.
+///
+/// Only the tiles around lights that changed are relit; the overlay re-uploads the chunks that moved and
+/// multiplies them over static_layer_cache, which never rebuilds.
+///
+class torchlit : public scene {
+  public:
+	static constexpr std::size_t torches_v{48};
+	static constexpr std::size_t wanderers_v{4};
+	static constexpr std::size_t flickers_v{6};
+	static constexpr float radius_v{7.0f};
+	static constexpr sf::Color ambient_v{40, 40, 64};
+
+	explicit torchlit(context const& ctx)
+		: m_map(make_map({192, 128}, ctx.atlas, 15)), m_renderer(ctx.atlas), m_cache(m_renderer), m_grid(m_map.size(), ambient_v),
+		  m_overlay(ctx.atlas.tile_size()), m_size(ctx.size) {
+		auto const extent = sf::Vector2f{static_cast<float>(m_map.size().x), static_cast<float>(m_map.size().y)};
+		for (std::size_t i = 0; i < torches_v + wanderers_v; ++i) {
+			auto const wanders = i >= torches_v;
+			m_lights.push_back(light{
+				.position = {m_random.range(0.0f, extent.x), m_random.range(0.0f, extent.y)},
+				.velocity = wanders ? sf::Vector2f{m_random.range(-0.2f, 0.2f), m_random.range(-0.2f, 0.2f)} : sf::Vector2f{},
+				.colour = wanders ? sf::Color{140, 180, 255} : sf::Color{255, 170, 90},
+				.intensity = 1.0f,
+			});
+		}
+		relight({0, 0}, m_map.size());
+	}
+
+	auto name() const -> std::string_view override { return "torchlit"; }
+
+	void tick(std::size_t const frame) override {
+		auto const t = static_cast<float>(frame) * dt_v;
+		auto const tile = m_renderer.atlas().tile_size();
+		auto const world = sf::Vector2f{static_cast<float>(m_map.size().x) * tile.x, static_cast<float>(m_map.size().y) * tile.y};
+		m_view = sf::View{{world.x * (0.5f + 0.2f * std::sin(t * 0.2f)), world.y * (0.5f + 0.2f * std::cos(t * 0.15f))},
+						  sf::Vector2f{static_cast<float>(m_size.x), static_cast<float>(m_size.y)}};
+
+		for (std::size_t i = 0; i < flickers_v; ++i) {
+			auto& l = m_lights[static_cast<std::size_t>(m_random.range(0, static_cast<int>(torches_v) - 1))];
+			l.intensity = m_random.range(0.7f, 1.0f);
+			relight_around(l.position);
+		}
+		auto const extent = sf::Vector2f{static_cast<float>(m_map.size().x), static_cast<float>(m_map.size().y)};
+		for (auto i = torches_v; i < m_lights.size(); ++i) {
+			auto& l = m_lights[i];
+			auto const before = l.position;
+			l.position += l.velocity;
+			if (l.position.x < 0.0f || l.position.x > extent.x) { l.velocity.x = -l.velocity.x; }
+			if (l.position.y < 0.0f || l.position.y > extent.y) { l.velocity.y = -l.velocity.y; }
+			relight_around(before);
+			relight_around(l.position);
+		}
+
+		m_renderer.update(m_map);
+		m_cache.update(m_map, m_view);
+		m_overlay.update(m_grid, m_view);
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		target.setView(m_view);
+		m_cache.draw(target);
+		m_overlay.draw(target);
+		target.setView(target.getDefaultView());
+	}
+
+  private:
+	struct light {
+		sf::Vector2f position{};
+		sf::Vector2f velocity{};
+		sf::Color colour{};
+		float intensity{};
+	};
+
+	void relight_around(sf::Vector2f const position) {
+		auto const reach = static_cast<int>(radius_v) + 1;
+		auto const centre = sf::Vector2i{static_cast<int>(position.x), static_cast<int>(position.y)};
+		relight(centre - sf::Vector2i{reach, reach}, centre + sf::Vector2i{reach + 1, reach + 1});
+	}
+
+	/// \brief Ambient plus linear falloff from every light in range, for tiles [lo, hi).
+	void relight(sf::Vector2i lo, sf::Vector2i hi) {
+		lo = {std::max(lo.x, 0), std::max(lo.y, 0)};
+		hi = {std::min(hi.x, m_map.size().x), std::min(hi.y, m_map.size().y)};
+		for (int y = lo.y; y < hi.y; ++y) {
+			for (int x = lo.x; x < hi.x; ++x) {
+				auto const centre = sf::Vector2f{static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f};
+				auto r = static_cast<float>(ambient_v.r);
+				auto g = static_cast<float>(ambient_v.g);
+				auto b = static_cast<float>(ambient_v.b);
+				for (auto const& l : m_lights) {
+					auto const d = centre - l.position;
+					auto const distance = std::sqrt(d.x * d.x + d.y * d.y);
+					if (distance >= radius_v) { continue; }
+					auto const f = (1.0f - distance / radius_v) * l.intensity;
+					r += static_cast<float>(l.colour.r) * f;
+					g += static_cast<float>(l.colour.g) * f;
+					b += static_cast<float>(l.colour.b) * f;
+				}
+				auto const channel = [](float const v) { return static_cast<std::uint8_t>(std::min(v, 255.0f)); };
+				m_grid.set_light({x, y}, sf::Color{channel(r), channel(g), channel(b)});
+			}
+		}
+	}
+
+	tile_map m_map;
+	tile_map_renderer m_renderer;
+	static_layer_cache m_cache;
+	light_grid m_grid;
+	light_overlay m_overlay;
+	sf::Vector2u m_size;
+	sf::View m_view{};
+	rng m_random{16};
+	std::vector<light> m_lights{};
+};
+
+///
+/// \brief 512x512 level explored by 32 wanderers revealing 11x11 tiles each, with a few wall edits a frame.
+///
+/// The minimap variant patches a texture with the tiles that changed; the baseline rebuilds a quad per
+/// revealed tile every frame. Both draw the wanderers as markers.
+///
+class explored_minimap : public scene {
+  public:
+	enum class mode : std::uint8_t { tiles, texture };
+	static constexpr std::size_t explorers_v{32};
+	static constexpr int sight_v{5};
+	static constexpr std::size_t edits_v{4};
+
+	explored_minimap(context const& ctx, mode const m) : m_map(make_map({512, 512}, ctx.atlas, 13)), m_minimap(ctx.atlas), m_mode(m) {
+		if (m_mode == mode::texture && !m_minimap.create(m_map)) { throw std::runtime_error{"failed to create minimap"}; }
+		m_revealed.assign(static_cast<std::size_t>(m_map.size().x * m_map.size().y), 0);
+		for (std::size_t i = 0; i < explorers_v; ++i) { m_explorers.push_back({m_random.range(0, m_map.size().x - 1), m_random.range(0, m_map.size().y - 1)}); }
+		m_last_tile = static_cast<tile_id>(ctx.atlas.tile_count() - 1);
+	}
+
+	auto name() const -> std::string_view override { return m_mode == mode::texture ? "minimap_texture" : "minimap"; }
+
+	void tick(std::size_t) override {
+		for (auto& e : m_explorers) {
+			e.x = std::clamp(e.x + m_random.range(-1, 1), 0, m_map.size().x - 1);
+			e.y = std::clamp(e.y + m_random.range(-1, 1), 0, m_map.size().y - 1);
+			auto const area = sf::IntRect{{e.x - sight_v, e.y - sight_v}, {sight_v * 2 + 1, sight_v * 2 + 1}};
+			if (m_mode == mode::texture) {
+				m_minimap.reveal(area);
+				continue;
+			}
+			for (int y = std::max(area.top, 0); y < std::min(area.top + area.height, m_map.size().y); ++y) {
+				for (int x = std::max(area.left, 0); x < std::min(area.left + area.width, m_map.size().x); ++x) {
+					m_revealed[static_cast<std::size_t>(y * m_map.size().x + x)] = 1;
+				}
+			}
+		}
+		for (std::size_t i = 0; i < edits_v; ++i) {
+			auto const pos = sf::Vector2i{m_random.range(0, m_map.size().x - 1), m_random.range(0, m_map.size().y - 1)};
+			m_map.set_wall(pos, m_map.wall(pos) == no_tile_v ? m_last_tile : no_tile_v);
+		}
+		if (m_mode == mode::texture) {
+			m_minimap.update(m_map);
+			m_minimap.clear_markers();
+			for (auto const& e : m_explorers) { m_minimap.add_marker({static_cast<float>(e.x), static_cast<float>(e.y)}, sf::Color::Red); }
+			return;
+		}
+		auto const scale = sf::Vector2f{m_bounds.width / static_cast<float>(m_map.size().x), m_bounds.height / static_cast<float>(m_map.size().y)};
+		m_vertices.clear();
+		for (int y = 0; y < m_map.size().y; ++y) {
+			for (int x = 0; x < m_map.size().x; ++x) {
+				if (!m_revealed[static_cast<std::size_t>(y * m_map.size().x + x)]) { continue; }
+				auto const colour = m_map.is_wall({x, y}) ? sf::Color{96, 96, 96} : sf::Color{160, 140, 110};
+				append_quad(m_vertices, {m_bounds.left + static_cast<float>(x) * scale.x, m_bounds.top + static_cast<float>(y) * scale.y}, scale, colour);
+			}
+		}
+		for (auto const& e : m_explorers) {
+			auto const centre = sf::Vector2f{m_bounds.left + (static_cast<float>(e.x) + 0.5f) * scale.x, m_bounds.top + (static_cast<float>(e.y) + 0.5f) * scale.y};
+			append_quad(m_vertices, centre - sf::Vector2f{1.5f, 1.5f}, {3.0f, 3.0f}, sf::Color::Red);
+		}
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		if (m_mode == mode::texture) {
+			m_minimap.draw(target, m_bounds);
+			return;
+		}
+		target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles);
+	}
+
+  private:
+	tile_map m_map;
+	sf::FloatRect m_bounds{{8.0f, 8.0f}, {384.0f, 384.0f}};
+	minimap m_minimap;
+	mode m_mode;
+	rng m_random{14};
+	std::vector<sf::Vector2i> m_explorers{};
+	std::vector<std::uint8_t> m_revealed{};
+	std::vector<sf::Vertex> m_vertices{};
+	tile_id m_last_tile{};
+};
+
+/// \brief 96 moving radial lights accumulated additively into a light map, multiplied over the scene.
+class heavy_lighting : public scene {
+  public:
+	static constexpr std::size_t count_v{96};
+	static constexpr std::size_t segments_v{32};
+
+	explicit heavy_lighting(context const& ctx) : m_map(make_map({96, 64}, ctx.atlas, 4)), m_renderer(ctx.atlas), m_size(ctx.size) {
+		if (!m_light_map.create(ctx.size)) { throw std::runtime_error{"failed to create light map"}; }
+		auto random = rng{5};
+		for (std::size_t i = 0; i < count_v; ++i) {
+			m_lights.push_back(light{
+				.orbit_center = {random.range(0.0f, static_cast<float>(ctx.size.x)), random.range(0.0f, static_cast<float>(ctx.size.y))},
+				.orbit_radius = random.range(20.0f, 200.0f),
+				.speed = random.range(-2.0f, 2.0f),
+				.radius = random.range(60.0f, 220.0f),
+				.colour = sf::Color{static_cast<std::uint8_t>(random.range(80, 255)), static_cast<std::uint8_t>(random.range(80, 255)),
+									static_cast<std::uint8_t>(random.range(80, 255))},
+			});
+		}
+	}
+
+	auto name() const -> std::string_view override { return "heavy_lighting"; }
+
+	void tick(std::size_t const frame) override {
+		m_renderer.update(m_map);
+		auto const t = static_cast<float>(frame) * dt_v;
+		m_vertices.clear();
+		for (auto const& l : m_lights) {
+			auto const angle = t * l.speed;
+			auto const centre = l.orbit_center + sf::Vector2f{std::cos(angle), std::sin(angle)} * l.orbit_radius;
+			auto const edge = sf::Color{l.colour.r, l.colour.g, l.colour.b, 0};
+			// triangle list fan: bright centre falling off to black at the rim
+			for (std::size_t s = 0; s < segments_v; ++s) {
+				auto const a0 = static_cast<float>(s) / segments_v * 2.0f * std::numbers::pi_v<float>;
+				auto const a1 = static_cast<float>(s + 1) / segments_v * 2.0f * std::numbers::pi_v<float>;
+				m_vertices.push_back(sf::Vertex{centre, l.colour});
+				m_vertices.push_back(sf::Vertex{centre + sf::Vector2f{std::cos(a0), std::sin(a0)} * l.radius, edge});
+				m_vertices.push_back(sf::Vertex{centre + sf::Vector2f{std::cos(a1), std::sin(a1)} * l.radius, edge});
+			}
+		}
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		m_renderer.draw(target, tile_layer::floor);
+		m_renderer.draw(target, tile_layer::walls);
+		m_light_map.clear(sf::Color{24, 24, 40});
+		m_light_map.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, sf::RenderStates{sf::BlendAdd});
+		m_light_map.display();
+		auto quad = std::vector<sf::Vertex>{};
+		append_quad(quad, {}, {static_cast<float>(m_size.x), static_cast<float>(m_size.y)}, sf::Color::White, {},
+					{static_cast<float>(m_size.x), static_cast<float>(m_size.y)});
+		auto states = sf::RenderStates{sf::BlendMultiply};
+		states.texture = &m_light_map.getTexture();
+		target.draw(quad.data(), quad.size(), sf::PrimitiveType::Triangles, states);
+	}
+
+  private:
+	struct light {
+		sf::Vector2f orbit_center{};
+		float orbit_radius{};
+		float speed{};
+		float radius{};
+		sf::Color colour{};
+	};
+
+	tile_map m_map;
+	tile_map_renderer m_renderer;
+	sf::Vector2u m_size;
+	sf::RenderTexture m_light_map{};
+	std::vector<light> m_lights{};
+	std::vector<sf::Vertex> m_vertices{};
+};
+
+///
+/// \brief 20,000 short lived particles from a handful of emitters, rebuilt into one vertex array per frame.
+///
+/// "particle_storm" keeps an array of particle structs; "particle_storm_soa" runs the same emission through
+/// particle_system on a job_pool.
+///
+class particle_storm : public scene {
+  public:
+	static constexpr std::size_t capacity_v{20'000};
+	static constexpr std::size_t emitters_v{8};
+
+	enum class mode : std::uint8_t { structs, soa };
+
+	particle_storm(context const& ctx, mode const m) : m_size(ctx.size), m_mode(m) {
+		if (m_mode == mode::structs) {
+			m_particles.reserve(capacity_v);
+			return;
+		}
+		m_system.emplace(&m_jobs);
+		m_type = m_system->add_type(particle_type{.size = {3.0f, 3.0f}, .gravity = {0.0f, 120.0f}, .fade = false, .capacity = capacity_v});
+	}
+
+	auto name() const -> std::string_view override { return m_mode == mode::soa ? "particle_storm_soa" : "particle_storm"; }
+
+	void tick(std::size_t const frame) override {
+		auto random = rng{frame, 7};
+		if (m_system) {
+			m_system->update(dt_v);
+		} else {
+			for (auto& p : m_particles) {
+				p.velocity.y += 120.0f * dt_v;
+				p.position += p.velocity * dt_v;
+				p.life -= dt_v;
+			}
+			std::erase_if(m_particles, [](particle const& p) { return p.life <= 0.0f; });
+		}
+		auto const t = static_cast<float>(frame) * dt_v;
+		for (auto count = alive(); count < capacity_v; ++count) {
+			auto const emitter = static_cast<float>(count % emitters_v);
+			auto const origin = sf::Vector2f{static_cast<float>(m_size.x) * (0.1f + 0.8f * emitter / emitters_v),
+											 static_cast<float>(m_size.y) * (0.5f + 0.3f * std::sin(t + emitter))};
+			auto const angle = random.range(0.0f, 2.0f * std::numbers::pi_v<float>);
+			auto const speed = random.range(20.0f, 240.0f);
+			auto const spawned = particle_spawn{
+				.position = origin,
+				.velocity = {std::cos(angle) * speed, std::sin(angle) * speed},
+				.life = random.range(0.5f, 2.5f),
+				.colour = sf::Color{255, static_cast<std::uint8_t>(random.range(64, 224)), 32, 200},
+			};
+			if (m_system) {
+				m_system->spawn(m_type, spawned);
+			} else {
+				m_particles.push_back(particle{.position = spawned.position, .velocity = spawned.velocity, .life = spawned.life, .colour = spawned.colour});
+			}
+		}
+		if (m_system) { return; }
+		m_vertices.clear();
+		for (auto const& p : m_particles) { append_quad(m_vertices, p.position, {3.0f, 3.0f}, p.colour); }
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		if (m_system) {
+			m_system->draw(target);
+			return;
+		}
+		target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, sf::RenderStates{sf::BlendAdd});
+	}
+
+  private:
+	struct particle {
+		sf::Vector2f position{};
+		sf::Vector2f velocity{};
+		float life{};
+		sf::Color colour{};
+	};
+
+	[[nodiscard]] auto alive() const -> std::size_t { return m_system ? m_system->count() : m_particles.size(); }
+
+	sf::Vector2u m_size;
+	mode m_mode;
+	std::vector<particle> m_particles{};
+	std::vector<sf::Vertex> m_vertices{};
+	job_pool m_jobs{};
+	std::optional<particle_system> m_system{};
+	particle_system::type_id m_type{};
+};
+
+///
+/// \brief 120 overlapping panels with title bars, buttons and text rows whose numbers change every frame.
+///
+/// "crowded_ui" draws each element as its own shape / text; "crowded_ui_retained" builds the same panels as
+/// ui widgets once and only re-shapes the changed rows (without a font it lays out and draws no text).
+///
+class crowded_ui : public scene {
+  public:
+	static constexpr std::size_t panels_v{120};
+	static constexpr std::size_t rows_v{8};
+
+	enum class mode : std::uint8_t { shapes, retained };
+
+	crowded_ui(context const& ctx, mode const m) : m_font(ctx.font), m_mode(m) {
+		auto random = rng{9};
+		auto const size = sf::Vector2f{static_cast<float>(ctx.size.x), static_cast<float>(ctx.size.y)};
+		for (std::size_t i = 0; i < panels_v; ++i) {
+			auto const extent = sf::Vector2f{random.range(160.0f, 320.0f), random.range(120.0f, 240.0f)};
+			m_panels.push_back(panel{.origin = {random.range(0.0f, size.x - extent.x), random.range(0.0f, size.y - extent.y)}, .size = extent});
+		}
+		if (m_mode == mode::retained) {
+			build_widgets(size);
+			return;
+		}
+		m_background.setFillColor(background_v);
+		m_background.setOutlineColor(border_v);
+		m_background.setOutlineThickness(1.0f);
+		m_title.setFillColor(title_v);
+		m_button.setFillColor(button_v);
+		m_glyph.setFillColor(sf::Color{220, 220, 220});
+	}
+
+	auto name() const -> std::string_view override { return m_mode == mode::retained ? "crowded_ui_retained" : "crowded_ui"; }
+
+	void tick(std::size_t const frame) override {
+		m_frame = frame;
+		if (!m_ui) { return; }
+		for (std::size_t i = 0; i < m_panels.size(); ++i) {
+			for (std::size_t row = 0; row < rows_v; ++row) { m_rows[i * rows_v + row]->set_text(row_text(i, row)); }
+		}
+		m_ui->update();
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		if (m_ui) {
+			m_ui->draw(target);
+			return;
+		}
+		for (std::size_t i = 0; i < m_panels.size(); ++i) {
+			auto const& p = m_panels[i];
+			m_background.setPosition(p.origin);
+			m_background.setSize(p.size);
+			target.draw(m_background);
+			m_title.setPosition(p.origin);
+			m_title.setSize({p.size.x, 18.0f});
+			target.draw(m_title);
+			for (std::size_t row = 0; row < rows_v; ++row) { draw_label(target, row_text(i, row), p.origin + row_offset(row)); }
+			m_button.setPosition(p.origin + p.size - sf::Vector2f{56.0f, 24.0f});
+			m_button.setSize({50.0f, 18.0f});
+			target.draw(m_button);
+		}
+	}
+
+  private:
+	static constexpr sf::Color background_v{30, 30, 44, 230};
+	static constexpr sf::Color border_v{200, 200, 220};
+	static constexpr sf::Color title_v{70, 70, 140};
+	static constexpr sf::Color button_v{90, 140, 90};
+
+	struct panel {
+		sf::Vector2f origin{};
+		sf::Vector2f size{};
+	};
+
+	static auto row_offset(std::size_t const row) -> sf::Vector2f { return {6.0f, 24.0f + static_cast<float>(row) * 14.0f}; }
+
+	// changing text every frame, as a stats panel or combat log would
+	auto row_text(std::size_t const panel_index, std::size_t const row) -> std::string const& {
+		m_label.assign("panel ").append(std::to_string(panel_index)).append(" row ").append(std::to_string(row)).append(": ");
+		m_label.append(std::to_string(m_frame * (row + 1)));
+		return m_label;
+	}
+
+	void build_widgets(sf::Vector2f const size) {
+		using ui::panel;
+		m_ui.emplace(size);
+		for (auto const& p : m_panels) {
+			auto& frame = m_ui->root().add<panel>(panel::layout::free, panel::style{.background = background_v, .border = border_v, .border_thickness = 1.0f});
+			frame.set_position(p.origin);
+			frame.set_min_size(p.size);
+			auto& title = frame.add<panel>(panel::layout::row, panel::style{.background = title_v});
+			title.set_min_size({p.size.x, 18.0f});
+			for (std::size_t row = 0; row < rows_v; ++row) {
+				auto& text = frame.add<ui::label>(m_font, std::string_view{}, 11);
+				text.set_position(row_offset(row));
+				m_rows.push_back(&text);
+			}
+			auto& button = frame.add<panel>(panel::layout::row, panel::style{.background = button_v});
+			button.set_position(p.size - sf::Vector2f{56.0f, 24.0f});
+			button.set_min_size({50.0f, 18.0f});
+		}
+	}
+
+	void draw_label(sf::RenderTarget& target, std::string const& str, sf::Vector2f const pos) {
+		if (m_font) {
+			auto text = sf::Text{str, *m_font, 11};
+			text.setPosition(pos);
+			target.draw(text);
+			return;
+		}
+		for (std::size_t c = 0; c < str.size(); ++c) {
+			if (str[c] == ' ') { continue; }
+			m_glyph.setPosition(pos + sf::Vector2f{static_cast<float>(c) * 6.0f, 2.0f});
+			m_glyph.setSize({5.0f, 8.0f});
+			target.draw(m_glyph);
+		}
+	}
+
+	sf::Font const* m_font;
+	mode m_mode;
+	std::vector<panel> m_panels{};
+	sf::RectangleShape m_background{};
+	sf::RectangleShape m_title{};
+	sf::RectangleShape m_button{};
+	sf::RectangleShape m_glyph{};
+	std::optional<ui::canvas> m_ui{};
+	std::vector<ui::label*> m_rows{};
+	std::string m_label{};
+	std::size_t m_frame{};
+};
+
+///
+/// \brief A 40 line message log plus a dozen tooltips, nearly all unchanged from one frame to the next.
+///
+/// A message arrives every 20 frames and scrolls the log. "message_log" draws each line as an sf::Text;
+/// "message_log_cached" draws the same lines from a text_cache through a text_batcher. Needs a font.
+///
+class message_log : public scene {
+  public:
+	static constexpr std::size_t lines_v{40};
+	static constexpr std::size_t tooltips_v{12};
+	static constexpr unsigned int character_size_v{12};
+
+	enum class mode : std::uint8_t { text, cached };
+
+	message_log(context const& ctx, mode const m) : m_font(*ctx.font), m_mode(m), m_size(ctx.size) {}
+
+	auto name() const -> std::string_view override { return m_mode == mode::cached ? "message_log_cached" : "message_log"; }
+
+	void tick(std::size_t const frame) override {
+		if (frame % 20 != 0) { return; }
+		static constexpr std::array<char const*, 4> monsters_v{"goblin", "giant rat", "cave spider", "skeleton"};
+		auto random = rng{frame, 13};
+		auto const* monster = monsters_v[static_cast<std::size_t>(random.range(0, static_cast<int>(monsters_v.size()) - 1))];
+		m_lines.push_back("turn " + std::to_string(frame / 20) + ": the " + monster + " hits you for " + std::to_string(random.range(1, 12)) + " damage");
+		if (m_lines.size() > lines_v) { m_lines.pop_front(); }
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		for (std::size_t i = 0; i < m_lines.size(); ++i) { draw_text(target, m_lines[i], {8.0f, 8.0f + static_cast<float>(i) * 14.0f}); }
+		for (std::size_t i = 0; i < tooltips_v; ++i) {
+			auto const pos = sf::Vector2f{static_cast<float>(m_size.x) * 0.5f + static_cast<float>(i % 3) * 140.0f, 40.0f + static_cast<float>(i / 3) * 70.0f};
+			draw_text(target, "Iron sword\nDamage 4-9\nWeight 3", pos);
+		}
+		if (m_mode == mode::cached) { m_batcher.flush(target); }
+	}
+
+  private:
+	void draw_text(sf::RenderTarget& target, std::string_view const str, sf::Vector2f const pos) {
+		if (m_mode == mode::cached) {
+			m_batcher.add(m_font, str, character_size_v, pos, sf::Color::White);
+			return;
+		}
+		auto text = sf::Text{std::string{str}, m_font, character_size_v};
+		text.setPosition(pos);
+		target.draw(text);
+	}
+
+	sf::Font const& m_font;
+	mode m_mode;
+	sf::Vector2u m_size;
+	std::deque<std::string> m_lines{};
+	text_cache m_cache{};
+	text_batcher m_batcher{m_cache};
+};
+
+///
+/// \brief Thirty lines of outlined, shadowed text breathing between 8 and 64 px, all from one distance field atlas.
+///
+/// Needs a font and shaders; the atlas is generated on the first run and cached under cache/.
+///
+class sdf_text : public scene {
+  public:
+	static constexpr std::size_t lines_v{30};
+
+	explicit sdf_text(context const& ctx) {
+		if (!m_font.load(*ctx.font, ctx.font->getInfo().family, "cache/framebench.sdf") || !m_shader.create()) {
+			throw std::runtime_error{"sdf text unavailable"};
+		}
+		m_shader.apply(m_font, sdf_shader::effects{
+								   .outline = sf::Color::Black,
+								   .outline_width = 1.5f,
+								   .shadow = sf::Color{0, 0, 0, 160},
+								   .shadow_offset = {2.0f, 2.0f},
+								   .shadow_softness = 1.5f,
+							   });
+	}
+
+	auto name() const -> std::string_view override { return "sdf_text"; }
+
+	void tick(std::size_t const frame) override {
+		auto const t = static_cast<float>(frame) * dt_v;
+		m_vertices.clear();
+		auto y = 8.0f;
+		for (std::size_t i = 0; i < lines_v; ++i) {
+			auto const size = 8.0f + 56.0f * (0.5f + 0.5f * std::sin(t + static_cast<float>(i) * 0.3f));
+			auto const run = m_font.shape("The quick brown fox jumps over the lazy dog", size, i % 4 == 3 ? sf::Text::Italic : sf::Text::Regular);
+			append_run(m_vertices, run, {8.0f, y}, sf::Color{255, 230, 160});
+			y += m_font.line_spacing(size) * 0.5f;
+		}
+	}
+
+	void draw(sf::RenderTarget& target) override {
+		auto states = sf::RenderStates{&m_font.texture()};
+		states.shader = &m_shader.shader();
+		target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+	}
+
+  private:
+	sdf_font m_font{};
+	sdf_shader m_shader{};
+	std::vector<sf::Vertex> m_vertices{};
+};
+} // namespace
+
+auto make_scenes(context const& ctx) -> std::vector<std::unique_ptr<scene>> {
+	auto ret = std::vector<std::unique_ptr<scene>>{};
+	ret.push_back(std::make_unique<huge_map>(ctx, huge_map::mode::vertices));
+	ret.push_back(std::make_unique<huge_map>(ctx, huge_map::mode::cached));
+	if (shader_tile_map::is_available()) { ret.push_back(std::make_unique<huge_map>(ctx, huge_map::mode::shader)); }
+	ret.push_back(std::make_unique<pixel_world>(ctx, pixel_world::mode::native));
+	ret.push_back(std::make_unique<pixel_world>(ctx, pixel_world::mode::integer));
+	ret.push_back(std::make_unique<pixel_world>(ctx, pixel_world::mode::sharp));
+	ret.push_back(std::make_unique<map_zoom>(ctx));
+	ret.push_back(std::make_unique<monsters>(ctx, monsters::mode::sprites));
+	ret.push_back(std::make_unique<monsters>(ctx, monsters::mode::queued));
+	ret.push_back(std::make_unique<animated_sprites>(ctx));
+	ret.push_back(std::make_unique<lava_field>(ctx, lava_field::mode::vertex_colours));
+	if (palette_shader::is_available()) { ret.push_back(std::make_unique<lava_field>(ctx, lava_field::mode::palette)); }
+	ret.push_back(std::make_unique<turn_burst>(ctx));
+	ret.push_back(std::make_unique<torchlit>(ctx));
+	ret.push_back(std::make_unique<explored_minimap>(ctx, explored_minimap::mode::tiles));
+	ret.push_back(std::make_unique<explored_minimap>(ctx, explored_minimap::mode::texture));
+	ret.push_back(std::make_unique<circles>(ctx, circles::mode::shapes));
+	ret.push_back(std::make_unique<circles>(ctx, circles::mode::batched));
+	ret.push_back(std::make_unique<heavy_lighting>(ctx));
+	ret.push_back(std::make_unique<particle_storm>(ctx, particle_storm::mode::structs));
+	ret.push_back(std::make_unique<particle_storm>(ctx, particle_storm::mode::soa));
+	ret.push_back(std::make_unique<crowded_ui>(ctx, crowded_ui::mode::shapes));
+	ret.push_back(std::make_unique<crowded_ui>(ctx, crowded_ui::mode::retained));
+	if (ctx.font) {
+		ret.push_back(std::make_unique<message_log>(ctx, message_log::mode::text));
+		ret.push_back(std::make_unique<message_log>(ctx, message_log::mode::cached));
+		if (sdf_shader::is_available()) { ret.push_back(std::make_unique<sdf_text>(ctx)); }
+	}
+	return ret;
+}
+} // namespace carise::framebench
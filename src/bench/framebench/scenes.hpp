@@ -0,0 +1,32 @@
+#pragma once
+#include <carise/render/tile_atlas.hpp>
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace carise::framebench {
+/// \brief Shared resources handed to every scene.
+struct context {
+	sf::Vector2u size{};
+	tile_atlas const& atlas;
+	/// \brief Null when no font was supplied; text heavy scenes fall back to glyph-sized quads.
+	sf::Font const* font{};
+};
+
+///
+/// \brief A deterministic workload: all state is derived from a fixed seed and the frame index, never wall time,
+/// so every run draws exactly the same frames.
+///
+class scene {
+  public:
+	virtual ~scene() = default;
+
+	[[nodiscard]] virtual auto name() const -> std::string_view = 0;
+	/// \brief Advance simulation to frame (fixed 1/60 s steps).
+	virtual void tick(std::size_t frame) = 0;
+	virtual void draw(sf::RenderTarget& target) = 0;
+};
+
+[[nodiscard]] auto make_scenes(context const& ctx) -> std::vector<std::unique_ptr<scene>>;
+} // namespace carise::framebench
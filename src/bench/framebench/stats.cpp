@@ -0,0 +1,124 @@
+#include "stats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+namespace carise::framebench {
+namespace {
+/// \brief Linear interpolated quantile of sorted samples.
+auto quantile(std::span<double const> sorted, double const q) -> double {
+	if (sorted.empty()) { return 0.0; }
+	auto const pos = q * static_cast<double>(sorted.size() - 1);
+	auto const lo = static_cast<std::size_t>(pos);
+	auto const hi = std::min(lo + 1, sorted.size() - 1);
+	return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - static_cast<double>(lo));
+}
+} // namespace
+
+auto summarize(std::span<double const> samples) -> summary {
+	if (samples.empty()) { return {}; }
+	auto sorted = std::vector<double>{samples.begin(), samples.end()};
+	std::sort(sorted.begin(), sorted.end());
+	auto ret = summary{};
+	auto const count = static_cast<double>(sorted.size());
+	ret.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / count;
+	ret.median = quantile(sorted, 0.5);
+	ret.p95 = quantile(sorted, 0.95);
+	ret.p99 = quantile(sorted, 0.99);
+	auto variance = 0.0;
+	for (auto const sample : sorted) { variance += (sample - ret.mean) * (sample - ret.mean); }
+	ret.stddev = sorted.size() > 1 ? std::sqrt(variance / (count - 1.0)) : 0.0;
+	for (auto& sample : sorted) { sample = std::abs(sample - ret.median); }
+	std::sort(sorted.begin(), sorted.end());
+	ret.mad = quantile(sorted, 0.5);
+	return ret;
+}
+
+auto slower_p_value(std::span<double const> baseline, std::span<double const> current) -> double {
+	if (baseline.empty() || current.empty()) { return 1.0; }
+	struct ranked {
+		double value;
+		bool is_current;
+	};
+	auto pooled = std::vector<ranked>{};
+	pooled.reserve(baseline.size() + current.size());
+	for (auto const value : baseline) { pooled.push_back({value, false}); }
+	for (auto const value : current) { pooled.push_back({value, true}); }
+	std::sort(pooled.begin(), pooled.end(), [](ranked const& a, ranked const& b) { return a.value < b.value; });
+
+	// average ranks over ties, accumulating the tie correction term sum(t^3 - t)
+	auto current_rank_sum = 0.0;
+	auto tie_term = 0.0;
+	for (std::size_t i = 0; i < pooled.size();) {
+		auto j = i;
+		while (j < pooled.size() && pooled[j].value == pooled[i].value) { ++j; }
+		auto const rank = static_cast<double>(i + j + 1) / 2.0;
+		for (auto k = i; k < j; ++k) {
+			if (pooled[k].is_current) { current_rank_sum += rank; }
+		}
+		auto const t = static_cast<double>(j - i);
+		tie_term += t * t * t - t;
+		i = j;
+	}
+
+	auto const n1 = static_cast<double>(current.size());
+	auto const n2 = static_cast<double>(baseline.size());
+	auto const n = n1 + n2;
+	auto const u = current_rank_sum - n1 * (n1 + 1.0) / 2.0;
+	auto const mean = n1 * n2 / 2.0;
+	auto const variance = n1 * n2 / 12.0 * ((n + 1.0) - tie_term / (n * (n - 1.0)));
+	if (variance <= 0.0) { return 1.0; }
+	// continuity correction, then upper tail of the standard normal
+	auto const z = (u - mean - 0.5) / std::sqrt(variance);
+	return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+auto compare(std::span<double const> baseline, std::span<double const> current, double const threshold, double const alpha) -> comparison {
+	auto ret = comparison{};
+	auto const base = summarize(baseline).median;
+	ret.ratio = base > 0.0 ? summarize(current).median / base : 1.0;
+	auto const slower = slower_p_value(baseline, current);
+	auto const faster = slower_p_value(current, baseline);
+	if (slower < alpha && ret.ratio > 1.0 + threshold) {
+		ret.result = verdict::slower;
+		ret.p_value = slower;
+	} else if (faster < alpha && ret.ratio < 1.0 - threshold) {
+		ret.result = verdict::faster;
+		ret.p_value = faster;
+	} else {
+		ret.p_value = std::min(slower, faster);
+	}
+	return ret;
+}
+
+auto load_baseline(std::filesystem::path const& path, sample_set& out) -> bool {
+	auto file = std::ifstream{path};
+	if (!file) { return false; }
+	auto line = std::string{};
+	while (std::getline(file, line)) {
+		if (line.empty() || line.front() == '#') { continue; }
+		auto stream = std::istringstream{line};
+		auto name = std::string{};
+		stream >> name;
+		auto& samples = out[name];
+		samples.clear();
+		for (double value{}; stream >> value;) { samples.push_back(value); }
+	}
+	return true;
+}
+
+auto save_baseline(std::filesystem::path const& path, sample_set const& samples) -> bool {
+	auto file = std::ofstream{path};
+	if (!file) { return false; }
+	file << "# carise-framebench baseline: <scene> <frame ms>...\n";
+	file.precision(5);
+	for (auto const& [name, values] : samples) {
+		file << name;
+		for (auto const value : values) { file << ' ' << value; }
+		file << '\n';
+	}
+	return static_cast<bool>(file);
+}
+} // namespace carise::framebench
@@ -0,0 +1,59 @@
+#pragma once
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace carise::framebench {
+/// \brief Summary of frame times, in milliseconds.
+struct summary {
+	double mean{};
+	double median{};
+	double p95{};
+	double p99{};
+	double stddev{};
+	/// \brief Median absolute deviation: spread that one stalled frame cannot inflate.
+	double mad{};
+};
+
+[[nodiscard]] auto summarize(std::span<double const> samples) -> summary;
+
+///
+/// \brief One-sided Mann-Whitney U test (normal approximation with tie correction).
+/// \returns Probability of seeing current rank this high if it came from the same distribution as baseline
+///
+/// Frame times are skewed and heavy tailed, so a rank test is used instead of comparing means.
+///
+[[nodiscard]] auto slower_p_value(std::span<double const> baseline, std::span<double const> current) -> double;
+
+enum class verdict { same, faster, slower };
+
+struct comparison {
+	verdict result{};
+	/// \brief current median / baseline median.
+	double ratio{};
+	double p_value{};
+};
+
+///
+/// \brief Classify current against baseline.
+/// \param threshold Minimum relative change of the median worth reporting (eg 0.05)
+/// \param alpha Significance level of the rank test
+///
+/// Both conditions must hold: significant but tiny shifts (common with thousands of frames) and large but noisy
+/// ones are reported as verdict::same.
+///
+[[nodiscard]] auto compare(std::span<double const> baseline, std::span<double const> current, double threshold, double alpha) -> comparison;
+
+/// \brief Frame time samples per scene name.
+using sample_set = std::map<std::string, std::vector<double>, std::less<>>;
+
+///
+/// \brief Baseline files are plain text, one scene per line: "<name> <ms> <ms> ...".
+///
+/// Raw samples rather than summaries are stored so the rank test has both distributions.
+///
+[[nodiscard]] auto load_baseline(std::filesystem::path const& path, sample_set& out) -> bool;
+[[nodiscard]] auto save_baseline(std::filesystem::path const& path, sample_set const& samples) -> bool;
+} // namespace carise::framebench
@@ -0,0 +1,37 @@
+#include <carise/core/log.hpp>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// Measures the cost of a log call on the calling thread: capture + enqueue only, formatting happens on the writer.
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+constexpr int rounds_v{20};
+constexpr int calls_per_round_v{10'000};
+} // namespace
+
+int main() {
+	auto cfg = carise::log::logger::config{};
+	cfg.binary_path = "log_bench.clog";
+	cfg.thread_capacity = calls_per_round_v * 2;
+	auto logger = carise::log::logger{cfg};
+
+	// unmeasured: the first call registers the thread and the first pass over the ring faults its pages in
+	for (int i = 0; i < calls_per_round_v; ++i) { CARISE_LOG_INFO("frame {} took {:.3}ms in {}", i, 16.6, "warmup"); }
+	std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+	auto total = clock_type::duration{};
+	for (int round = 0; round < rounds_v; ++round) {
+		auto const t0 = clock_type::now();
+		for (int i = 0; i < calls_per_round_v; ++i) { CARISE_LOG_INFO("frame {} took {:.3}ms in {}", i, 16.6, "bench"); }
+		total += clock_type::now() - t0;
+		// let the writer drain so the next round measures enqueue, not drops
+		std::this_thread::sleep_for(std::chrono::milliseconds{50});
+	}
+
+	auto const calls = static_cast<double>(rounds_v * calls_per_round_v);
+	std::printf("%.1f ns per log call (%.0f calls, %llu dropped)\n", std::chrono::duration<double, std::nano>(total).count() / calls, calls,
+				static_cast<unsigned long long>(logger.dropped()));
+}
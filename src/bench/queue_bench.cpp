@@ -0,0 +1,107 @@
+#include <carise/core/mpsc_queue.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Producers push sequence numbers as fast as they can while a single consumer drains;
+// reports wall time per item for each queue against a mutex-guarded std::deque baseline.
+
+namespace {
+using namespace carise;
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t items_per_producer_v{1'000'000};
+constexpr std::size_t batch_size_v{256};
+
+struct mutex_queue {
+	auto try_push(std::uint64_t value) -> bool {
+		auto lock = std::scoped_lock{mutex};
+		items.push_back(value);
+		return true;
+	}
+
+	template <typename Func>
+	auto drain(Func&& func, std::size_t max) -> std::size_t {
+		auto lock = std::scoped_lock{mutex};
+		auto const count = std::min(max, items.size());
+		for (std::size_t i = 0; i < count; ++i) {
+			func(std::move(items.front()));
+			items.pop_front();
+		}
+		return count;
+	}
+
+	std::mutex mutex{};
+	std::deque<std::uint64_t> items{};
+};
+
+struct unbounded_adapter {
+	auto try_push(std::uint64_t value) -> bool {
+		queue.push(value);
+		return true;
+	}
+
+	template <typename Func>
+	auto drain(Func&& func, std::size_t max) -> std::size_t {
+		return queue.drain(std::forward<Func>(func), max);
+	}
+
+	unbounded_mpsc_queue<std::uint64_t> queue{};
+};
+
+template <typename Queue>
+auto run(Queue& queue, std::size_t const producers) -> double {
+	auto const total = producers * items_per_producer_v;
+	auto start = std::atomic<bool>{};
+	auto threads = std::vector<std::thread>{};
+	for (std::size_t p = 0; p < producers; ++p) {
+		threads.emplace_back([&queue, &start] {
+			while (!start.load(std::memory_order_acquire)) {}
+			for (std::uint64_t i = 0; i < items_per_producer_v; ++i) {
+				while (!queue.try_push(i)) { std::this_thread::yield(); }
+			}
+		});
+	}
+
+	auto const t0 = clock_type::now();
+	start.store(true, std::memory_order_release);
+	std::size_t received{};
+	std::uint64_t checksum{};
+	while (received < total) {
+		auto const count = queue.drain([&checksum](std::uint64_t&& value) { checksum += value; }, batch_size_v);
+		if (count == 0) { std::this_thread::yield(); }
+		received += count;
+	}
+	auto const elapsed = clock_type::now() - t0;
+	for (auto& thread : threads) { thread.join(); }
+
+	auto const expected = producers * (items_per_producer_v * (items_per_producer_v - 1) / 2);
+	if (checksum != expected) { std::fprintf(stderr, "checksum mismatch: %llu != %llu\n", (unsigned long long)checksum, (unsigned long long)expected); }
+	return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(total);
+}
+
+template <typename Queue, typename... Args>
+void report(std::string_view const name, std::size_t const producers, Args&&... args) {
+	auto queue = Queue{std::forward<Args>(args)...};
+	auto const ns_per_item = run(queue, producers);
+	std::printf("  %-22.*s %8.2f ns/item %10.2f Mitems/s\n", static_cast<int>(name.size()), name.data(), ns_per_item, 1000.0 / ns_per_item);
+}
+} // namespace
+
+int main() {
+	auto const hardware = std::max(2u, std::thread::hardware_concurrency());
+	for (std::size_t producers = 1; producers < hardware && producers <= 8; producers *= 2) {
+		std::printf("%zu producer(s), 1 consumer, %zu items each, batch %zu\n", producers, items_per_producer_v, batch_size_v);
+		report<mutex_queue>("mutex + std::deque", producers);
+		report<mpsc_queue<std::uint64_t>>("mpsc_queue (4096)", producers, std::size_t{4096});
+		report<unbounded_adapter>("unbounded_mpsc_queue", producers);
+		if (producers == 1) { report<spsc_queue<std::uint64_t>>("spsc_queue (4096)", producers, std::size_t{4096}); }
+	}
+}
@@ -0,0 +1,134 @@
+#include <carise/audio/audio_thread.hpp>
+#include <carise/core/log.hpp>
+#include <chrono>
+#include <cmath>
+
+namespace carise::audio {
+audio_thread::audio_thread(config const& cfg)
+	: m_queue(cfg.queue_capacity),
+	  m_dropped_total(metrics::global().get_counter("carise_audio_commands_dropped_total", "Audio commands dropped because the queue was full")) {
+	m_thread = std::thread{[this, cfg] { run(cfg); }};
+}
+
+audio_thread::~audio_thread() {
+	// shutdown must get through even if the game just filled the queue
+	post_reliable(command{.type = command_type::shutdown});
+	end_frame();
+	m_thread.join();
+}
+
+auto audio_thread::add_sound(sf::SoundBuffer const& buffer) -> sound_id {
+	auto const ret = new_sound_id();
+	post_reliable(command{.type = command_type::set_sound, .request = play_request{.sound = ret}, .buffer = {std::shared_ptr<void>{}, &buffer}});
+	return ret;
+}
+
+void audio_thread::set_sound(sound_id const id, std::shared_ptr<sf::SoundBuffer const> buffer) {
+	post_reliable(command{.type = command_type::set_sound, .request = play_request{.sound = id}, .buffer = std::move(buffer)});
+}
+
+void audio_thread::set_stream(sound_id const id, std::filesystem::path path) {
+	post_reliable(command{.type = command_type::set_stream, .request = play_request{.sound = id}, .path = std::move(path)});
+}
+
+void audio_thread::remove_sound(sound_id const id) { post_reliable(command{.type = command_type::remove_sound, .request = play_request{.sound = id}}); }
+
+auto audio_thread::play(play_request const& request) -> sound_handle {
+	auto const ret = sound_handle{m_next_handle.fetch_add(1, std::memory_order_relaxed) + 1};
+	post(command{.type = command_type::play, .handle = ret, .request = request});
+	return ret;
+}
+
+void audio_thread::stop(sound_handle const handle) { post(command{.type = command_type::stop, .handle = handle}); }
+
+void audio_thread::set_volume(sound_handle const handle, float const volume) { post(command{.type = command_type::set_volume, .handle = handle, .value = volume}); }
+
+void audio_thread::set_pitch(sound_handle const handle, float const pitch) { post(command{.type = command_type::set_pitch, .handle = handle, .value = pitch}); }
+
+void audio_thread::set_category_volume(category const c, float const volume) {
+	post(command{.type = command_type::set_category_volume, .request = play_request{.group = c}, .value = volume});
+}
+
+void audio_thread::set_master_volume(float const volume) { post(command{.type = command_type::set_master_volume, .value = volume}); }
+
+void audio_thread::stop_all() { post(command{.type = command_type::stop_all}); }
+
+void audio_thread::preload_music(std::shared_ptr<music_track const> track) {
+	post_reliable(command{.type = command_type::preload_music, .music = std::move(track)});
+}
+
+void audio_thread::play_music(std::shared_ptr<music_track const> track) { post_reliable(command{.type = command_type::play_music, .music = std::move(track)}); }
+
+void audio_thread::set_music_intensity(float const intensity) {
+	// called every frame with a slowly moving value: only post noticeable changes
+	if (std::abs(intensity - m_music_intensity) < 0.01f) { return; }
+	m_music_intensity = intensity;
+	post(command{.type = command_type::set_music_intensity, .value = intensity});
+}
+
+void audio_thread::set_music_volume(float const volume) { post(command{.type = command_type::set_music_volume, .value = volume}); }
+
+void audio_thread::end_frame() {
+	m_frames_posted.fetch_add(1, std::memory_order_release);
+	m_frames_posted.notify_one();
+}
+
+void audio_thread::post(command cmd) {
+	if (m_queue.try_push(std::move(cmd))) { return; }
+	m_dropped.fetch_add(1, std::memory_order_relaxed);
+	m_dropped_total.add();
+}
+
+void audio_thread::post_reliable(command cmd) {
+	while (!m_queue.try_emplace(cmd)) {
+		// wake the audio thread to make room
+		end_frame();
+		std::this_thread::yield();
+	}
+}
+
+void audio_thread::run(config const& cfg) {
+	auto voices = voice_manager{cfg.voices};
+	auto music = music_player{};
+	auto previous = std::chrono::steady_clock::now();
+	auto seen = std::uint64_t{};
+	auto running = true;
+	while (running) {
+		m_frames_posted.wait(seen, std::memory_order_acquire);
+		seen = m_frames_posted.load(std::memory_order_acquire);
+		m_queue.drain([&](command&& cmd) {
+			if (cmd.type == command_type::shutdown) {
+				running = false;
+				return;
+			}
+			execute(voices, music, cmd);
+		});
+		voices.update();
+		auto const now = std::chrono::steady_clock::now();
+		music.update(std::chrono::duration<float>(now - previous).count());
+		previous = now;
+	}
+	voices.stop_all();
+	CARISE_LOG_DEBUG("audio thread stopped, {} commands dropped", dropped());
+}
+
+void audio_thread::execute(voice_manager& voices, music_player& music, command& cmd) {
+	switch (cmd.type) {
+	case command_type::set_sound: voices.set_sound(cmd.request.sound, std::move(cmd.buffer)); break;
+	case command_type::set_stream: voices.set_stream(cmd.request.sound, std::move(cmd.path)); break;
+	case command_type::remove_sound: voices.remove_sound(cmd.request.sound); break;
+	case command_type::play: voices.play(cmd.request, cmd.handle); break;
+	case command_type::stop: voices.stop(cmd.handle); break;
+	case command_type::set_volume: voices.set_volume(cmd.handle, cmd.value); break;
+	case command_type::set_pitch: voices.set_pitch(cmd.handle, cmd.value); break;
+	case command_type::set_category_volume: voices.set_category_volume(cmd.request.group, cmd.value); break;
+	case command_type::set_master_volume: voices.set_master_volume(cmd.value); break;
+	case command_type::stop_all: voices.stop_all(); break;
+	case command_type::preload_music: music.preload(std::move(cmd.music)); break;
+	case command_type::play_music: music.play(std::move(cmd.music)); break;
+	case command_type::set_music_intensity: music.set_intensity(cmd.value); break;
+	case command_type::set_music_volume: music.set_volume(cmd.value); break;
+	default: break;
+	}
+}
+} // namespace carise::audio
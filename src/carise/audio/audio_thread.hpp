@@ -0,0 +1,115 @@
+#pragma once
+#include <carise/audio/music_player.hpp>
+#include <carise/audio/voice_manager.hpp>
+#include <carise/core/mpsc_queue.hpp>
+#include <atomic>
+#include <thread>
+
+namespace carise::audio {
+///
+/// \brief Runs a voice_manager on a dedicated thread that owns every sf::Sound.
+///
+/// The game posts commands to a bounded lock-free queue and never waits on the audio backend: play() returns
+/// a handle immediately, and nothing reports back. Commands posted during a frame are applied when the thread
+/// wakes for end_frame(), so per-frame merging and priority resolution work exactly as on one thread.
+///
+/// If the queue is full a command is dropped (and counted); sound is best effort, frame time is not.
+/// Registrations are the exception: they retry until queued.
+///
+class audio_thread {
+  public:
+	struct config {
+		voice_manager::config voices{};
+		/// \brief Commands the game can post between two end_frame() calls before they are dropped.
+		std::size_t queue_capacity{1024};
+	};
+
+	audio_thread() : audio_thread(config{}) {}
+	explicit audio_thread(config const& cfg);
+	~audio_thread();
+
+	audio_thread(audio_thread const&) = delete;
+	audio_thread& operator=(audio_thread const&) = delete;
+
+	///
+	/// \brief Register a buffer (load time; the id is usable immediately).
+	///
+	/// buffer must stay alive and unmodified until the audio_thread is destroyed.
+	///
+	[[nodiscard]] auto add_sound(sf::SoundBuffer const& buffer) -> sound_id;
+
+	/// \brief Reserve an id to register later with set_sound() / set_stream() (any thread).
+	[[nodiscard]] auto new_sound_id() -> sound_id { return m_next_sound.fetch_add(1, std::memory_order_relaxed); }
+	/// \brief Register a shared buffer (any thread); the audio thread keeps a reference while it plays.
+	void set_sound(sound_id id, std::shared_ptr<sf::SoundBuffer const> buffer);
+	/// \brief Play id by streaming path from disk (any thread).
+	void set_stream(sound_id id, std::filesystem::path path);
+	/// \brief Unregister id (any thread); sounds already playing finish normally.
+	void remove_sound(sound_id id);
+
+	auto play(play_request const& request) -> sound_handle;
+	void stop(sound_handle handle);
+	void set_volume(sound_handle handle, float volume);
+	void set_pitch(sound_handle handle, float pitch);
+	void set_category_volume(category c, float volume);
+	void set_master_volume(float volume);
+	void stop_all();
+
+	/// \brief Open track's files on the audio thread ahead of play_music(), eg when the player nears a new area.
+	void preload_music(std::shared_ptr<music_track const> track);
+	/// \brief Crossfade music to track (nullptr: fade out); a track not preloaded is opened during the transition.
+	void play_music(std::shared_ptr<music_track const> track);
+	/// \brief Drive adaptive layers, eg from danger_level(); cheap enough to call every frame.
+	void set_music_intensity(float intensity);
+	void set_music_volume(float volume);
+
+	/// \brief Hand this frame's commands to the audio thread (game thread, once per frame).
+	void end_frame();
+
+	/// \brief Commands dropped because the queue was full.
+	[[nodiscard]] auto dropped() const -> std::uint64_t { return m_dropped.load(std::memory_order_relaxed); }
+
+  private:
+	enum class command_type : std::uint8_t {
+		set_sound,
+		set_stream,
+		remove_sound,
+		play,
+		stop,
+		set_volume,
+		set_pitch,
+		set_category_volume,
+		set_master_volume,
+		stop_all,
+		preload_music,
+		play_music,
+		set_music_intensity,
+		set_music_volume,
+		shutdown,
+	};
+
+	struct command {
+		command_type type{};
+		sound_handle handle{};
+		play_request request{};
+		std::shared_ptr<sf::SoundBuffer const> buffer{};
+		std::filesystem::path path{};
+		std::shared_ptr<music_track const> music{};
+		float value{};
+	};
+
+	void post(command cmd);
+	void post_reliable(command cmd);
+	void run(config const& cfg);
+	void execute(voice_manager& voices, music_player& music, command& cmd);
+
+	mpsc_queue<command> m_queue;
+	std::atomic<std::uint64_t> m_frames_posted{};
+	std::atomic<std::uint32_t> m_next_handle{};
+	std::atomic<sound_id> m_next_sound{};
+	std::atomic<std::uint64_t> m_dropped{};
+	float m_music_intensity{-1.0f};
+	metrics::counter& m_dropped_total;
+	std::thread m_thread{};
+};
+} // namespace carise::audio
@@ -0,0 +1,88 @@
+#include <carise/audio/music_player.hpp>
+#include <carise/core/log.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace carise::audio {
+namespace {
+auto target_volume(music_layer const& layer, float const intensity) -> float {
+	if (layer.full <= layer.enter) { return intensity >= layer.enter ? layer.volume : 0.0f; }
+	return std::clamp((intensity - layer.enter) / (layer.full - layer.enter), 0.0f, 1.0f) * layer.volume;
+}
+
+auto approach(float const value, float const target, float const step) -> float {
+	return value < target ? std::min(value + step, target) : std::max(value - step, target);
+}
+} // namespace
+
+void music_player::preload(std::shared_ptr<music_track const> track) {
+	if (!track || track == m_current.track || track == m_prepared.track) { return; }
+	m_prepared = open(std::move(track));
+}
+
+void music_player::play(std::shared_ptr<music_track const> track) {
+	if (track == m_current.track) { return; }
+	if (!m_current.layers.empty()) {
+		m_current.leaving = true;
+		m_leaving.push_back(std::move(m_current));
+	}
+	if (!track) {
+		m_current = deck{};
+		return;
+	}
+	if (track == m_prepared.track) {
+		m_current = std::move(m_prepared);
+		m_prepared = deck{};
+	} else {
+		CARISE_LOG_DEBUG("music: track was not preloaded, opening {} layers during the transition", track->layers.size());
+		m_current = open(std::move(track));
+	}
+	// start together so the stems stay in sync
+	for (auto& layer : m_current.layers) { layer.music->play(); }
+}
+
+auto music_player::open(std::shared_ptr<music_track const> track) -> deck {
+	auto ret = deck{.track = std::move(track)};
+	ret.layers.reserve(ret.track->layers.size());
+	for (auto const& desc : ret.track->layers) {
+		auto layer = layer_state{.music = std::make_unique<sf::Music>(), .desc = desc};
+		if (!layer.music->openFromFile(desc.path)) {
+			CARISE_LOG_WARN("music: failed to open {}", desc.path.string());
+			continue;
+		}
+		layer.music->setLoop(true);
+		layer.music->setVolume(0.0f);
+		layer.music->setRelativeToListener(true);
+		ret.layers.push_back(std::move(layer));
+	}
+	return ret;
+}
+
+void music_player::update(float const dt) {
+	auto const tick = [&](deck& d) {
+		auto const fade_seconds = std::max(d.track->fade_seconds, 0.01f);
+		d.fade = approach(d.fade, d.leaving ? 0.0f : 1.0f, dt / fade_seconds);
+		for (auto& layer : d.layers) {
+			layer.volume = approach(layer.volume, target_volume(layer.desc, m_intensity), dt / fade_seconds);
+			layer.music->setVolume(layer.volume * d.fade * m_volume * 100.0f);
+		}
+	};
+	if (m_current.track) { tick(m_current); }
+	for (auto& d : m_leaving) { tick(d); }
+	// finished fading out: closing the streams stops their decoding threads
+	std::erase_if(m_leaving, [](deck const& d) { return d.fade <= 0.0f; });
+}
+
+auto danger_level(sf::Vector2f const player, std::span<threat const> threats, float const radius) -> float {
+	auto sum = 0.0f;
+	auto const radius_squared = radius * radius;
+	for (auto const& t : threats) {
+		auto const offset = t.position - player;
+		auto const distance_squared = offset.x * offset.x + offset.y * offset.y;
+		if (distance_squared >= radius_squared) { continue; }
+		auto const proximity = 1.0f - std::sqrt(distance_squared) / radius;
+		sum += t.weight * proximity * proximity;
+	}
+	return 1.0f - std::exp(-sum);
+}
+} // namespace carise::audio
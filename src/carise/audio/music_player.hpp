@@ -0,0 +1,90 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <SFML/System.hpp>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace carise::audio {
+///
+/// \brief One stem of an adaptive track, audible over a range of intensity.
+///
+/// The layer fades in as intensity rises from enter to full; eg drums with {0.3, 0.5} join at moderate danger.
+///
+struct music_layer {
+	std::filesystem::path path{};
+	float enter{};
+	float full{};
+	float volume{1.0f};
+};
+
+struct music_track {
+	std::vector<music_layer> layers{};
+	/// \brief Time for a layer to go from silent to full volume, and for whole tracks to crossfade.
+	float fade_seconds{2.0f};
+};
+
+///
+/// \brief Plays music_tracks as sets of synchronised looping sf::Music layers (audio thread only).
+///
+/// Every layer of a track is started together at zero volume, so each has its stream buffered (SFML decodes
+/// on its own streaming thread) before it is ever audible; intensity changes only move volumes. Changing
+/// track crossfades the old one out while the new one fades in.
+///
+/// preload() opens the next track's files ahead of time, so the transition itself does no file I/O.
+///
+class music_player {
+  public:
+	/// \brief Open every layer of track without starting it, replacing any other preloaded track.
+	void preload(std::shared_ptr<music_track const> track);
+	/// \brief Crossfade to track (nullptr: fade out to silence), swapping in the preloaded deck if it is track.
+	void play(std::shared_ptr<music_track const> track);
+	/// \brief Game intensity in [0, 1]; layer volumes glide towards their new targets.
+	void set_intensity(float const intensity) { m_intensity = intensity; }
+	void set_volume(float const volume) { m_volume = volume; }
+	void update(float dt);
+
+	[[nodiscard]] auto intensity() const -> float { return m_intensity; }
+
+  private:
+	struct layer_state {
+		std::unique_ptr<sf::Music> music{};
+		music_layer desc{};
+		float volume{};
+	};
+
+	struct deck {
+		std::shared_ptr<music_track const> track{};
+		std::vector<layer_state> layers{};
+		/// \brief Whole-track gain, faded in on start and out when replaced.
+		float fade{};
+		bool leaving{};
+	};
+
+	/// \brief Open and configure every layer, stopped.
+	[[nodiscard]] static auto open(std::shared_ptr<music_track const> track) -> deck;
+
+	deck m_current{};
+	/// \brief Opened by preload(), waiting for play().
+	deck m_prepared{};
+	std::vector<deck> m_leaving{};
+	float m_intensity{};
+	float m_volume{1.0f};
+};
+
+/// \brief Something dangerous near the player, for danger_level().
+struct threat {
+	sf::Vector2f position{};
+	/// \brief 1 for an ordinary hostile; bosses more, fleeing or sleeping monsters less.
+	float weight{1.0f};
+};
+
+///
+/// \brief Cheap intensity estimate in [0, 1] from threats within radius of the player.
+///
+/// Each threat contributes its weight scaled by proximity; the sum saturates smoothly, so one monster next to
+/// the player or a crowd at a distance both register, and the result moves gradually as monsters approach.
+///
+[[nodiscard]] auto danger_level(sf::Vector2f player, std::span<threat const> threats, float radius) -> float;
+} // namespace carise::audio
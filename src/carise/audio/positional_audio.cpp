@@ -0,0 +1,39 @@
+#include <carise/audio/positional_audio.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace carise::audio {
+namespace {
+auto to_tile(sf::Vector2f const position) -> sf::Vector2i { return {static_cast<int>(std::floor(position.x)), static_cast<int>(std::floor(position.y))}; }
+} // namespace
+
+positional_audio::positional_audio(tile_map const& map, config const& cfg) : m_cache(map, cfg.propagation), m_config(cfg) {}
+
+auto positional_audio::spatialize(play_request request, sf::Vector2f const source) -> std::optional<play_request> {
+	auto const range = static_cast<float>(m_cache.radius());
+	auto const offset = source - m_listener;
+	auto const direct = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+	if (direct >= range) {
+		++m_culled;
+		return std::nullopt;
+	}
+
+	auto const cost = m_cache.field(to_tile(source)).cost(to_tile(m_listener));
+	if (cost == propagation_field::unreachable_v) {
+		++m_culled;
+		return std::nullopt;
+	}
+	auto const path = static_cast<float>(cost) / static_cast<float>(propagation_field::step_cost_v);
+	// quadratic rolloff reaching silence at the edge of hearing range
+	auto const falloff = std::max(1.0f - path / range, 0.0f);
+	auto const detour = std::max(path - direct - 1.0f, 0.0f);
+	auto const occlusion = 1.0f - std::exp2(-detour / m_config.occlusion_half_distance);
+
+	request.volume *= falloff * falloff * (1.0f - occlusion);
+	request.pitch *= 1.0f + (m_config.occluded_pitch - 1.0f) * occlusion;
+	// listener faces -z: screen right is +x, screen up is forward
+	request.direction = direct > 0.5f ? sf::Vector3f{offset.x / direct, 0.0f, offset.y / direct} : sf::Vector3f{0.0f, 0.0f, -1.0f};
+	request.spatial = true;
+	return request;
+}
+} // namespace carise::audio
@@ -0,0 +1,49 @@
+#pragma once
+#include <carise/audio/propagation.hpp>
+#include <carise/audio/voice_manager.hpp>
+#include <optional>
+
+namespace carise::audio {
+///
+/// \brief Turns a sound at a map position into a voice_manager request heard from the listener's tile.
+///
+/// Sounds beyond hearing range are culled with a distance check before any path lookup. The rest are
+/// attenuated by the path length through the source tile's cached propagation field, and the detour the sound
+/// had to take (path length beyond the straight line, walls included) is treated as occlusion: quieter and
+/// lower pitched, a cheap stand-in for a low-pass filter. Direction to the source drives stereo panning.
+///
+/// Each request costs one distance check and at most one cache lookup, independent of the number of sources.
+///
+class positional_audio {
+  public:
+	struct config {
+		propagation_cache::config propagation{};
+		/// \brief Detour in tiles that halves the volume.
+		float occlusion_half_distance{4.0f};
+		/// \brief Pitch multiplier of a fully occluded sound.
+		float occluded_pitch{0.85f};
+	};
+
+	explicit positional_audio(tile_map const& map) : positional_audio(map, config{}) {}
+	positional_audio(tile_map const& map, config const& cfg);
+
+	/// \brief Listener position in tiles (fractional).
+	void set_listener(sf::Vector2f const position) { m_listener = position; }
+	[[nodiscard]] auto listener() const -> sf::Vector2f { return m_listener; }
+
+	///
+	/// \brief Adjust request for a sound emitted at source (tiles).
+	/// \returns std::nullopt if inaudible from the listener
+	///
+	[[nodiscard]] auto spatialize(play_request request, sf::Vector2f source) -> std::optional<play_request>;
+
+	[[nodiscard]] auto culled() const -> std::uint64_t { return m_culled; }
+	[[nodiscard]] auto cache() const -> propagation_cache const& { return m_cache; }
+
+  private:
+	propagation_cache m_cache;
+	config m_config;
+	sf::Vector2f m_listener{};
+	std::uint64_t m_culled{};
+};
+} // namespace carise::audio
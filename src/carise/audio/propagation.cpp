@@ -0,0 +1,106 @@
+#include <carise/audio/propagation.hpp>
+#include <algorithm>
+#include <array>
+
+namespace carise::audio {
+auto propagation_field::cost(sf::Vector2i const tile) const -> std::uint16_t {
+	auto const local = tile - m_source + sf::Vector2i{m_radius, m_radius};
+	auto const side = 2 * m_radius + 1;
+	if (local.x < 0 || local.y < 0 || local.x >= side || local.y >= side) { return unreachable_v; }
+	return m_costs[local.y * side + local.x];
+}
+
+propagation_cache::propagation_cache(tile_map const& map, config const& cfg) : m_map(map), m_config(cfg), m_side(2 * cfg.radius + 1) {
+	auto const cells = static_cast<std::size_t>(m_side * m_side);
+	m_storage.resize(cells * cfg.capacity);
+	m_fields.resize(cfg.capacity);
+	for (std::size_t i = 0; i < cfg.capacity; ++i) {
+		m_fields[i].m_radius = cfg.radius;
+		m_fields[i].m_costs = m_storage.data() + i * cells;
+	}
+	// every cell can be pushed once per neighbour
+	m_open.reserve(cells * 8);
+}
+
+auto propagation_cache::field(sf::Vector2i const source) -> propagation_field const& {
+	++m_tick;
+	propagation_field* victim{};
+	for (auto& f : m_fields) {
+		if (f.m_valid && f.m_source == source) {
+			if (!is_current(f)) {
+				compute(f, source);
+			} else {
+				// unchanged by the edits since it was computed; skip the chunk scan next time
+				f.m_revision = m_map.revision();
+				++m_hits;
+			}
+			f.m_last_used = m_tick;
+			return f;
+		}
+		if (!victim || !f.m_valid || (victim->m_valid && f.m_last_used < victim->m_last_used)) { victim = &f; }
+	}
+	compute(*victim, source);
+	victim->m_last_used = m_tick;
+	return *victim;
+}
+
+auto propagation_cache::is_current(propagation_field const& field) const -> bool {
+	if (field.m_revision == m_map.revision()) { return true; }
+	// something changed somewhere: only recompute if it was inside this field's window
+	auto const chunks = m_map.chunk_count();
+	auto const lo = m_map.chunk_of({std::max(field.m_source.x - field.m_radius, 0), std::max(field.m_source.y - field.m_radius, 0)});
+	auto const hi = m_map.chunk_of({std::min(field.m_source.x + field.m_radius, m_map.size().x - 1), std::min(field.m_source.y + field.m_radius, m_map.size().y - 1)});
+	for (int cy = lo.y; cy <= hi.y && cy < chunks.y; ++cy) {
+		for (int cx = lo.x; cx <= hi.x && cx < chunks.x; ++cx) {
+			if (m_map.chunk_revision({cx, cy}) > field.m_revision) { return false; }
+		}
+	}
+	return true;
+}
+
+void propagation_cache::compute(propagation_field& out, sf::Vector2i const source) {
+	static constexpr auto neighbours_v = std::array<std::pair<sf::Vector2i, std::uint16_t>, 8>{{
+		{{1, 0}, propagation_field::step_cost_v},
+		{{-1, 0}, propagation_field::step_cost_v},
+		{{0, 1}, propagation_field::step_cost_v},
+		{{0, -1}, propagation_field::step_cost_v},
+		{{1, 1}, propagation_field::diagonal_cost_v},
+		{{-1, 1}, propagation_field::diagonal_cost_v},
+		{{1, -1}, propagation_field::diagonal_cost_v},
+		{{-1, -1}, propagation_field::diagonal_cost_v},
+	}};
+	++m_computed;
+	out.m_source = source;
+	out.m_revision = m_map.revision();
+	out.m_valid = true;
+	auto* costs = out.m_costs;
+	std::fill_n(costs, m_side * m_side, propagation_field::unreachable_v);
+
+	auto const limit = max_cost();
+	auto const greater = [](open_node const& a, open_node const& b) { return a.cost > b.cost; };
+	auto const origin = source - sf::Vector2i{m_config.radius, m_config.radius};
+	auto const centre = static_cast<std::uint32_t>(m_config.radius * m_side + m_config.radius);
+	costs[centre] = 0;
+	m_open.clear();
+	m_open.push_back({0, centre});
+	while (!m_open.empty()) {
+		std::pop_heap(m_open.begin(), m_open.end(), greater);
+		auto const node = m_open.back();
+		m_open.pop_back();
+		if (node.cost > costs[node.index]) { continue; }
+		auto const local = sf::Vector2i{static_cast<int>(node.index) % m_side, static_cast<int>(node.index) / m_side};
+		for (auto const& [offset, step] : neighbours_v) {
+			auto const next = local + offset;
+			if (next.x < 0 || next.y < 0 || next.x >= m_side || next.y >= m_side) { continue; }
+			auto const tile = origin + next;
+			if (!m_map.in_bounds(tile)) { continue; }
+			auto const cost = node.cost + step + (m_map.is_wall(tile) ? m_config.wall_cost : 0);
+			auto const index = static_cast<std::uint32_t>(next.y * m_side + next.x);
+			if (cost >= limit || cost >= costs[index]) { continue; }
+			costs[index] = static_cast<std::uint16_t>(cost);
+			m_open.push_back({static_cast<std::uint16_t>(cost), index});
+			std::push_heap(m_open.begin(), m_open.end(), greater);
+		}
+	}
+}
+} // namespace carise::audio
@@ -0,0 +1,83 @@
+#pragma once
+#include <carise/world/tile_map.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace carise::audio {
+///
+/// \brief How far sound travels from one source tile: shortest path cost to every tile within range.
+///
+/// Costs are in tenths of a tile (10 per orthogonal step, 14 per diagonal); walls do not block outright but
+/// add wall_cost per wall tile crossed, so sound through a thin wall arrives quieter and muffled.
+///
+class propagation_field {
+  public:
+	static constexpr std::uint16_t unreachable_v{0xffff};
+	static constexpr std::uint16_t step_cost_v{10};
+	static constexpr std::uint16_t diagonal_cost_v{14};
+
+	[[nodiscard]] auto source() const -> sf::Vector2i { return m_source; }
+	/// \brief Path cost from the source to tile, or unreachable_v if out of range.
+	[[nodiscard]] auto cost(sf::Vector2i tile) const -> std::uint16_t;
+
+  private:
+	friend class propagation_cache;
+
+	sf::Vector2i m_source{};
+	int m_radius{};
+	std::uint16_t* m_costs{};
+	std::uint64_t m_revision{};
+	std::uint64_t m_last_used{};
+	bool m_valid{};
+};
+
+///
+/// \brief Fixed-size LRU cache of propagation fields keyed by source tile.
+///
+/// A field is computed (Dijkstra over a (2 radius + 1)^2 window) the first time its tile emits a sound and
+/// reused until a map chunk it covers changes. All memory is allocated at construction.
+///
+class propagation_cache {
+  public:
+	struct config {
+		/// \brief Hearing range in tiles; also the field's half extent.
+		int radius{24};
+		/// \brief Extra cost of passing through one wall tile.
+		std::uint16_t wall_cost{60};
+		std::size_t capacity{64};
+	};
+
+	explicit propagation_cache(tile_map const& map) : propagation_cache(map, config{}) {}
+	propagation_cache(tile_map const& map, config const& cfg);
+
+	propagation_cache(propagation_cache const&) = delete;
+	propagation_cache& operator=(propagation_cache const&) = delete;
+
+	[[nodiscard]] auto field(sf::Vector2i source) -> propagation_field const&;
+
+	[[nodiscard]] auto radius() const -> int { return m_config.radius; }
+	/// \brief Costs at or beyond this are never reached.
+	[[nodiscard]] auto max_cost() const -> std::uint16_t { return static_cast<std::uint16_t>(m_config.radius * propagation_field::step_cost_v); }
+	[[nodiscard]] auto computed() const -> std::uint64_t { return m_computed; }
+	[[nodiscard]] auto hits() const -> std::uint64_t { return m_hits; }
+
+  private:
+	struct open_node {
+		std::uint16_t cost;
+		std::uint32_t index;
+	};
+
+	[[nodiscard]] auto is_current(propagation_field const& field) const -> bool;
+	void compute(propagation_field& out, sf::Vector2i source);
+
+	tile_map const& m_map;
+	config m_config;
+	int m_side{};
+	memory::tagged_vector<std::uint16_t, memory::tag::audio> m_storage{};
+	std::vector<propagation_field> m_fields{};
+	std::vector<open_node> m_open{};
+	std::uint64_t m_tick{};
+	std::uint64_t m_computed{};
+	std::uint64_t m_hits{};
+};
+} // namespace carise::audio
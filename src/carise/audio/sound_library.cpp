@@ -0,0 +1,120 @@
+#include <carise/audio/sound_library.hpp>
+#include <carise/core/log.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace carise::audio {
+sound_library::sound_library(audio_thread& audio, config cfg)
+	: m_audio(audio), m_config(std::move(cfg)),
+	  m_resident_gauge(metrics::global().get_gauge("carise_audio_resident_bytes", "Decoded sound effect samples held in memory")) {
+	m_evictor = memory::global().add_evictor(memory::tag::audio, [this](std::size_t const over) { return evict(over); });
+	m_worker = std::thread{[this] { run(); }};
+}
+
+sound_library::~sound_library() {
+	memory::global().remove_evictor(m_evictor);
+	m_stop.store(true, std::memory_order_relaxed);
+	m_jobs_posted.fetch_add(1, std::memory_order_release);
+	m_jobs_posted.notify_one();
+	m_worker.join();
+	// the audio thread may still hold buffers; unregistering drops its references once it gets to them
+	for (auto const& e : m_entries) {
+		if (e.status.load(std::memory_order_relaxed) != state::unloaded) { m_audio.remove_sound(e.id); }
+	}
+}
+
+auto sound_library::acquire(std::string_view const name) -> sound_ref {
+	auto lock = std::scoped_lock{m_mutex};
+	auto it = m_by_name.find(std::string{name});
+	if (it == m_by_name.end()) {
+		auto& created = m_entries.emplace_back();
+		created.name = name;
+		created.id = m_audio.new_sound_id();
+		it = m_by_name.emplace(created.name, &created).first;
+	}
+	auto& e = *it->second;
+	e.refs.fetch_add(1, std::memory_order_relaxed);
+	e.last_used = ++m_tick;
+	if (e.status.load(std::memory_order_relaxed) == state::unloaded) {
+		e.status.store(state::loading, std::memory_order_relaxed);
+		m_jobs.push(&e);
+		m_jobs_posted.fetch_add(1, std::memory_order_release);
+		m_jobs_posted.notify_one();
+	}
+	return sound_ref{e};
+}
+
+auto sound_library::evict(std::size_t const bytes) -> std::size_t {
+	auto lock = std::scoped_lock{m_mutex};
+	auto candidates = std::vector<entry*>{};
+	for (auto& e : m_entries) {
+		if (e.data && e.refs.load(std::memory_order_acquire) == 0) { candidates.push_back(&e); }
+	}
+	std::sort(candidates.begin(), candidates.end(), [](entry const* a, entry const* b) { return a->last_used < b->last_used; });
+	std::size_t ret{};
+	for (auto* e : candidates) {
+		if (ret >= bytes) { break; }
+		auto const size = e->data->size;
+		m_audio.remove_sound(e->id);
+		// the audio thread releases its reference (and the memory) once voices playing it finish
+		e->data.reset();
+		e->status.store(state::unloaded, std::memory_order_release);
+		m_resident.fetch_sub(size, std::memory_order_relaxed);
+		ret += size;
+	}
+	if (ret > 0) {
+		m_resident_gauge.set(static_cast<double>(resident_bytes()));
+		CARISE_LOG_DEBUG("audio: evicted {} bytes of sound buffers", ret);
+	}
+	return ret;
+}
+
+void sound_library::load(entry& e) {
+	auto const path = m_config.root / e.name;
+	auto file = sf::InputSoundFile{};
+	if (!file.openFromFile(path)) {
+		CARISE_LOG_WARN("audio: failed to open {}", path.string());
+		e.status.store(state::failed, std::memory_order_release);
+		return;
+	}
+	if (file.getDuration().asSeconds() > m_config.stream_threshold_seconds) {
+		m_audio.set_stream(e.id, path);
+		e.status.store(state::streamed, std::memory_order_release);
+		return;
+	}
+
+	auto data = std::make_shared<decoded>();
+	{
+		auto const attribute = memory::scope{memory::tag::audio};
+		if (!data->buffer.loadFromFile(path)) {
+			CARISE_LOG_WARN("audio: failed to decode {}", path.string());
+			e.status.store(state::failed, std::memory_order_release);
+			return;
+		}
+	}
+	data->size = static_cast<std::size_t>(data->buffer.getSampleCount()) * sizeof(std::int16_t);
+	auto const bytes = data->size;
+#if !CARISE_TRACK_ALLOCATIONS
+	// SFML's own allocation is invisible to the tagged allocators
+	data->tracked = memory::tracked_bytes{memory::tag::audio, bytes};
+#endif
+	m_audio.set_sound(e.id, std::shared_ptr<sf::SoundBuffer const>{data, &data->buffer});
+	// publish data and status together so evict() never sees one without the other
+	auto lock = std::scoped_lock{m_mutex};
+	e.data = std::move(data);
+	e.status.store(state::ready, std::memory_order_release);
+	m_resident.fetch_add(bytes, std::memory_order_relaxed);
+	m_resident_gauge.set(static_cast<double>(resident_bytes()));
+}
+
+void sound_library::run() {
+	auto seen = std::uint64_t{};
+	while (!m_stop.load(std::memory_order_relaxed)) {
+		m_jobs_posted.wait(seen, std::memory_order_acquire);
+		seen = m_jobs_posted.load(std::memory_order_acquire);
+		m_jobs.drain([this](entry*&& e) {
+			if (!m_stop.load(std::memory_order_relaxed)) { load(*e); }
+		});
+	}
+}
+} // namespace carise::audio
@@ -0,0 +1,150 @@
+#pragma once
+#include <carise/audio/audio_thread.hpp>
+#include <carise/core/memory.hpp>
+#include <carise/core/mpsc_queue.hpp>
+#include <atomic>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace carise::audio {
+class sound_ref;
+
+///
+/// \brief Shared, refcounted sound effects loaded on demand.
+///
+/// The first acquire() of a name queues it for a worker thread, which decodes it into an sf::SoundBuffer and
+/// hands that to the audio thread; later acquires share it. Files longer than stream_threshold_seconds are
+/// never decoded into memory: the audio thread streams them through sf::Music on every play.
+///
+/// Decoded buffers are accounted under memory::tag::audio. Buffers nobody references stay resident for reuse
+/// until the audio budget is exceeded, then the least recently acquired are evicted first.
+///
+/// The library must outlive every sound_ref it hands out.
+///
+class sound_library {
+  public:
+	struct config {
+		std::filesystem::path root{"assets/sounds"};
+		/// \brief Files longer than this are streamed instead of decoded.
+		float stream_threshold_seconds{8.0f};
+	};
+
+	explicit sound_library(audio_thread& audio) : sound_library(audio, config{}) {}
+	sound_library(audio_thread& audio, config cfg);
+	~sound_library();
+
+	sound_library(sound_library const&) = delete;
+	sound_library& operator=(sound_library const&) = delete;
+
+	/// \brief Reference the sound at root / name, queueing it for decoding if it isn't resident (game thread).
+	[[nodiscard]] auto acquire(std::string_view name) -> sound_ref;
+
+	///
+	/// \brief Evict unreferenced decoded sounds, least recently acquired first.
+	/// \returns Bytes released
+	///
+	auto evict(std::size_t bytes) -> std::size_t;
+
+	/// \brief Bytes of decoded samples currently held by the library.
+	[[nodiscard]] auto resident_bytes() const -> std::size_t { return m_resident.load(std::memory_order_relaxed); }
+
+  private:
+	friend class sound_ref;
+
+	enum class state : std::uint8_t { unloaded, loading, ready, streamed, failed };
+
+	/// \brief Decoded samples plus their accounting; the audio thread holds it through an aliasing shared_ptr.
+	struct decoded {
+		sf::SoundBuffer buffer{};
+		/// \brief Decoded sample bytes, for residency and eviction in every build.
+		std::size_t size{};
+		/// \brief Tracker accounting only; empty when allocations are tracked globally.
+		memory::tracked_bytes tracked{};
+	};
+
+	struct entry {
+		std::string name{};
+		sound_id id{no_sound_v};
+		std::atomic<std::uint32_t> refs{};
+		std::atomic<state> status{state::unloaded};
+		// guarded by m_mutex
+		std::shared_ptr<decoded> data{};
+		std::uint64_t last_used{};
+	};
+
+	void load(entry& e);
+	void run();
+
+	audio_thread& m_audio;
+	config m_config;
+
+	std::mutex m_mutex{};
+	// deque for stable addresses: sound_ref and queued jobs point into it
+	std::deque<entry> m_entries{};
+	std::unordered_map<std::string, entry*> m_by_name{};
+	std::uint64_t m_tick{};
+
+	std::atomic<std::size_t> m_resident{};
+	metrics::gauge& m_resident_gauge;
+	memory::tracker::evictor_id m_evictor{};
+
+	unbounded_mpsc_queue<entry*> m_jobs{};
+	std::atomic<std::uint64_t> m_jobs_posted{};
+	std::atomic<bool> m_stop{};
+	std::thread m_worker{};
+};
+
+///
+/// \brief Reference to a sound in a sound_library; the sound can't be evicted while any reference exists.
+///
+/// Cheap to copy (one atomic increment). Play it with play_request{.sound = ref.id()}; until ready(), play
+/// requests for it are ignored, so acquire sounds when a level or creature loads rather than when they play.
+///
+class sound_ref {
+  public:
+	sound_ref() = default;
+	~sound_ref() { reset(); }
+
+	sound_ref(sound_ref const& rhs) : m_entry(rhs.m_entry) {
+		if (m_entry) { m_entry->refs.fetch_add(1, std::memory_order_relaxed); }
+	}
+	sound_ref& operator=(sound_ref const& rhs) {
+		if (&rhs != this) { *this = sound_ref{rhs}; }
+		return *this;
+	}
+	sound_ref(sound_ref&& rhs) noexcept : m_entry(std::exchange(rhs.m_entry, nullptr)) {}
+	sound_ref& operator=(sound_ref&& rhs) noexcept {
+		if (&rhs != this) {
+			reset();
+			m_entry = std::exchange(rhs.m_entry, nullptr);
+		}
+		return *this;
+	}
+
+	void reset() {
+		if (m_entry) { std::exchange(m_entry, nullptr)->refs.fetch_sub(1, std::memory_order_release); }
+	}
+
+	[[nodiscard]] auto id() const -> sound_id { return m_entry ? m_entry->id : no_sound_v; }
+	/// \brief Decoded (or set up for streaming) and playable.
+	[[nodiscard]] auto ready() const -> bool {
+		if (!m_entry) { return false; }
+		auto const status = m_entry->status.load(std::memory_order_acquire);
+		return status == sound_library::state::ready || status == sound_library::state::streamed;
+	}
+	[[nodiscard]] auto failed() const -> bool { return m_entry && m_entry->status.load(std::memory_order_acquire) == sound_library::state::failed; }
+	explicit operator bool() const { return m_entry != nullptr; }
+
+  private:
+	friend class sound_library;
+	/// \brief Takes over one reference already counted by the caller.
+	explicit sound_ref(sound_library::entry& e) : m_entry(&e) {}
+
+	sound_library::entry* m_entry{};
+};
+} // namespace carise::audio
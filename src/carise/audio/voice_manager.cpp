@@ -0,0 +1,222 @@
+#include <carise/audio/voice_manager.hpp>
+#include <carise/core/log.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace carise::audio {
+auto to_string(category const c) -> std::string_view {
+	switch (c) {
+	case category::ui: return "ui";
+	case category::combat: return "combat";
+	case category::creatures: return "creatures";
+	case category::ambience: return "ambience";
+	case category::footsteps: return "footsteps";
+	default: return "?";
+	}
+}
+
+voice_manager::voice_manager(config const& cfg)
+	: m_config(cfg), m_voices(cfg.voices + cfg.streams),
+	  m_started_total(metrics::global().get_counter("carise_audio_voices_started_total", "Sound effect voices started")),
+	  m_stolen_total(metrics::global().get_counter("carise_audio_voices_stolen_total", "Playing voices cut off for a higher priority sound")),
+	  m_dropped_total(metrics::global().get_counter("carise_audio_requests_dropped_total", "Sound requests that did not get a voice")),
+	  m_active_voices(metrics::global().get_gauge("carise_audio_active_voices", "Sound effect voices playing")) {
+	for (auto i = cfg.voices; i < m_voices.size(); ++i) { m_voices[i].music = std::make_unique<sf::Music>(); }
+	m_pending.reserve(cfg.max_requests_per_frame);
+	m_category_volumes.fill(1.0f);
+}
+
+auto voice_manager::add_sound(sf::SoundBuffer const& buffer) -> sound_id {
+	auto const ret = static_cast<sound_id>(m_sounds.size());
+	set_sound(ret, buffer);
+	return ret;
+}
+
+void voice_manager::set_sound(sound_id const id, sf::SoundBuffer const& buffer) {
+	// aliasing constructor with an empty owner: a non-owning shared_ptr, no allocation
+	set_sound(id, std::shared_ptr<sf::SoundBuffer const>{std::shared_ptr<void>{}, &buffer});
+}
+
+void voice_manager::set_sound(sound_id const id, std::shared_ptr<sf::SoundBuffer const> buffer) {
+	if (id >= m_sounds.size()) { m_sounds.resize(id + 1); }
+	m_sounds[id] = sound_entry{.buffer = std::move(buffer)};
+}
+
+void voice_manager::set_stream(sound_id const id, std::filesystem::path path) {
+	if (id >= m_sounds.size()) { m_sounds.resize(id + 1); }
+	m_sounds[id] = sound_entry{.stream = std::move(path)};
+}
+
+void voice_manager::remove_sound(sound_id const id) {
+	if (id < m_sounds.size()) { m_sounds[id] = {}; }
+}
+
+auto voice_manager::play(play_request const& request, sound_handle const handle) -> bool {
+	if (!is_registered(request.sound)) { return false; }
+	++m_stats.requested;
+	// the same sound twice in one frame is one louder sound to the player: merge instead of spending a voice
+	for (auto& p : m_pending) {
+		if (p.request.sound != request.sound) { continue; }
+		auto const importance = std::max(p.request.importance, request.importance);
+		if (request.volume > p.request.volume) {
+			p.request = request;
+			p.handle = handle;
+		}
+		p.request.importance = importance;
+		++p.count;
+		++m_stats.merged;
+		return true;
+	}
+	if (m_pending.size() == m_pending.capacity()) {
+		++m_stats.dropped;
+		return false;
+	}
+	m_pending.push_back(pending{.request = request, .handle = handle, .order = static_cast<std::uint32_t>(m_pending.size()), .count = 1});
+	return true;
+}
+
+void voice_manager::update() {
+	auto const now = clock_type::now();
+	refresh_voices();
+
+	// highest priority first, equal priorities in request order (std::stable_sort may allocate)
+	std::sort(m_pending.begin(), m_pending.end(), [](pending const& a, pending const& b) {
+		return a.request.importance != b.request.importance ? a.request.importance > b.request.importance : a.order < b.order;
+	});
+	for (auto const& p : m_pending) {
+		// registration may have been removed since play()
+		if (!is_registered(p.request.sound)) { continue; }
+		auto* v = find_voice(p.request, !m_sounds[p.request.sound].buffer, now);
+		if (!v || !start(*v, p, now)) { ++m_stats.dropped; }
+	}
+	m_pending.clear();
+
+	m_stats.active = static_cast<std::size_t>(std::count_if(m_voices.begin(), m_voices.end(), [](voice const& v) { return v.busy; }));
+	m_started_total.add(m_stats.started);
+	m_stolen_total.add(m_stats.stolen);
+	m_dropped_total.add(m_stats.dropped);
+	m_active_voices.set(static_cast<double>(m_stats.active));
+	if (m_stats.dropped > 0) { CARISE_LOG_TRACE("audio: {} sound requests dropped this frame", m_stats.dropped); }
+	m_last = std::exchange(m_stats, frame_stats{});
+}
+
+void voice_manager::stop(sound_handle const handle) {
+	if (!handle) { return; }
+	std::erase_if(m_pending, [handle](pending const& p) { return p.handle == handle; });
+	if (auto* v = find_playing(handle)) { release(*v); }
+}
+
+void voice_manager::set_volume(sound_handle const handle, float const volume) {
+	if (auto* v = find_playing(handle)) { source(*v).setVolume(gain(v->group, volume)); }
+}
+
+void voice_manager::set_pitch(sound_handle const handle, float const pitch) {
+	if (auto* v = find_playing(handle)) { source(*v).setPitch(pitch); }
+}
+
+void voice_manager::stop_all() {
+	for (auto& v : m_voices) {
+		if (v.busy) { release(v); }
+	}
+	m_pending.clear();
+}
+
+auto voice_manager::source(voice& v) -> sf::SoundSource& {
+	if (v.music) { return *v.music; }
+	return v.sound;
+}
+
+auto voice_manager::is_registered(sound_id const id) const -> bool { return id < m_sounds.size() && (m_sounds[id].buffer || !m_sounds[id].stream.empty()); }
+
+void voice_manager::refresh_voices() {
+	for (auto& v : m_voices) {
+		if (v.busy && source(v).getStatus() == sf::SoundSource::Status::Stopped) { release(v); }
+	}
+}
+
+void voice_manager::release(voice& v) {
+	if (v.music) {
+		v.music->stop();
+	} else {
+		v.sound.stop();
+		// detach before dropping our reference: the buffer may be destroyed right here, and a buffer notifies
+		// every sf::Sound still attached to it
+		v.sound.resetBuffer();
+		v.buffer.reset();
+	}
+	v.busy = false;
+	--m_category_active[static_cast<std::size_t>(v.group)];
+}
+
+auto voice_manager::find_voice(play_request const& request, bool const streamed, clock_type::time_point const now) -> voice* {
+	auto const limit = m_config.category_limits[static_cast<std::size_t>(request.group)];
+	if (limit > 0 && m_category_active[static_cast<std::size_t>(request.group)] >= limit) { return find_victim(request, streamed, true, now); }
+	for (auto& v : m_voices) {
+		if (!v.busy && (v.music != nullptr) == streamed) { return &v; }
+	}
+	return find_victim(request, streamed, false, now);
+}
+
+auto voice_manager::find_victim(play_request const& request, bool const streamed, bool const same_category_only, clock_type::time_point const now)
+	-> voice* {
+	voice* ret{};
+	for (auto& v : m_voices) {
+		if (!v.busy || (v.music != nullptr) != streamed || (same_category_only && v.group != request.group)) { continue; }
+		// lowest priority, then oldest
+		if (!ret || v.importance < ret->importance || (v.importance == ret->importance && v.started < ret->started)) { ret = &v; }
+	}
+	if (!ret) { return nullptr; }
+	if (ret->importance > request.importance) { return nullptr; }
+	if (ret->importance == request.importance && now - ret->started < m_config.steal_age) { return nullptr; }
+	release(*ret);
+	++m_stats.stolen;
+	return ret;
+}
+
+auto voice_manager::find_playing(sound_handle const handle) -> voice* {
+	if (!handle) { return nullptr; }
+	for (auto& v : m_voices) {
+		if (v.busy && v.handle == handle) { return &v; }
+	}
+	return nullptr;
+}
+
+auto voice_manager::gain(category const c, float const volume) const -> float {
+	return std::clamp(volume * m_category_volumes[static_cast<std::size_t>(c)] * m_master_volume, 0.0f, 1.0f) * 100.0f;
+}
+
+auto voice_manager::start(voice& v, pending const& p, clock_type::time_point const now) -> bool {
+	auto const& request = p.request;
+	auto const& entry = m_sounds[request.sound];
+	if (v.music) {
+		if (!v.music->openFromFile(entry.stream)) {
+			CARISE_LOG_WARN("audio: failed to open stream {}", entry.stream.string());
+			return false;
+		}
+	} else {
+		v.buffer = entry.buffer;
+		v.sound.setBuffer(*v.buffer);
+	}
+	auto& src = source(v);
+	src.setVolume(gain(request.group, request.volume));
+	src.setPitch(request.pitch);
+	// distance attenuation is already in the volume; OpenAL only pans
+	src.setRelativeToListener(true);
+	src.setAttenuation(0.0f);
+	src.setPosition(request.spatial ? request.direction : sf::Vector3f{});
+	if (v.music) {
+		v.music->play();
+	} else {
+		v.sound.play();
+	}
+	v.id = request.sound;
+	v.handle = p.handle;
+	v.group = request.group;
+	v.importance = request.importance;
+	v.started = now;
+	v.busy = true;
+	++m_category_active[static_cast<std::size_t>(request.group)];
+	++m_stats.started;
+	return true;
+}
+} // namespace carise::audio
@@ -0,0 +1,185 @@
+#pragma once
+#include <carise/core/metrics.hpp>
+#include <SFML/Audio.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace carise::audio {
+enum class category : std::uint8_t { ui, combat, creatures, ambience, footsteps, count_ };
+
+inline constexpr std::size_t category_count_v{static_cast<std::size_t>(category::count_)};
+
+[[nodiscard]] auto to_string(category c) -> std::string_view;
+
+/// \brief Index of a registered sound buffer.
+using sound_id = std::uint32_t;
+
+inline constexpr sound_id no_sound_v{0xffffffff};
+
+///
+/// \brief Identifies one play() call, to stop or adjust the sound later.
+///
+/// Handles are never reused; one whose sound has ended, or was merged into another request or dropped,
+/// simply controls nothing.
+///
+struct sound_handle {
+	std::uint32_t value{};
+
+	explicit constexpr operator bool() const { return value != 0; }
+	constexpr auto operator==(sound_handle const&) const -> bool = default;
+};
+
+/// \brief Higher priorities steal voices from lower ones.
+using priority = std::uint8_t;
+
+struct play_request {
+	sound_id sound{no_sound_v};
+	category group{category::combat};
+	priority importance{128};
+	/// \brief Linear gain in [0, 1].
+	float volume{1.0f};
+	float pitch{1.0f};
+	/// \brief Pan the sound towards direction (unit vector relative to the listener); otherwise centred.
+	bool spatial{};
+	sf::Vector3f direction{};
+};
+
+///
+/// \brief Plays sound effects on a fixed pool of sf::Sound voices.
+///
+/// Requests are collected during the frame and resolved together in update():
+/// - identical sounds requested in the same frame are merged into one voice (the loudest instance, highest priority),
+/// - requests are served in priority order,
+/// - each category has a concurrency limit,
+/// - when no voice is available the lowest priority (then oldest) voice is stolen, if it ranks below the request.
+///
+/// Sounds are either decoded buffers played on sf::Sound voices, or long files streamed through a smaller
+/// pool of sf::Music voices; both follow the same rules. All voices are allocated up front, so play() and
+/// update() never allocate (opening a stream reads its file header, which may).
+///
+class voice_manager {
+  public:
+	struct config {
+		std::size_t voices{32};
+		/// \brief Streamed (sf::Music) voices, for sounds registered with set_stream().
+		std::size_t streams{4};
+		/// \brief Maximum simultaneous voices per category; 0 means limited only by the pool.
+		std::array<std::size_t, category_count_v> category_limits{4, 12, 10, 6, 4};
+		/// \brief Requests beyond this many distinct sounds per frame are dropped.
+		std::size_t max_requests_per_frame{128};
+		/// \brief Voices of equal priority can be stolen once they have played this long.
+		std::chrono::milliseconds steal_age{120};
+	};
+
+	/// \brief Counts for the last update().
+	struct frame_stats {
+		std::size_t requested{};
+		std::size_t merged{};
+		std::size_t started{};
+		std::size_t stolen{};
+		std::size_t dropped{};
+		std::size_t active{};
+	};
+
+	voice_manager() : voice_manager(config{}) {}
+	explicit voice_manager(config const& cfg);
+
+	voice_manager(voice_manager const&) = delete;
+	voice_manager& operator=(voice_manager const&) = delete;
+
+	///
+	/// \brief Register a buffer (load time only: may allocate).
+	///
+	/// buffer must outlive the manager, or at least every voice playing it.
+	///
+	[[nodiscard]] auto add_sound(sf::SoundBuffer const& buffer) -> sound_id;
+	/// \brief Register a buffer under an id chosen by the caller (may allocate).
+	void set_sound(sound_id id, sf::SoundBuffer const& buffer);
+	/// \brief Register a shared buffer; voices playing it keep it alive after remove_sound().
+	void set_sound(sound_id id, std::shared_ptr<sf::SoundBuffer const> buffer);
+	/// \brief Register a file to be streamed from disk whenever id is played.
+	void set_stream(sound_id id, std::filesystem::path path);
+	/// \brief Forget id; sounds already playing finish normally.
+	void remove_sound(sound_id id);
+
+	///
+	/// \brief Queue a sound for this frame.
+	/// \returns false if the request was invalid or this frame's request list is full
+	///
+	auto play(play_request const& request, sound_handle handle = {}) -> bool;
+
+	/// \brief Start this frame's requests.
+	void update();
+
+	void stop(sound_handle handle);
+	/// \brief Change the linear gain of a playing sound (before category and master volume).
+	void set_volume(sound_handle handle, float volume);
+	void set_pitch(sound_handle handle, float pitch);
+	void stop_all();
+
+	/// \brief Linear gain applied on top of each request's volume; takes effect for sounds started afterwards.
+	void set_category_volume(category c, float volume) { m_category_volumes[static_cast<std::size_t>(c)] = volume; }
+	void set_master_volume(float const volume) { m_master_volume = volume; }
+
+	[[nodiscard]] auto voice_count() const -> std::size_t { return m_voices.size(); }
+	[[nodiscard]] auto last_frame() const -> frame_stats const& { return m_last; }
+
+  private:
+	using clock_type = std::chrono::steady_clock;
+
+	struct pending {
+		play_request request{};
+		sound_handle handle{};
+		std::uint32_t order{};
+		std::uint32_t count{};
+	};
+
+	struct sound_entry {
+		std::shared_ptr<sf::SoundBuffer const> buffer{};
+		std::filesystem::path stream{};
+	};
+
+	struct voice {
+		sf::Sound sound{};
+		/// \brief Set for streamed voices, which play through music instead of sound.
+		std::unique_ptr<sf::Music> music{};
+		std::shared_ptr<sf::SoundBuffer const> buffer{};
+		sound_id id{no_sound_v};
+		sound_handle handle{};
+		category group{};
+		priority importance{};
+		clock_type::time_point started{};
+		bool busy{};
+	};
+
+	[[nodiscard]] static auto source(voice& v) -> sf::SoundSource&;
+	[[nodiscard]] auto is_registered(sound_id id) const -> bool;
+	void refresh_voices();
+	void release(voice& v);
+	[[nodiscard]] auto find_voice(play_request const& request, bool streamed, clock_type::time_point now) -> voice*;
+	[[nodiscard]] auto find_victim(play_request const& request, bool streamed, bool same_category_only, clock_type::time_point now) -> voice*;
+	auto start(voice& v, pending const& p, clock_type::time_point now) -> bool;
+	[[nodiscard]] auto find_playing(sound_handle handle) -> voice*;
+	[[nodiscard]] auto gain(category c, float volume) const -> float;
+
+	config m_config;
+	std::vector<sound_entry> m_sounds{};
+	std::vector<voice> m_voices{};
+	std::vector<pending> m_pending{};
+	std::array<std::size_t, category_count_v> m_category_active{};
+	std::array<float, category_count_v> m_category_volumes{};
+	float m_master_volume{1.0f};
+	frame_stats m_stats{};
+	frame_stats m_last{};
+
+	metrics::counter& m_started_total;
+	metrics::counter& m_stolen_total;
+	metrics::counter& m_dropped_total;
+	metrics::gauge& m_active_voices;
+};
+} // namespace carise::audio
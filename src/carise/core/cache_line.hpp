@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+
+namespace carise {
+/// \brief Assumed destructive interference size.
+///
+/// std::hardware_destructive_interference_size is not ABI stable (GCC warns on use), so pin it.
+inline constexpr std::size_t cache_line_size_v{64};
+
+/// \brief Wraps a value in its own cache line to prevent false sharing with neighbours.
+template <typename Type>
+struct alignas(cache_line_size_v) cache_padded {
+	Type value{};
+};
+} // namespace carise
@@ -0,0 +1,62 @@
+#include <carise/core/job_pool.hpp>
+#include <algorithm>
+
+namespace carise {
+auto job_pool::default_workers() -> std::size_t {
+	auto const hardware = std::size_t{std::thread::hardware_concurrency()};
+	return std::min(hardware > 1 ? hardware - 1 : 0, std::size_t{8});
+}
+
+job_pool::job_pool(std::size_t const workers) {
+	m_workers.reserve(workers);
+	for (std::size_t i = 0; i < workers; ++i) {
+		m_workers.emplace_back([this] { run(); });
+	}
+}
+
+job_pool::~job_pool() {
+	m_stop.store(true, std::memory_order_release);
+	m_generation.fetch_add(1, std::memory_order_release);
+	m_generation.notify_all();
+	for (auto& worker : m_workers) { worker.join(); }
+}
+
+void job_pool::dispatch(invoke_fn const invoke, void const* context, std::size_t const count, std::size_t const grain) {
+	m_invoke = invoke;
+	m_context = context;
+	m_count = count;
+	m_grain = std::max(grain, std::size_t{1});
+	m_next_chunk.store(0, std::memory_order_relaxed);
+	m_pending.store(m_workers.size(), std::memory_order_relaxed);
+	// publishes the loop to the workers
+	m_generation.fetch_add(1, std::memory_order_release);
+	m_generation.notify_all();
+
+	run_chunks();
+	// every worker checks in, even ones that woke too late to take a chunk, so none still reads the loop
+	// when the next dispatch() overwrites it
+	for (auto pending = m_pending.load(std::memory_order_acquire); pending != 0; pending = m_pending.load(std::memory_order_acquire)) {
+		m_pending.wait(pending, std::memory_order_acquire);
+	}
+}
+
+void job_pool::run_chunks() {
+	auto const chunks = (m_count + m_grain - 1) / m_grain;
+	for (auto chunk = m_next_chunk.fetch_add(1, std::memory_order_relaxed); chunk < chunks; chunk = m_next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+		auto const begin = chunk * m_grain;
+		m_invoke(m_context, begin, std::min(begin + m_grain, m_count));
+	}
+}
+
+void job_pool::run() {
+	// generation 0 is the constructor's; a loop may be dispatched before this thread gets to run
+	auto seen = std::uint64_t{};
+	while (true) {
+		m_generation.wait(seen, std::memory_order_acquire);
+		seen = m_generation.load(std::memory_order_acquire);
+		if (m_stop.load(std::memory_order_acquire)) { return; }
+		run_chunks();
+		if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) { m_pending.notify_one(); }
+	}
+}
+} // namespace carise
@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace carise {
+///
+/// \brief Fixed set of worker threads for data-parallel loops (particles, lighting, ...).
+///
+/// parallel_for() splits a range into chunks that the workers and the calling thread take in turn, and
+/// returns once every chunk has run. One loop runs at a time; call it from a single thread (the main
+/// thread). Dispatch neither allocates nor locks. With no workers (single core machines) loops simply run
+/// inline.
+///
+class job_pool {
+  public:
+	/// \brief Hardware threads minus the caller, capped at 8.
+	[[nodiscard]] static auto default_workers() -> std::size_t;
+
+	job_pool() : job_pool(default_workers()) {}
+	explicit job_pool(std::size_t workers);
+	~job_pool();
+
+	job_pool(job_pool const&) = delete;
+	job_pool& operator=(job_pool const&) = delete;
+
+	///
+	/// \brief Call func(begin, end) over [0, count) in chunks of at most grain, in parallel; returns when all are done.
+	///
+	/// func must not throw.
+	///
+	template <typename Func>
+	void parallel_for(std::size_t const count, std::size_t const grain, Func&& func) {
+		if (count == 0) { return; }
+		if (m_workers.empty() || count <= grain) {
+			func(std::size_t{0}, count);
+			return;
+		}
+		auto const invoke = [](void const* context, std::size_t const begin, std::size_t const end) { (*static_cast<std::remove_reference_t<Func> const*>(context))(begin, end); };
+		dispatch(invoke, &func, count, grain);
+	}
+
+	[[nodiscard]] auto worker_count() const -> std::size_t { return m_workers.size(); }
+
+  private:
+	using invoke_fn = void (*)(void const*, std::size_t, std::size_t);
+
+	void dispatch(invoke_fn invoke, void const* context, std::size_t count, std::size_t grain);
+	void run_chunks();
+	void run();
+
+	// written by dispatch() only while every worker is idle
+	invoke_fn m_invoke{};
+	void const* m_context{};
+	std::size_t m_count{};
+	std::size_t m_grain{};
+
+	std::atomic<std::size_t> m_next_chunk{};
+	/// \brief Workers yet to finish the current loop.
+	std::atomic<std::size_t> m_pending{};
+	std::atomic<std::uint64_t> m_generation{};
+	std::atomic<bool> m_stop{};
+	std::vector<std::thread> m_workers{};
+};
+} // namespace carise
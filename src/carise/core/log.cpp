@@ -0,0 +1,273 @@
+#include <carise/core/log.hpp>
+#include <carise/core/spsc_queue.hpp>
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace carise::log {
+namespace {
+struct thread_buffer {
+	explicit thread_buffer(std::size_t const capacity, std::uint16_t const index) : records(capacity), index(index) {}
+
+	spsc_queue<record> records;
+	std::atomic<std::uint64_t> dropped{};
+	std::atomic<bool> retired{};
+	std::uint16_t index{};
+};
+
+/// \brief Outlives any logger: threads and sites register once and stay registered across logger lifetimes.
+struct registry {
+	auto add_thread() -> std::shared_ptr<thread_buffer> {
+		auto lock = std::scoped_lock{mutex};
+		auto ret = std::make_shared<thread_buffer>(thread_capacity, next_thread++);
+		buffers.push_back(ret);
+		return ret;
+	}
+
+	std::mutex mutex{};
+	std::vector<std::shared_ptr<thread_buffer>> buffers{};
+	std::vector<site> sites{};
+	std::size_t thread_capacity{4096};
+	std::uint16_t next_thread{};
+};
+
+auto get_registry() -> registry& {
+	static auto ret = registry{};
+	return ret;
+}
+
+/// \brief Marks the thread's buffer retired on thread exit so the writer can release it once drained.
+struct thread_handle {
+	thread_handle() = default;
+	thread_handle(thread_handle const&) = delete;
+	thread_handle& operator=(thread_handle const&) = delete;
+	~thread_handle() {
+		if (buffer) { buffer->retired.store(true, std::memory_order_release); }
+	}
+
+	std::shared_ptr<thread_buffer> buffer{};
+};
+
+thread_local auto t_handle = thread_handle{};
+// trivially destructible copy of t_handle.buffer: plain TLS access without the init/destructor wrapper on the hot path
+thread_local thread_buffer* t_buffer{};
+
+struct file_deleter {
+	void operator()(std::FILE* file) const { std::fclose(file); }
+};
+using file_ptr = std::unique_ptr<std::FILE, file_deleter>;
+
+auto open_file(std::filesystem::path const& path) -> file_ptr {
+	if (path.empty()) { return {}; }
+	auto ret = file_ptr{std::fopen(path.string().c_str(), "wb")};
+	if (!ret) { std::fprintf(stderr, "[carise] failed to open log file: %s\n", path.string().c_str()); }
+	return ret;
+}
+
+template <typename Type>
+void append(std::vector<std::byte>& out, Type const& value) {
+	auto const* bytes = reinterpret_cast<std::byte const*>(&value);
+	out.insert(out.end(), bytes, bytes + sizeof(Type));
+}
+
+void append(std::vector<std::byte>& out, std::string_view const str) {
+	append(out, static_cast<std::uint16_t>(std::min(str.size(), std::size_t{0xffff})));
+	auto const* bytes = reinterpret_cast<std::byte const*>(str.data());
+	out.insert(out.end(), bytes, bytes + std::min(str.size(), std::size_t{0xffff}));
+}
+
+auto now_ns() -> std::int64_t { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+} // namespace
+
+struct logger::impl {
+	explicit impl(config cfg) : cfg(std::move(cfg)) {}
+
+	void run() {
+		auto lock = std::unique_lock{mutex};
+		while (!stop) {
+			lock.unlock();
+			pump();
+			lock.lock();
+			cv.wait_for(lock, cfg.flush_interval, [this] { return stop; });
+		}
+		lock.unlock();
+		pump();
+	}
+
+	void pump() {
+		calibrate();
+		auto& reg = get_registry();
+		{
+			auto lock = std::scoped_lock{reg.mutex};
+			buffers = reg.buffers;
+		}
+		for (auto const& buffer : buffers) {
+			// read retired before draining: anything pushed before retirement is then guaranteed to be drained
+			auto const retired = buffer->retired.load(std::memory_order_acquire);
+			buffer->records.drain([this](record&& rec) { pending.push_back(rec); });
+			if (auto const count = buffer->dropped.exchange(0, std::memory_order_relaxed); count > 0) { write_dropped(buffer->index, count); }
+			if (retired) { release(buffer); }
+		}
+		buffers.clear();
+
+		std::stable_sort(pending.begin(), pending.end(), [](record const& a, record const& b) { return a.timestamp < b.timestamp; });
+		for (auto const& rec : pending) { write_entry(rec); }
+		pending.clear();
+		flush();
+	}
+
+	void release(std::shared_ptr<thread_buffer> const& buffer) {
+		auto& reg = get_registry();
+		auto lock = std::scoped_lock{reg.mutex};
+		std::erase(reg.buffers, buffer);
+	}
+
+	auto get_site(std::uint32_t const id) -> site const& {
+		if (id >= sites.size()) {
+			auto& reg = get_registry();
+			auto lock = std::scoped_lock{reg.mutex};
+			sites = reg.sites;
+			sites_written.resize(sites.size());
+		}
+		assert(id < sites.size());
+		auto const& ret = sites[id];
+		if (!sites_written[id]) {
+			append(out, file::chunk_type::site);
+			append(out, ret.id);
+			append(out, ret.lvl);
+			append(out, ret.line);
+			append(out, ret.file);
+			append(out, ret.format);
+			sites_written[id] = true;
+		}
+		return ret;
+	}
+
+	void write_entry(record const& rec) {
+		auto const& site = get_site(rec.site);
+		auto const timestamp = static_cast<std::int64_t>(static_cast<double>(rec.timestamp - start_ticks) * ns_per_tick);
+		auto const payload = std::span{rec.payload}.first(rec.size);
+		append(out, file::chunk_type::entry);
+		append(out, rec.site);
+		append(out, rec.thread);
+		append(out, timestamp);
+		append(out, rec.size);
+		out.insert(out.end(), payload.begin(), payload.end());
+
+		auto const to_console = site.lvl >= cfg.console_level;
+		if (!text && !to_console) { return; }
+		line.clear();
+		format_line(line, site, timestamp, rec.thread, payload);
+		if (text) { std::fwrite(line.data(), 1, line.size(), text.get()); }
+		if (to_console) { std::fwrite(line.data(), 1, line.size(), stderr); }
+	}
+
+	void write_dropped(std::uint16_t const thread, std::uint64_t const count) {
+		append(out, file::chunk_type::dropped);
+		append(out, thread);
+		append(out, count);
+		total_dropped.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	/// \brief Measure the tick rate over everything since start, so the estimate sharpens as the run goes on.
+	void calibrate() {
+		auto const ticks = detail::read_ticks() - start_ticks;
+		auto const ns = now_ns() - start;
+		if (ticks > 0 && ns > 0) { ns_per_tick = static_cast<double>(ns) / static_cast<double>(ticks); }
+	}
+
+	void flush() {
+		if (binary && !out.empty()) {
+			std::fwrite(out.data(), 1, out.size(), binary.get());
+			std::fflush(binary.get());
+		}
+		out.clear();
+		if (text) { std::fflush(text.get()); }
+	}
+
+	config cfg;
+	file_ptr binary{};
+	file_ptr text{};
+	std::int64_t start{};
+	std::int64_t start_ticks{};
+	double ns_per_tick{1.0};
+
+	// writer thread state
+	std::vector<std::shared_ptr<thread_buffer>> buffers{};
+	std::vector<site> sites{};
+	std::vector<bool> sites_written{};
+	std::vector<record> pending{};
+	std::vector<std::byte> out{};
+	std::string line{};
+
+	std::atomic<std::uint64_t> total_dropped{};
+	std::mutex mutex{};
+	std::condition_variable cv{};
+	bool stop{};
+	std::thread thread{};
+};
+
+logger::logger(config cfg) : m_impl(std::make_unique<impl>(std::move(cfg))) {
+	assert(detail::g_min_level.load() > static_cast<int>(level::error) && "only one logger may be active");
+	{
+		auto& reg = get_registry();
+		auto lock = std::scoped_lock{reg.mutex};
+		reg.thread_capacity = m_impl->cfg.thread_capacity;
+	}
+	m_impl->binary = open_file(m_impl->cfg.binary_path);
+	m_impl->text = open_file(m_impl->cfg.text_path);
+	m_impl->start = now_ns();
+	m_impl->start_ticks = detail::read_ticks();
+	// a first estimate of the tick rate for records captured before the writer's first pass
+	std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	m_impl->calibrate();
+	append(m_impl->out, file::magic_v);
+	append(m_impl->out, file::version_v);
+	append(m_impl->out, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+	m_impl->flush();
+	m_impl->thread = std::thread{[impl = m_impl.get()] { impl->run(); }};
+	detail::g_min_level.store(static_cast<int>(m_impl->cfg.min_level), std::memory_order_relaxed);
+}
+
+logger::~logger() {
+	detail::g_min_level.store(static_cast<int>(level::error) + 1, std::memory_order_relaxed);
+	{
+		auto lock = std::scoped_lock{m_impl->mutex};
+		m_impl->stop = true;
+	}
+	m_impl->cv.notify_one();
+	m_impl->thread.join();
+}
+
+auto logger::dropped() const -> std::uint64_t { return m_impl->total_dropped.load(std::memory_order_relaxed); }
+
+auto register_site(level const lvl, std::string_view const format, std::string_view const file, int const line) -> std::uint32_t {
+	auto& reg = get_registry();
+	auto lock = std::scoped_lock{reg.mutex};
+	auto const id = static_cast<std::uint32_t>(reg.sites.size());
+	reg.sites.push_back(site{.id = id, .lvl = lvl, .line = static_cast<std::uint32_t>(line), .file = file, .format = format});
+	return id;
+}
+
+auto detail::claim() -> record* {
+	auto* buffer = t_buffer;
+	if (!buffer) [[unlikely]] {
+		t_handle.buffer = get_registry().add_thread();
+		buffer = t_buffer = t_handle.buffer.get();
+	}
+	auto* ret = buffer->records.try_claim();
+	if (!ret) {
+		buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+	ret->thread = buffer->index;
+	return ret;
+}
+
+void detail::commit() { t_buffer->records.commit(); }
+} // namespace carise::log
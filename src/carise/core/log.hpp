@@ -0,0 +1,216 @@
+#pragma once
+#include <carise/core/log_format.hpp>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CARISE_LOG_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define CARISE_LOG_TSC 1
+#else
+#define CARISE_LOG_TSC 0
+#endif
+
+///
+/// \brief Lowest level compiled in (0 = trace ... 4 = error); calls below it compile to nothing.
+///
+/// Set through the CARISE_LOG_LEVEL CMake cache variable.
+///
+#if !defined(CARISE_LOG_LEVEL)
+#if defined(NDEBUG)
+#define CARISE_LOG_LEVEL 2
+#else
+#define CARISE_LOG_LEVEL 1
+#endif
+#endif
+
+namespace carise::log {
+[[nodiscard]] constexpr auto compiled_in(level const lvl) -> bool { return static_cast<int>(lvl) >= CARISE_LOG_LEVEL; }
+
+///
+/// \brief Owns the background writer thread; records are only captured while an instance is alive.
+///
+/// The writer periodically drains every thread's ring buffer, writes binary records to binary_path
+/// (decode with carise-logdecode), and optionally formats them to text_path and to stderr.
+///
+class logger {
+  public:
+	struct config {
+		std::filesystem::path binary_path{"carise.clog"};
+		/// \brief Formatted text copy; empty to disable.
+		std::filesystem::path text_path{};
+		level min_level{level::trace};
+		/// \brief Records at or above this level are also formatted to stderr.
+		level console_level{level::warn};
+		std::chrono::milliseconds flush_interval{20};
+		/// \brief Ring buffer size (in records) allocated for each logging thread.
+		std::size_t thread_capacity{4096};
+	};
+
+	explicit logger(config cfg);
+	logger() : logger(config{}) {}
+	~logger();
+
+	logger(logger const&) = delete;
+	logger& operator=(logger const&) = delete;
+
+	/// \brief Records dropped across all threads because their ring buffer was full.
+	[[nodiscard]] auto dropped() const -> std::uint64_t;
+
+  private:
+	struct impl;
+	std::unique_ptr<impl> m_impl;
+};
+
+/// \brief Register a call site (once per site, from the logging macros).
+[[nodiscard]] auto register_site(level lvl, std::string_view format, std::string_view file, int line) -> std::uint32_t;
+
+namespace detail {
+inline std::atomic<int> g_min_level{static_cast<int>(level::error) + 1};
+
+[[nodiscard]] inline auto is_enabled(level const lvl) -> bool { return static_cast<int>(lvl) >= g_min_level.load(std::memory_order_relaxed); }
+
+///
+/// \brief Timestamp for a record: the time stamp counter where there is one, else steady_clock nanoseconds.
+///
+/// Reading the counter costs a fraction of steady_clock::now(); the writer converts ticks to nanoseconds
+/// against steady_clock. Assumes an invariant counter, synchronised across cores (any x86 of the last decade).
+///
+[[nodiscard]] inline auto read_ticks() -> std::int64_t {
+#if CARISE_LOG_TSC
+	return static_cast<std::int64_t>(__rdtsc());
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+consteval auto count_placeholders(std::string_view const format) -> std::size_t {
+	std::size_t ret{};
+	for (std::size_t i = 0; i < format.size(); ++i) {
+		if (format[i] == '{') {
+			if (i + 1 < format.size() && format[i + 1] == '{') {
+				++i;
+				continue;
+			}
+			++ret;
+		}
+	}
+	return ret;
+}
+
+template <typename Type>
+concept loggable = std::same_as<Type, bool> || std::same_as<Type, char> || std::is_arithmetic_v<Type> || std::is_enum_v<Type> ||
+				   std::is_pointer_v<Type> || std::convertible_to<Type const&, std::string_view>;
+
+class payload_writer {
+  public:
+	explicit payload_writer(record& out) : m_out(out) {}
+
+	template <loggable Type>
+	void write(Type const& value) {
+		if constexpr (std::same_as<Type, bool>) {
+			put(arg_type::boolean, static_cast<std::uint8_t>(value));
+		} else if constexpr (std::same_as<Type, char>) {
+			put(arg_type::character, value);
+		} else if constexpr (std::is_enum_v<Type>) {
+			write(static_cast<std::underlying_type_t<Type>>(value));
+		} else if constexpr (std::floating_point<Type>) {
+			put(arg_type::f64, static_cast<double>(value));
+		} else if constexpr (std::signed_integral<Type>) {
+			put(arg_type::i64, static_cast<std::int64_t>(value));
+		} else if constexpr (std::unsigned_integral<Type>) {
+			put(arg_type::u64, static_cast<std::uint64_t>(value));
+		} else if constexpr (std::convertible_to<Type const&, std::string_view>) {
+			put_string(std::string_view{value});
+		} else {
+			put(arg_type::pointer, static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value)));
+		}
+	}
+
+  private:
+	template <typename Type>
+	void put(arg_type const type, Type const value) {
+		if (!reserve(sizeof(arg_type) + sizeof(Type))) { return; }
+		copy(type);
+		copy(value);
+	}
+
+	void put_string(std::string_view str) {
+		if (!reserve(sizeof(arg_type) + sizeof(std::uint16_t) + 1)) { return; }
+		copy(arg_type::string);
+		auto const room = m_out.payload.size() - m_out.size - sizeof(std::uint16_t);
+		if (str.size() > room) { str = str.substr(0, room); }
+		copy(static_cast<std::uint16_t>(str.size()));
+		std::memcpy(m_out.payload.data() + m_out.size, str.data(), str.size());
+		m_out.size = static_cast<std::uint16_t>(m_out.size + str.size());
+	}
+
+	auto reserve(std::size_t const bytes) -> bool {
+		if (m_truncated) { return false; }
+		if (m_out.size + bytes <= m_out.payload.size()) { return true; }
+		if (m_out.size < m_out.payload.size()) { copy(arg_type::truncated); }
+		m_truncated = true;
+		return false;
+	}
+
+	template <typename Type>
+	void copy(Type const value) {
+		std::memcpy(m_out.payload.data() + m_out.size, &value, sizeof(Type));
+		m_out.size = static_cast<std::uint16_t>(m_out.size + sizeof(Type));
+	}
+
+	record& m_out;
+	bool m_truncated{};
+};
+
+///
+/// \brief The next record of the calling thread's ring buffer, stamped with the thread, to fill and then commit().
+/// \returns null (counting a drop) if the buffer is full
+///
+[[nodiscard]] auto claim() -> record*;
+/// \brief Publish the record from the last claim() to the writer.
+void commit();
+
+template <std::size_t Placeholders, loggable... Args>
+void emit(std::uint32_t const site, Args const&... args) {
+	static_assert(Placeholders == sizeof...(Args), "log format placeholder count does not match argument count");
+	// written straight into the ring: the payload is never zeroed or copied
+	auto* rec = claim();
+	if (!rec) { return; }
+	rec->timestamp = read_ticks();
+	rec->site = site;
+	[[maybe_unused]] auto writer = payload_writer{*rec};
+	(writer.write(args), ...);
+	commit();
+}
+} // namespace detail
+} // namespace carise::log
+
+///
+/// \brief Log a message with {} placeholders at lvl.
+///
+/// Only the call site id and the raw arguments are captured; formatting happens on the writer thread.
+///
+#define CARISE_LOG(lvl, format, ...)                                                                                                                       \
+	do {                                                                                                                                                   \
+		if constexpr (::carise::log::compiled_in(lvl)) {                                                                                                   \
+			if (::carise::log::detail::is_enabled(lvl)) {                                                                                                  \
+				static auto const carise_log_site_ = ::carise::log::register_site(lvl, format, __FILE__, __LINE__);                                          \
+				::carise::log::detail::emit<::carise::log::detail::count_placeholders(format)>(carise_log_site_ __VA_OPT__(, ) __VA_ARGS__);                \
+			}                                                                                                                                              \
+		}                                                                                                                                                  \
+	} while (false)
+
+#define CARISE_LOG_TRACE(...) CARISE_LOG(::carise::log::level::trace, __VA_ARGS__)
+#define CARISE_LOG_DEBUG(...) CARISE_LOG(::carise::log::level::debug, __VA_ARGS__)
+#define CARISE_LOG_INFO(...) CARISE_LOG(::carise::log::level::info, __VA_ARGS__)
+#define CARISE_LOG_WARN(...) CARISE_LOG(::carise::log::level::warn, __VA_ARGS__)
+#define CARISE_LOG_ERROR(...) CARISE_LOG(::carise::log::level::error, __VA_ARGS__)
@@ -0,0 +1,158 @@
+#include <carise/core/log_format.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+
+namespace carise::log {
+namespace {
+template <typename Type>
+auto read(std::span<std::byte const>& bytes, Type& out) -> bool {
+	if (bytes.size() < sizeof(Type)) { return false; }
+	std::memcpy(&out, bytes.data(), sizeof(Type));
+	bytes = bytes.subspan(sizeof(Type));
+	return true;
+}
+
+template <typename Type>
+void append_number(std::string& out, Type const value, std::optional<int> const precision = {}) {
+	char buffer[64];
+	auto result = std::to_chars_result{};
+	if constexpr (std::is_floating_point_v<Type>) {
+		result = precision ? std::to_chars(std::begin(buffer), std::end(buffer), value, std::chars_format::fixed, *precision)
+						   : std::to_chars(std::begin(buffer), std::end(buffer), value);
+	} else {
+		result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+	}
+	out.append(buffer, result.ptr);
+}
+
+/// \returns false once the payload is exhausted or truncated
+auto append_arg(std::string& out, std::span<std::byte const>& payload, std::optional<int> const precision) -> bool {
+	auto type = arg_type{};
+	if (!read(payload, type)) { return false; }
+	switch (type) {
+	case arg_type::i64: {
+		auto value = std::int64_t{};
+		if (!read(payload, value)) { return false; }
+		append_number(out, value);
+		return true;
+	}
+	case arg_type::u64: {
+		auto value = std::uint64_t{};
+		if (!read(payload, value)) { return false; }
+		append_number(out, value);
+		return true;
+	}
+	case arg_type::f64: {
+		auto value = double{};
+		if (!read(payload, value)) { return false; }
+		append_number(out, value, precision);
+		return true;
+	}
+	case arg_type::boolean: {
+		auto value = std::uint8_t{};
+		if (!read(payload, value)) { return false; }
+		out += value ? "true" : "false";
+		return true;
+	}
+	case arg_type::character: {
+		auto value = char{};
+		if (!read(payload, value)) { return false; }
+		out += value;
+		return true;
+	}
+	case arg_type::string: {
+		auto length = std::uint16_t{};
+		if (!read(payload, length) || payload.size() < length) { return false; }
+		out.append(reinterpret_cast<char const*>(payload.data()), length);
+		payload = payload.subspan(length);
+		return true;
+	}
+	case arg_type::pointer: {
+		auto value = std::uint64_t{};
+		if (!read(payload, value)) { return false; }
+		char buffer[32];
+		auto const result = std::to_chars(std::begin(buffer), std::end(buffer), value, 16);
+		out += "0x";
+		out.append(buffer, result.ptr);
+		return true;
+	}
+	default: return false;
+	}
+}
+
+auto parse_precision(std::string_view const spec) -> std::optional<int> {
+	auto const dot = spec.find('.');
+	if (dot == std::string_view::npos) { return {}; }
+	auto ret = int{};
+	auto const digits = spec.substr(dot + 1);
+	auto const [_, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), ret);
+	if (ec != std::errc{}) { return {}; }
+	return ret;
+}
+} // namespace
+
+auto to_string(level const lvl) -> std::string_view {
+	switch (lvl) {
+	case level::trace: return "trace";
+	case level::debug: return "debug";
+	case level::info: return "info";
+	case level::warn: return "warn";
+	case level::error: return "error";
+	default: return "?";
+	}
+}
+
+void format_message(std::string& out, std::string_view format, std::span<std::byte const> payload) {
+	auto exhausted = false;
+	while (!format.empty()) {
+		auto const brace = format.find_first_of("{}");
+		out += format.substr(0, brace);
+		if (brace == std::string_view::npos) { break; }
+		format = format.substr(brace);
+		if (format.size() > 1 && format[0] == format[1]) {
+			out += format[0];
+			format = format.substr(2);
+			continue;
+		}
+		if (format[0] == '}') {
+			out += '}';
+			format = format.substr(1);
+			continue;
+		}
+		auto const close = format.find('}');
+		if (close == std::string_view::npos) {
+			out += format;
+			break;
+		}
+		auto const spec = format.substr(1, close - 1);
+		format = format.substr(close + 1);
+		if (exhausted || !append_arg(out, payload, parse_precision(spec))) {
+			exhausted = true;
+			out += "{?}";
+		}
+	}
+}
+
+void format_line(std::string& out, site const& site, std::int64_t const timestamp_ns, std::uint16_t const thread, std::span<std::byte const> payload) {
+	char buffer[64];
+	auto const seconds = static_cast<double>(timestamp_ns) / 1e9;
+	auto const result = std::to_chars(std::begin(buffer), std::end(buffer), seconds, std::chars_format::fixed, 6);
+	auto const stamp = std::string_view{buffer, result.ptr};
+	out += '[';
+	if (stamp.size() < 12) { out.append(12 - stamp.size(), ' '); }
+	out += stamp;
+	out += "] [";
+	auto const lvl = to_string(site.lvl);
+	out += lvl;
+	out.append(5 - std::min(lvl.size(), std::size_t{5}), ' ');
+	out += "] [t";
+	append_number(out, thread);
+	out += "] ";
+	format_message(out, site.format, payload);
+	out += '\n';
+}
+} // namespace carise::log
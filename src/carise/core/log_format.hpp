@@ -0,0 +1,67 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace carise::log {
+enum class level : std::uint8_t { trace, debug, info, warn, error };
+
+[[nodiscard]] auto to_string(level lvl) -> std::string_view;
+
+/// \brief Tag preceding each encoded argument in a record payload.
+enum class arg_type : std::uint8_t { i64, u64, f64, boolean, character, string, pointer, truncated };
+
+/// \brief Static data of one log call site; the format string is only ever stored once, records carry its id.
+struct site {
+	std::uint32_t id{};
+	level lvl{};
+	std::uint32_t line{};
+	std::string_view file{};
+	std::string_view format{};
+};
+
+///
+/// \brief Fixed-size record written by the hot path into its thread's ring buffer.
+///
+/// Two cache lines; arguments that don't fit in payload are cut off and marked arg_type::truncated.
+///
+struct record {
+	/// \brief detail::read_ticks() at capture; the writer converts it to nanoseconds.
+	std::int64_t timestamp{};
+	std::uint32_t site{};
+	std::uint16_t size{};
+	std::uint16_t thread{};
+	// left uninitialized: only the first size bytes are ever read
+	std::array<std::byte, 112> payload;
+};
+static_assert(sizeof(record) == 128);
+
+///
+/// \brief Substitute each {} in format with the next encoded argument from payload.
+///
+/// {{ and }} are escapes; a spec like {:.3} sets float precision, other specs are ignored.
+///
+void format_message(std::string& out, std::string_view format, std::span<std::byte const> payload);
+
+/// \brief Append "[  seconds] [level] [tN] message" to out.
+void format_line(std::string& out, site const& site, std::int64_t timestamp_ns, std::uint16_t thread, std::span<std::byte const> payload);
+
+///
+/// \brief Binary log file layout (native endianness).
+///
+/// header: magic, u32 version, i64 start time (system_clock ns since epoch)
+/// then a stream of chunks, each starting with a chunk_type byte:
+///   site:    u32 id, u8 level, u32 line, u16 length + file, u16 length + format
+///   entry:   u32 site, u16 thread, i64 timestamp ns since start, u16 size + payload
+///   dropped: u16 thread, u64 records dropped since the previous dropped chunk
+///
+namespace file {
+inline constexpr std::array<char, 4> magic_v{'C', 'L', 'O', 'G'};
+inline constexpr std::uint32_t version_v{1};
+
+enum class chunk_type : std::uint8_t { site = 1, entry, dropped };
+} // namespace file
+} // namespace carise::log
@@ -0,0 +1,12 @@
+#include <carise/core/main_thread_queue.hpp>
+
+namespace carise {
+void main_thread_queue::post(callback func) {
+	if (!func) { return; }
+	m_queue.push(std::move(func));
+}
+
+auto main_thread_queue::run_pending(std::size_t const max) -> std::size_t {
+	return m_queue.drain([](callback&& func) { func(); }, max);
+}
+} // namespace carise
@@ -0,0 +1,26 @@
+#pragma once
+#include <carise/core/mpsc_queue.hpp>
+#include <functional>
+
+namespace carise {
+///
+/// \brief Callbacks posted from any thread, run on the main thread once per frame.
+///
+class main_thread_queue {
+  public:
+	using callback = std::function<void()>;
+
+	/// \brief Enqueue func to run on the next run_pending() (any thread).
+	void post(callback func);
+
+	///
+	/// \brief Run up to max pending callbacks (main thread only).
+	///
+	/// Bounding max keeps a burst of posts from blowing a single frame's budget; the rest run next frame.
+	///
+	auto run_pending(std::size_t max = 256) -> std::size_t;
+
+  private:
+	unbounded_mpsc_queue<callback> m_queue{};
+};
+} // namespace carise
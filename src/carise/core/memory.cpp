@@ -0,0 +1,219 @@
+#include <carise/core/cache_line.hpp>
+#include <carise/core/log.hpp>
+#include <carise/core/memory.hpp>
+#include <carise/core/metrics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <iterator>
+
+namespace carise::memory {
+namespace {
+struct counters {
+	std::atomic<std::int64_t> live{};
+	std::atomic<std::int64_t> peak{};
+	std::atomic<std::uint64_t> allocations{};
+	std::atomic<std::uint64_t> bytes_allocated{};
+	std::atomic<std::size_t> budget{};
+};
+
+// constant initialized: operator new may run before any dynamic initialization
+constinit std::array<cache_padded<counters>, tag_count_v> g_counters{};
+constinit thread_local tag t_current{tag::general};
+
+auto get(tag const t) -> counters& { return g_counters[static_cast<std::size_t>(t)].value; }
+
+void append_bytes(std::string& out, std::size_t const bytes) {
+	char buffer[32];
+	auto const mib = static_cast<double>(bytes) / (1024.0 * 1024.0);
+	auto const result = std::to_chars(std::begin(buffer), std::end(buffer), mib, std::chars_format::fixed, 2);
+	out.append(buffer, result.ptr).append(" MiB");
+}
+
+void append_padded(std::string& out, std::string_view const str, std::size_t const width) {
+	out += str;
+	if (str.size() < width) { out.append(width - str.size(), ' '); }
+}
+} // namespace
+
+auto to_string(tag const t) -> std::string_view {
+	switch (t) {
+	case tag::general: return "general";
+	case tag::map: return "map";
+	case tag::entities: return "entities";
+	case tag::textures: return "textures";
+	case tag::audio: return "audio";
+	case tag::ui: return "ui";
+	case tag::render: return "render";
+	default: return "?";
+	}
+}
+
+void on_alloc(tag const t, std::size_t const bytes) {
+	auto& c = get(t);
+	auto const live = c.live.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed) + static_cast<std::int64_t>(bytes);
+	auto peak = c.peak.load(std::memory_order_relaxed);
+	while (live > peak && !c.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+	c.allocations.fetch_add(1, std::memory_order_relaxed);
+	c.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void on_free(tag const t, std::size_t const bytes) { get(t).live.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed); }
+
+auto live_bytes(tag const t) -> std::size_t { return static_cast<std::size_t>(std::max(get(t).live.load(std::memory_order_relaxed), std::int64_t{0})); }
+
+auto peak_bytes(tag const t) -> std::size_t { return static_cast<std::size_t>(std::max(get(t).peak.load(std::memory_order_relaxed), std::int64_t{0})); }
+
+auto current_tag() -> tag { return t_current; }
+
+scope::scope(tag const t) : m_previous(std::exchange(t_current, t)) {}
+
+scope::~scope() { t_current = m_previous; }
+
+void tracker::set_budget(tag const t, std::size_t const bytes) { get(t).budget.store(bytes, std::memory_order_relaxed); }
+
+auto tracker::budget(tag const t) const -> std::size_t { return get(t).budget.load(std::memory_order_relaxed); }
+
+auto tracker::load_budgets(std::string_view text) -> std::size_t {
+	auto const trim = [](std::string_view str) {
+		while (!str.empty() && (str.front() == ' ' || str.front() == '\t')) { str.remove_prefix(1); }
+		while (!str.empty() && (str.back() == ' ' || str.back() == '\t' || str.back() == '\r')) { str.remove_suffix(1); }
+		return str;
+	};
+	std::size_t ret{};
+	while (!text.empty()) {
+		auto const eol = text.find('\n');
+		auto line = text.substr(0, eol);
+		text = eol == std::string_view::npos ? std::string_view{} : text.substr(eol + 1);
+		line = line.substr(0, line.find('#'));
+		auto const eq = line.find('=');
+		if (eq == std::string_view::npos) { continue; }
+		auto const key = trim(line.substr(0, eq));
+		auto const value = trim(line.substr(eq + 1));
+		auto mib = double{};
+		if (std::from_chars(value.data(), value.data() + value.size(), mib).ec != std::errc{}) {
+			CARISE_LOG_WARN("invalid memory budget for {}: {}", key, value);
+			continue;
+		}
+		auto matched = false;
+		for (std::size_t i = 0; i < tag_count_v; ++i) {
+			if (to_string(static_cast<tag>(i)) != key) { continue; }
+			set_budget(static_cast<tag>(i), static_cast<std::size_t>(mib * 1024.0 * 1024.0));
+			matched = true;
+			++ret;
+		}
+		if (!matched) { CARISE_LOG_WARN("unknown memory tag in budgets: {}", key); }
+	}
+	return ret;
+}
+
+auto tracker::add_evictor(tag const t, evictor func) -> evictor_id {
+	auto lock = std::scoped_lock{m_mutex};
+	auto const ret = ++m_next_id;
+	m_evictors.push_back(evictor_entry{.id = ret, .t = t, .func = std::move(func)});
+	return ret;
+}
+
+void tracker::remove_evictor(evictor_id const id) {
+	auto lock = std::scoped_lock{m_mutex};
+	std::erase_if(m_evictors, [id](evictor_entry const& e) { return e.id == id; });
+}
+
+auto tracker::enforce_budgets() -> std::size_t {
+	std::size_t ret{};
+	auto ids = std::vector<evictor_id>{};
+	for (std::size_t i = 0; i < tag_count_v; ++i) {
+		auto const t = static_cast<tag>(i);
+		auto const limit = budget(t);
+		if (limit == 0 || live_bytes(t) <= limit) { continue; }
+		ids.clear();
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			for (auto const& entry : m_evictors) {
+				if (entry.t == t) { ids.push_back(entry.id); }
+			}
+		}
+		// evictors run unlocked: one may destroy a cache, which removes its own (or another) evictor
+		for (auto const id : ids) {
+			auto const live = live_bytes(t);
+			if (live <= limit) { break; }
+			auto func = evictor{};
+			{
+				auto lock = std::scoped_lock{m_mutex};
+				auto const it = std::find_if(m_evictors.begin(), m_evictors.end(), [id](evictor_entry const& e) { return e.id == id; });
+				if (it == m_evictors.end()) { continue; }
+				func = it->func;
+			}
+			ret += func(live - limit);
+		}
+		if (live_bytes(t) > limit) { CARISE_LOG_DEBUG("memory tag {} still over budget after eviction: {} > {}", to_string(t), live_bytes(t), limit); }
+	}
+	return ret;
+}
+
+void tracker::sample(std::span<stats, tag_count_v> out) {
+	auto const now = std::chrono::steady_clock::now();
+	auto const elapsed = std::max(std::chrono::duration<double>(now - m_prev_sample).count(), 1e-6);
+	m_prev_sample = now;
+	for (std::size_t i = 0; i < tag_count_v; ++i) {
+		auto const t = static_cast<tag>(i);
+		auto const& c = get(t);
+		auto& s = out[i];
+		s.t = t;
+		s.live = live_bytes(t);
+		s.peak = peak_bytes(t);
+		s.budget = budget(t);
+		s.allocations = c.allocations.load(std::memory_order_relaxed);
+		s.bytes_allocated = c.bytes_allocated.load(std::memory_order_relaxed);
+		s.allocation_rate = static_cast<double>(s.allocations - std::exchange(m_prev_allocations[i], s.allocations)) / elapsed;
+		s.byte_rate = static_cast<double>(s.bytes_allocated - std::exchange(m_prev_bytes[i], s.bytes_allocated)) / elapsed;
+	}
+}
+
+void tracker::publish(metrics::registry& registry) const {
+	auto name = std::string{};
+	for (std::size_t i = 0; i < tag_count_v; ++i) {
+		auto const t = static_cast<tag>(i);
+		name.assign("carise_memory_live_bytes_").append(to_string(t));
+		registry.get_gauge(name, "Live bytes attributed to a subsystem").set(static_cast<double>(live_bytes(t)));
+		name.assign("carise_memory_peak_bytes_").append(to_string(t));
+		registry.get_gauge(name, "Peak live bytes attributed to a subsystem").set(static_cast<double>(peak_bytes(t)));
+	}
+}
+
+void tracker::write_report(std::string& out) {
+	auto samples = std::array<stats, tag_count_v>{};
+	sample(samples);
+	write_report(out, samples);
+}
+
+void tracker::write_report(std::string& out, std::span<stats const, tag_count_v> const samples) {
+	out += "tag       live          peak          budget        allocs/s\n";
+	auto field = std::string{};
+	for (auto const& s : samples) {
+		append_padded(out, to_string(s.t), 10);
+		field.clear();
+		append_bytes(field, s.live);
+		append_padded(out, field, 14);
+		field.clear();
+		append_bytes(field, s.peak);
+		append_padded(out, field, 14);
+		field.clear();
+		if (s.budget > 0) {
+			append_bytes(field, s.budget);
+		} else {
+			field += '-';
+		}
+		append_padded(out, field, 14);
+		char buffer[32];
+		auto const result = std::to_chars(std::begin(buffer), std::end(buffer), s.allocation_rate, std::chars_format::fixed, 0);
+		out.append(buffer, result.ptr);
+		out += '\n';
+	}
+}
+
+auto global() -> tracker& {
+	static auto ret = tracker{};
+	return ret;
+}
+} // namespace carise::memory
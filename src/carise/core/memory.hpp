@@ -0,0 +1,208 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+///
+/// \brief Whether global operator new / delete are replaced to attribute every allocation to a tag.
+///
+/// Set through the CARISE_TRACK_ALLOCATIONS CMake option. When off, only tagged allocators and explicit
+/// tracked_bytes (GPU textures, decoded audio, ...) are accounted.
+///
+#if !defined(CARISE_TRACK_ALLOCATIONS)
+#define CARISE_TRACK_ALLOCATIONS 0
+#endif
+
+namespace carise::metrics {
+class registry;
+}
+
+namespace carise::memory {
+enum class tag : std::uint8_t { general, map, entities, textures, audio, ui, render, count_ };
+
+inline constexpr std::size_t tag_count_v{static_cast<std::size_t>(tag::count_)};
+
+[[nodiscard]] auto to_string(tag t) -> std::string_view;
+
+/// \brief Account bytes allocated for t (any thread, never allocates).
+void on_alloc(tag t, std::size_t bytes);
+/// \brief Account bytes released from t (any thread, never allocates).
+void on_free(tag t, std::size_t bytes);
+
+[[nodiscard]] auto live_bytes(tag t) -> std::size_t;
+[[nodiscard]] auto peak_bytes(tag t) -> std::size_t;
+
+///
+/// \brief Tag that untagged allocations on this thread are attributed to (only with CARISE_TRACK_ALLOCATIONS).
+///
+/// Defaults to tag::general.
+///
+[[nodiscard]] auto current_tag() -> tag;
+
+/// \brief Attributes untagged allocations on this thread to a tag for the lifetime of the scope.
+class scope {
+  public:
+	explicit scope(tag t);
+	~scope();
+
+	scope(scope const&) = delete;
+	scope& operator=(scope const&) = delete;
+
+  private:
+	tag m_previous;
+};
+
+///
+/// \brief Bytes owned by something the allocator never sees (GPU textures, buffers allocated inside SFML, ...).
+///
+/// Accounts bytes against a tag for as long as the instance lives.
+///
+class tracked_bytes {
+  public:
+	tracked_bytes() = default;
+	tracked_bytes(tag const t, std::size_t const bytes) : m_tag(t), m_bytes(bytes) { on_alloc(m_tag, m_bytes); }
+	~tracked_bytes() { reset(); }
+
+	tracked_bytes(tracked_bytes&& rhs) noexcept : m_tag(rhs.m_tag), m_bytes(std::exchange(rhs.m_bytes, 0)) {}
+	tracked_bytes& operator=(tracked_bytes&& rhs) noexcept {
+		if (&rhs != this) {
+			reset();
+			m_tag = rhs.m_tag;
+			m_bytes = std::exchange(rhs.m_bytes, 0);
+		}
+		return *this;
+	}
+
+	void reset() {
+		if (m_bytes > 0) { on_free(m_tag, std::exchange(m_bytes, 0)); }
+	}
+
+	[[nodiscard]] auto bytes() const -> std::size_t { return m_bytes; }
+
+  private:
+	tag m_tag{};
+	std::size_t m_bytes{};
+};
+
+///
+/// \brief Standard allocator that accounts its allocations against Tag.
+///
+/// Use for containers owned by a subsystem, eg tagged_vector<tile, tag::map>.
+///
+template <typename Type, tag Tag>
+struct tagged_allocator {
+	using value_type = Type;
+
+	template <typename Other>
+	struct rebind {
+		using other = tagged_allocator<Other, Tag>;
+	};
+
+	tagged_allocator() = default;
+	template <typename Other>
+	tagged_allocator(tagged_allocator<Other, Tag> const&) noexcept {}
+
+	[[nodiscard]] auto allocate(std::size_t const count) -> Type* {
+#if CARISE_TRACK_ALLOCATIONS
+		// the replaced operator new does the accounting
+		auto const s = scope{Tag};
+		return std::allocator<Type>{}.allocate(count);
+#else
+		auto* ret = std::allocator<Type>{}.allocate(count);
+		on_alloc(Tag, count * sizeof(Type));
+		return ret;
+#endif
+	}
+
+	void deallocate(Type* ptr, std::size_t const count) {
+#if !CARISE_TRACK_ALLOCATIONS
+		on_free(Tag, count * sizeof(Type));
+#endif
+		std::allocator<Type>{}.deallocate(ptr, count);
+	}
+
+	template <typename Other>
+	friend constexpr auto operator==(tagged_allocator const&, tagged_allocator<Other, Tag> const&) -> bool {
+		return true;
+	}
+};
+
+template <typename Type, tag Tag>
+using tagged_vector = std::vector<Type, tagged_allocator<Type, Tag>>;
+
+struct stats {
+	tag t{};
+	std::size_t live{};
+	std::size_t peak{};
+	/// \brief 0 if unlimited.
+	std::size_t budget{};
+	std::uint64_t allocations{};
+	std::uint64_t bytes_allocated{};
+	/// \brief Per second, since the previous call to tracker::sample().
+	double allocation_rate{};
+	double byte_rate{};
+};
+
+///
+/// \brief Budgets, eviction, and read-side reporting on top of the per-tag counters.
+///
+/// Caches register an evictor for their tag; enforce_budgets() (main thread, once per frame) asks them to
+/// release memory while the tag is over budget.
+///
+class tracker {
+  public:
+	/// \brief Called with the number of bytes over budget; returns the number of bytes it released.
+	using evictor = std::function<std::size_t(std::size_t)>;
+	using evictor_id = std::uint64_t;
+
+	void set_budget(tag t, std::size_t bytes);
+	[[nodiscard]] auto budget(tag t) const -> std::size_t;
+	///
+	/// \brief Set budgets from "<tag> = <MiB>" lines; # starts a comment.
+	/// \returns Number of budgets set
+	///
+	auto load_budgets(std::string_view text) -> std::size_t;
+
+	[[nodiscard]] auto add_evictor(tag t, evictor func) -> evictor_id;
+	void remove_evictor(evictor_id id);
+
+	/// \returns Bytes released by evictors
+	auto enforce_budgets() -> std::size_t;
+
+	/// \brief Per-tag stats; rates are measured since the previous call.
+	void sample(std::span<stats, tag_count_v> out);
+
+	/// \brief Publish live / peak bytes as gauges named carise_memory_{live,peak}_bytes_<tag>.
+	void publish(metrics::registry& registry) const;
+
+	/// \brief Sample and append a human readable table.
+	void write_report(std::string& out);
+	/// \brief Append the table for samples taken earlier by sample().
+	static void write_report(std::string& out, std::span<stats const, tag_count_v> samples);
+
+  private:
+	struct evictor_entry {
+		evictor_id id{};
+		tag t{};
+		evictor func{};
+	};
+
+	mutable std::mutex m_mutex{};
+	std::vector<evictor_entry> m_evictors{};
+	evictor_id m_next_id{};
+	std::array<std::uint64_t, tag_count_v> m_prev_allocations{};
+	std::array<std::uint64_t, tag_count_v> m_prev_bytes{};
+	std::chrono::steady_clock::time_point m_prev_sample{std::chrono::steady_clock::now()};
+};
+
+[[nodiscard]] auto global() -> tracker&;
+} // namespace carise::memory
@@ -0,0 +1,72 @@
+#include <carise/core/memory.hpp>
+#include <cstdlib>
+#include <new>
+
+// Replacement global operator new / delete: each block carries a small header recording its size and the
+// allocating thread's memory tag, so frees are attributed correctly from any thread.
+// Compiled into every executable linking carise-lib when CARISE_TRACK_ALLOCATIONS is ON.
+
+namespace {
+using carise::memory::tag;
+
+struct alignas(std::max_align_t) header {
+	std::size_t size;
+	// distance from the start of the malloc'd block to the header (non-zero only for over-aligned allocations)
+	std::uint32_t offset;
+	tag t;
+};
+
+auto allocate(std::size_t const size, std::size_t const alignment) noexcept -> void* {
+	auto const padding = alignment > alignof(header) ? alignment : 0;
+	auto* raw = static_cast<std::byte*>(std::malloc(sizeof(header) + padding + size));
+	if (!raw) { return nullptr; }
+	auto* user = raw + sizeof(header);
+	if (padding > 0) {
+		auto const address = reinterpret_cast<std::uintptr_t>(user);
+		user += (alignment - address % alignment) % alignment;
+	}
+	auto* head = reinterpret_cast<header*>(user) - 1;
+	auto const t = carise::memory::current_tag();
+	*head = header{.size = size, .offset = static_cast<std::uint32_t>(reinterpret_cast<std::byte*>(head) - raw), .t = t};
+	carise::memory::on_alloc(t, size);
+	return user;
+}
+
+void deallocate(void* ptr) noexcept {
+	if (!ptr) { return; }
+	auto* head = static_cast<header*>(ptr) - 1;
+	carise::memory::on_free(head->t, head->size);
+	std::free(reinterpret_cast<std::byte*>(head) - head->offset);
+}
+
+auto allocate_or_throw(std::size_t const size, std::size_t const alignment) -> void* {
+	for (;;) {
+		if (auto* ret = allocate(size, alignment)) { return ret; }
+		auto handler = std::get_new_handler();
+		if (!handler) { throw std::bad_alloc{}; }
+		handler();
+	}
+}
+} // namespace
+
+void* operator new(std::size_t size) { return allocate_or_throw(size, 0); }
+void* operator new[](std::size_t size) { return allocate_or_throw(size, 0); }
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept { return allocate(size, 0); }
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept { return allocate(size, 0); }
+void* operator new(std::size_t size, std::align_val_t align) { return allocate_or_throw(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return allocate_or_throw(size, static_cast<std::size_t>(align)); }
+void* operator new(std::size_t size, std::align_val_t align, std::nothrow_t const&) noexcept { return allocate(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align, std::nothrow_t const&) noexcept { return allocate(size, static_cast<std::size_t>(align)); }
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::nothrow_t const&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, std::nothrow_t const&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, std::nothrow_t const&) noexcept { deallocate(ptr); }
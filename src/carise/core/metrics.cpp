@@ -0,0 +1,209 @@
+#include <carise/core/metrics.hpp>
+#include <carise/core/log.hpp>
+#include <charconv>
+#include <cstdio>
+#include <iterator>
+#include <system_error>
+
+namespace carise::metrics {
+namespace {
+std::atomic<std::size_t> g_next_shard{};
+
+void append_number(std::string& out, double const value) {
+	char buffer[64];
+	auto const result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+	out.append(buffer, result.ptr);
+}
+
+void append_number(std::string& out, std::uint64_t const value) {
+	char buffer[32];
+	auto const result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+	out.append(buffer, result.ptr);
+}
+
+auto to_string(kind const type) -> std::string_view {
+	switch (type) {
+	case kind::counter: return "counter";
+	case kind::gauge: return "gauge";
+	default: return "summary";
+	}
+}
+} // namespace
+
+auto detail::thread_shard() -> std::size_t {
+	thread_local auto const ret = g_next_shard.fetch_add(1, std::memory_order_relaxed) % shard_count_v;
+	return ret;
+}
+
+auto counter::value() const -> std::uint64_t {
+	std::uint64_t ret{};
+	for (auto const& shard : m_shards) { ret += shard.value.load(std::memory_order_relaxed); }
+	return ret;
+}
+
+auto histogram::snapshot::quantile(double const q) const -> double {
+	if (count == 0) { return 0.0; }
+	auto const rank = static_cast<std::uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(count - 1)) + 1;
+	std::uint64_t seen{};
+	for (std::size_t i = 0; i < buckets.size(); ++i) {
+		seen += buckets[i];
+		if (seen >= rank) {
+			// report the bucket midpoint: halves the worst case error compared to either bound
+			auto const lower = bucket_lower_bound(i);
+			auto const upper = i + 1 < bucket_count_v ? bucket_lower_bound(i + 1) : lower + 1;
+			return static_cast<double>(lower) + static_cast<double>(upper - lower - 1) * 0.5;
+		}
+	}
+	return static_cast<double>(bucket_lower_bound(bucket_count_v - 1));
+}
+
+auto histogram::take_snapshot() const -> snapshot {
+	auto ret = snapshot{};
+	ret.buckets.resize(bucket_count_v);
+	for (std::size_t i = 0; i < bucket_count_v; ++i) {
+		ret.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+		ret.count += ret.buckets[i];
+	}
+	// concurrent records may land between the bucket reads and this one; the bucket total is the consistent count
+	ret.sum = m_sum.load(std::memory_order_relaxed);
+	return ret;
+}
+
+auto registry::get_entry(std::string_view const name, std::string_view const help, kind const type) -> entry& {
+	auto it = m_entries.find(name);
+	if (it == m_entries.end()) {
+		it = m_entries.emplace(std::string{name}, entry{.help = std::string{help}, .type = type}).first;
+	} else if (it->second.type != type) {
+		// leave the registered metric alone: the caller gets a working instance that is simply not exported
+		auto [mismatched, inserted] = m_mismatched.try_emplace({std::string{name}, type}, entry{.help = std::string{help}, .type = type});
+		if (inserted) { CARISE_LOG_ERROR("metric {} re-registered with a different type; the new one is not exported", name); }
+		return mismatched->second;
+	}
+	return it->second;
+}
+
+auto registry::get_counter(std::string_view const name, std::string_view const help) -> counter& {
+	auto lock = std::scoped_lock{m_mutex};
+	auto& ret = get_entry(name, help, kind::counter);
+	if (!ret.counter_) { ret.counter_ = std::make_unique<counter>(); }
+	return *ret.counter_;
+}
+
+auto registry::get_gauge(std::string_view const name, std::string_view const help) -> gauge& {
+	auto lock = std::scoped_lock{m_mutex};
+	auto& ret = get_entry(name, help, kind::gauge);
+	if (!ret.gauge_) { ret.gauge_ = std::make_unique<gauge>(); }
+	return *ret.gauge_;
+}
+
+auto registry::get_histogram(std::string_view const name, std::string_view const help, double const scale) -> histogram& {
+	auto lock = std::scoped_lock{m_mutex};
+	auto& ret = get_entry(name, help, kind::histogram);
+	if (!ret.histogram_) {
+		ret.histogram_ = std::make_unique<histogram>();
+		ret.scale = scale;
+	}
+	return *ret.histogram_;
+}
+
+void registry::collect(std::vector<sample>& out) const {
+	out.clear();
+	auto lock = std::scoped_lock{m_mutex};
+	for (auto const& [name, entry] : m_entries) {
+		auto s = sample{.name = name, .help = entry.help, .type = entry.type};
+		if (entry.counter_) {
+			s.value = static_cast<double>(entry.counter_->value());
+		} else if (entry.gauge_) {
+			s.value = entry.gauge_->value();
+		} else if (entry.histogram_) {
+			auto const snap = entry.histogram_->take_snapshot();
+			s.count = snap.count;
+			s.value = snap.mean() * entry.scale;
+			s.p50 = snap.quantile(0.5) * entry.scale;
+			s.p99 = snap.quantile(0.99) * entry.scale;
+			s.max = snap.quantile(1.0) * entry.scale;
+		}
+		out.push_back(s);
+	}
+}
+
+void registry::write_prometheus(std::string& out) const {
+	auto lock = std::scoped_lock{m_mutex};
+	for (auto const& [name, entry] : m_entries) {
+		if (!entry.help.empty()) {
+			out.append("# HELP ").append(name).append(" ").append(entry.help).append("\n");
+		}
+		out.append("# TYPE ").append(name).append(" ").append(to_string(entry.type)).append("\n");
+		if (entry.counter_) {
+			out.append(name).append(" ");
+			append_number(out, entry.counter_->value());
+			out += '\n';
+		} else if (entry.gauge_) {
+			out.append(name).append(" ");
+			append_number(out, entry.gauge_->value());
+			out += '\n';
+		} else if (entry.histogram_) {
+			auto const snap = entry.histogram_->take_snapshot();
+			for (auto const q : {0.5, 0.9, 0.99, 0.999}) {
+				out.append(name).append("{quantile=\"");
+				append_number(out, q);
+				out.append("\"} ");
+				append_number(out, snap.quantile(q) * entry.scale);
+				out += '\n';
+			}
+			out.append(name).append("_sum ");
+			append_number(out, static_cast<double>(snap.sum) * entry.scale);
+			out.append("\n").append(name).append("_count ");
+			append_number(out, snap.count);
+			out += '\n';
+		}
+	}
+}
+
+auto global() -> registry& {
+	static auto ret = registry{};
+	return ret;
+}
+
+file_exporter::file_exporter(registry const& source, std::filesystem::path path, std::chrono::milliseconds const interval)
+	: m_source(source), m_path(std::move(path)), m_interval(interval) {
+	m_thread = std::thread{[this] { run(); }};
+}
+
+file_exporter::~file_exporter() {
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		m_stop = true;
+	}
+	m_cv.notify_one();
+	m_thread.join();
+}
+
+void file_exporter::run() {
+	auto lock = std::unique_lock{m_mutex};
+	while (!m_cv.wait_for(lock, m_interval, [this] { return m_stop; })) {
+		lock.unlock();
+		write();
+		lock.lock();
+	}
+	lock.unlock();
+	write();
+}
+
+void file_exporter::write() {
+	m_buffer.clear();
+	m_source.write_prometheus(m_buffer);
+	auto temp = m_path;
+	temp += ".tmp";
+	auto* file = std::fopen(temp.string().c_str(), "wb");
+	if (!file) {
+		CARISE_LOG_WARN("failed to open metrics file {}", temp.string());
+		return;
+	}
+	std::fwrite(m_buffer.data(), 1, m_buffer.size(), file);
+	std::fclose(file);
+	auto ec = std::error_code{};
+	std::filesystem::rename(temp, m_path, ec);
+	if (ec) { CARISE_LOG_WARN("failed to replace metrics file {}: {}", m_path.string(), ec.message()); }
+}
+} // namespace carise::metrics
@@ -0,0 +1,206 @@
+#pragma once
+#include <carise/core/cache_line.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace carise::metrics {
+/// \brief Number of per-thread shards in each counter; threads beyond this share shards (still correct, just contended).
+inline constexpr std::size_t shard_count_v{16};
+
+namespace detail {
+/// \brief Shard index of the calling thread, assigned round robin on first use.
+[[nodiscard]] auto thread_shard() -> std::size_t;
+} // namespace detail
+
+///
+/// \brief Monotonic counter: a relaxed add on the calling thread's own cache line, summed on read.
+///
+class counter {
+  public:
+	void add(std::uint64_t const amount = 1) { m_shards[detail::thread_shard()].value.fetch_add(amount, std::memory_order_relaxed); }
+
+	[[nodiscard]] auto value() const -> std::uint64_t;
+
+  private:
+	std::array<cache_padded<std::atomic<std::uint64_t>>, shard_count_v> m_shards{};
+};
+
+///
+/// \brief Point-in-time value (queue depth, resident bytes, ...).
+///
+class gauge {
+  public:
+	void set(double const value) { m_value.store(value, std::memory_order_relaxed); }
+	void add(double const delta) { m_value.fetch_add(delta, std::memory_order_relaxed); }
+
+	[[nodiscard]] auto value() const -> double { return m_value.load(std::memory_order_relaxed); }
+
+  private:
+	std::atomic<double> m_value{};
+};
+
+///
+/// \brief HDR-style log-linear histogram of non-negative integer samples.
+///
+/// Each power of two is split into 2^sub_bucket_bits_v linear buckets, bounding the relative error of any
+/// quantile to ~3% across the whole range. Recording is two relaxed atomic adds and never allocates.
+///
+class histogram {
+  public:
+	static constexpr std::uint32_t sub_bucket_bits_v{5};
+	static constexpr std::uint64_t sub_bucket_count_v{std::uint64_t{1} << sub_bucket_bits_v};
+	/// \brief Samples are clamped below 2^max_bits_v (~18 minutes when recording nanoseconds).
+	static constexpr std::uint32_t max_bits_v{40};
+	static constexpr std::size_t bucket_count_v{(max_bits_v - sub_bucket_bits_v + 1) * sub_bucket_count_v};
+
+	[[nodiscard]] static constexpr auto bucket_index(std::uint64_t value) -> std::size_t {
+		value = std::min(value, (std::uint64_t{1} << max_bits_v) - 1);
+		if (value < sub_bucket_count_v) { return static_cast<std::size_t>(value); }
+		auto const shift = static_cast<std::uint32_t>(std::bit_width(value)) - 1 - sub_bucket_bits_v;
+		return static_cast<std::size_t>((shift + 1) * sub_bucket_count_v + ((value >> shift) - sub_bucket_count_v));
+	}
+
+	[[nodiscard]] static constexpr auto bucket_lower_bound(std::size_t const index) -> std::uint64_t {
+		if (index < sub_bucket_count_v) { return index; }
+		auto const shift = index / sub_bucket_count_v - 1;
+		return (sub_bucket_count_v + index % sub_bucket_count_v) << shift;
+	}
+
+	struct snapshot {
+		[[nodiscard]] auto quantile(double q) const -> double;
+		[[nodiscard]] auto mean() const -> double { return count > 0 ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+
+		std::vector<std::uint64_t> buckets{};
+		std::uint64_t count{};
+		std::uint64_t sum{};
+	};
+
+	void record(std::uint64_t const value) {
+		m_buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+		m_sum.fetch_add(value, std::memory_order_relaxed);
+	}
+
+	template <typename Rep, typename Period>
+	void record(std::chrono::duration<Rep, Period> const duration) {
+		record(static_cast<std::uint64_t>(std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), std::int64_t{0})));
+	}
+
+	[[nodiscard]] auto take_snapshot() const -> snapshot;
+
+  private:
+	std::array<std::atomic<std::uint64_t>, bucket_count_v> m_buckets{};
+	std::atomic<std::uint64_t> m_sum{};
+};
+
+/// \brief Records the lifetime of the scope into a histogram, in nanoseconds.
+class scoped_timer {
+  public:
+	explicit scoped_timer(histogram& target) : m_target(target), m_start(std::chrono::steady_clock::now()) {}
+	~scoped_timer() { m_target.record(std::chrono::steady_clock::now() - m_start); }
+
+	scoped_timer(scoped_timer const&) = delete;
+	scoped_timer& operator=(scoped_timer const&) = delete;
+
+  private:
+	histogram& m_target;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+enum class kind : std::uint8_t { counter, gauge, histogram };
+
+/// \brief Read-side view of one metric, for overlays and exporters.
+struct sample {
+	std::string_view name{};
+	std::string_view help{};
+	kind type{};
+	/// \brief Counter / gauge value, or histogram mean (scaled).
+	double value{};
+	/// \brief Histogram only (scaled).
+	double p50{};
+	double p99{};
+	double max{};
+	std::uint64_t count{};
+};
+
+///
+/// \brief Named metrics with stable addresses.
+///
+/// Lookup takes a lock, so instrumented code should fetch its metric once (eg into a function-local static)
+/// and keep the reference; updating it afterwards is lock-free.
+///
+class registry {
+  public:
+	auto get_counter(std::string_view name, std::string_view help = {}) -> counter&;
+	auto get_gauge(std::string_view name, std::string_view help = {}) -> gauge&;
+	/// \param scale Multiplier applied to recorded samples when reporting (default: nanoseconds to seconds).
+	auto get_histogram(std::string_view name, std::string_view help = {}, double scale = 1e-9) -> histogram&;
+
+	/// \brief Fill out with one sample per metric, sorted by name.
+	void collect(std::vector<sample>& out) const;
+
+	/// \brief Append all metrics in the Prometheus text exposition format (histograms as summaries).
+	void write_prometheus(std::string& out) const;
+
+  private:
+	struct entry {
+		std::string help{};
+		kind type{};
+		double scale{1.0};
+		std::unique_ptr<counter> counter_{};
+		std::unique_ptr<gauge> gauge_{};
+		std::unique_ptr<histogram> histogram_{};
+	};
+
+	auto get_entry(std::string_view name, std::string_view help, kind type) -> entry&;
+
+	mutable std::mutex m_mutex{};
+	std::map<std::string, entry, std::less<>> m_entries{};
+	/// \brief Stand-ins handed out when a name is requested as another kind than registered; never exported.
+	std::map<std::pair<std::string, kind>, entry> m_mismatched{};
+};
+
+/// \brief Process-wide registry used by instrumentation throughout the game.
+[[nodiscard]] auto global() -> registry&;
+
+///
+/// \brief Periodically writes a registry in Prometheus text format to a file.
+///
+/// The file is replaced atomically (write + rename), so it can be scraped by node_exporter's textfile collector.
+///
+class file_exporter {
+  public:
+	explicit file_exporter(registry const& source, std::filesystem::path path, std::chrono::milliseconds interval = std::chrono::seconds{5});
+	~file_exporter();
+
+	file_exporter(file_exporter const&) = delete;
+	file_exporter& operator=(file_exporter const&) = delete;
+
+  private:
+	void run();
+	void write();
+
+	registry const& m_source;
+	std::filesystem::path m_path;
+	std::chrono::milliseconds m_interval;
+	std::string m_buffer{};
+
+	std::mutex m_mutex{};
+	std::condition_variable m_cv{};
+	bool m_stop{};
+	std::thread m_thread{};
+};
+} // namespace carise::metrics
@@ -0,0 +1,170 @@
+#pragma once
+#include <carise/core/spsc_queue.hpp>
+#include <optional>
+
+namespace carise {
+///
+/// \brief Bounded lock-free multi-producer single-consumer queue.
+///
+/// Each cell carries a sequence number (Vyukov's bounded queue): producers claim a cell with one CAS on the
+/// tail and publish it by bumping its sequence; the consumer never touches the tail. Never allocates after construction.
+///
+template <typename Type>
+class mpsc_queue {
+  public:
+	explicit mpsc_queue(std::size_t capacity) : m_mask(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1) {
+		m_cells = std::make_unique<cell[]>(m_mask + 1);
+		for (std::size_t i = 0; i <= m_mask; ++i) { m_cells[i].sequence.store(i, std::memory_order_relaxed); }
+	}
+
+	~mpsc_queue() {
+		drain([](Type&&) {});
+	}
+
+	mpsc_queue(mpsc_queue const&) = delete;
+	mpsc_queue& operator=(mpsc_queue const&) = delete;
+
+	///
+	/// \brief Construct an element in place (any thread).
+	/// \returns false if the queue is full
+	///
+	template <typename... Args>
+	auto try_emplace(Args&&... args) -> bool {
+		auto pos = m_tail.load(std::memory_order_relaxed);
+		cell* target{};
+		for (;;) {
+			target = &m_cells[pos & m_mask];
+			auto const seq = target->sequence.load(std::memory_order_acquire);
+			auto const diff = static_cast<std::ptrdiff_t>(seq - pos);
+			if (diff == 0) {
+				if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+			} else if (diff < 0) {
+				return false;
+			} else {
+				pos = m_tail.load(std::memory_order_relaxed);
+			}
+		}
+		target->slot.construct(std::forward<Args>(args)...);
+		target->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	auto try_push(Type value) -> bool { return try_emplace(std::move(value)); }
+
+	/// \brief Pop one element (consumer only).
+	auto try_pop(Type& out) -> bool {
+		return drain([&out](Type&& t) { out = std::move(t); }, 1) == 1;
+	}
+
+	/// \brief Pop up to out.size() elements (consumer only).
+	auto pop_batch(std::span<Type> out) -> std::size_t {
+		return drain([it = out.begin()](Type&& t) mutable { *it++ = std::move(t); }, out.size());
+	}
+
+	///
+	/// \brief Invoke func(Type&&) for up to max published elements (consumer only).
+	///
+	/// Stops at the first cell whose producer has claimed but not yet published it, preserving FIFO order.
+	///
+	template <typename Func>
+	auto drain(Func&& func, std::size_t max = std::numeric_limits<std::size_t>::max()) -> std::size_t {
+		auto head = m_head.load(std::memory_order_relaxed);
+		std::size_t ret{};
+		while (ret < max) {
+			auto& target = m_cells[head & m_mask];
+			if (target.sequence.load(std::memory_order_acquire) != head + 1) { break; }
+			func(target.slot.take());
+			target.sequence.store(head + m_mask + 1, std::memory_order_release);
+			++head;
+			++ret;
+		}
+		if (ret > 0) { m_head.store(head, std::memory_order_relaxed); }
+		return ret;
+	}
+
+	[[nodiscard]] auto capacity() const -> std::size_t { return m_mask + 1; }
+	/// \brief Claimed (possibly not yet published) elements minus consumed ones; safe to call from any thread.
+	[[nodiscard]] auto size_approx() const -> std::size_t {
+		auto const tail = m_tail.load(std::memory_order_relaxed);
+		auto const head = m_head.load(std::memory_order_relaxed);
+		return tail > head ? tail - head : 0;
+	}
+
+  private:
+	struct cell {
+		std::atomic<std::size_t> sequence{};
+		detail::queue_slot<Type> slot{};
+	};
+
+	std::unique_ptr<cell[]> m_cells{};
+	std::size_t m_mask{};
+
+	alignas(cache_line_size_v) std::atomic<std::size_t> m_tail{};
+	// only written by the consumer; atomic so size_approx() can be read from any thread
+	alignas(cache_line_size_v) std::atomic<std::size_t> m_head{};
+};
+
+///
+/// \brief Unbounded lock-free multi-producer single-consumer queue (Vyukov's node-based queue).
+///
+/// Push is a single atomic exchange but allocates a node; prefer mpsc_queue on paths that must not allocate.
+///
+template <typename Type>
+class unbounded_mpsc_queue {
+  public:
+	unbounded_mpsc_queue() : m_tail(new node{}) { m_head.store(m_tail, std::memory_order_relaxed); }
+
+	~unbounded_mpsc_queue() {
+		drain([](Type&&) {});
+		delete m_tail;
+	}
+
+	unbounded_mpsc_queue(unbounded_mpsc_queue const&) = delete;
+	unbounded_mpsc_queue& operator=(unbounded_mpsc_queue const&) = delete;
+
+	/// \brief Construct an element in place (any thread).
+	template <typename... Args>
+	void emplace(Args&&... args) {
+		auto* n = new node{};
+		n->value.emplace(std::forward<Args>(args)...);
+		auto* prev = m_head.exchange(n, std::memory_order_acq_rel);
+		prev->next.store(n, std::memory_order_release);
+	}
+
+	void push(Type value) { emplace(std::move(value)); }
+
+	/// \brief Pop one element (consumer only).
+	auto try_pop(Type& out) -> bool {
+		return drain([&out](Type&& t) { out = std::move(t); }, 1) == 1;
+	}
+
+	/// \brief Pop up to out.size() elements (consumer only).
+	auto pop_batch(std::span<Type> out) -> std::size_t {
+		return drain([it = out.begin()](Type&& t) mutable { *it++ = std::move(t); }, out.size());
+	}
+
+	/// \brief Invoke func(Type&&) for up to max linked elements (consumer only).
+	template <typename Func>
+	auto drain(Func&& func, std::size_t max = std::numeric_limits<std::size_t>::max()) -> std::size_t {
+		std::size_t ret{};
+		while (ret < max) {
+			auto* next = m_tail->next.load(std::memory_order_acquire);
+			if (!next) { break; }
+			func(std::move(*next->value));
+			next->value.reset();
+			delete std::exchange(m_tail, next);
+			++ret;
+		}
+		return ret;
+	}
+
+  private:
+	struct node {
+		std::atomic<node*> next{};
+		std::optional<Type> value{};
+	};
+
+	alignas(cache_line_size_v) std::atomic<node*> m_head{};
+	alignas(cache_line_size_v) node* m_tail{};
+};
+} // namespace carise
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+
+namespace carise {
+///
+/// \brief Small deterministic PRNG (PCG32).
+///
+/// Unlike std::uniform_*_distribution, the helpers here produce identical sequences on every standard library,
+/// which replays, benchmarks and seeded generation rely on.
+///
+class rng {
+  public:
+	explicit constexpr rng(std::uint64_t const seed = 0x853c49e6748fea9bull, std::uint64_t const stream = 0xda3e39cb94b95bdbull)
+		: m_inc((stream << 1u) | 1u) {
+		next();
+		m_state += seed;
+		next();
+	}
+
+	constexpr auto next() -> std::uint32_t {
+		auto const old = m_state;
+		m_state = old * 6364136223846793005ull + m_inc;
+		auto const xorshifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+		auto const rot = static_cast<std::uint32_t>(old >> 59u);
+		return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+	}
+
+	/// \brief Uniform in [0, 1).
+	constexpr auto unit() -> float { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+	/// \brief Uniform in [lo, hi).
+	constexpr auto range(float const lo, float const hi) -> float { return lo + (hi - lo) * unit(); }
+	/// \brief Uniform in [lo, hi] (hi - lo must fit in 32 bits).
+	constexpr auto range(int const lo, int const hi) -> int {
+		auto const span = static_cast<std::uint64_t>(static_cast<std::int64_t>(hi) - lo) + 1;
+		return lo + static_cast<int>((static_cast<std::uint64_t>(next()) * span) >> 32u);
+	}
+	constexpr auto chance(float const probability) -> bool { return unit() < probability; }
+
+  private:
+	std::uint64_t m_state{};
+	std::uint64_t m_inc{};
+};
+} // namespace carise
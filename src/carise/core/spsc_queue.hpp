@@ -0,0 +1,248 @@
+#pragma once
+#include <carise/core/cache_line.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+
+namespace carise {
+namespace detail {
+/// \brief Uninitialized storage for one queue element.
+template <typename Type>
+struct queue_slot {
+	alignas(Type) std::byte bytes[sizeof(Type)];
+
+	template <typename... Args>
+	auto construct(Args&&... args) -> Type* {
+		return std::construct_at(reinterpret_cast<Type*>(bytes), std::forward<Args>(args)...);
+	}
+	/// \brief Default-initialise in place: trivial members are left as they are.
+	auto construct_default() -> Type* { return ::new (static_cast<void*>(bytes)) Type; }
+	auto get() -> Type& { return *std::launder(reinterpret_cast<Type*>(bytes)); }
+	void destroy() { std::destroy_at(&get()); }
+
+	/// \brief Moves the element out and destroys the slot's copy.
+	auto take() -> Type {
+		auto ret = std::move(get());
+		destroy();
+		return ret;
+	}
+};
+} // namespace detail
+
+///
+/// \brief Bounded wait-free single-producer single-consumer ring buffer.
+///
+/// Capacity is rounded up to a power of two. Producer and consumer indices live on separate cache lines,
+/// and each side caches the other's index so the shared lines are only touched when the cache runs out.
+///
+template <typename Type>
+class spsc_queue {
+  public:
+	explicit spsc_queue(std::size_t capacity) : m_mask(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1) {
+		m_slots = std::make_unique<detail::queue_slot<Type>[]>(m_mask + 1);
+	}
+
+	~spsc_queue() {
+		while (pop()) {}
+	}
+
+	spsc_queue(spsc_queue const&) = delete;
+	spsc_queue& operator=(spsc_queue const&) = delete;
+
+	///
+	/// \brief Construct an element in place (producer only).
+	/// \returns false if the queue is full
+	///
+	template <typename... Args>
+	auto try_emplace(Args&&... args) -> bool {
+		auto const tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_cached_head > m_mask) {
+			m_cached_head = m_head.load(std::memory_order_acquire);
+			if (tail - m_cached_head > m_mask) { return false; }
+		}
+		m_slots[tail & m_mask].construct(std::forward<Args>(args)...);
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	auto try_push(Type value) -> bool { return try_emplace(std::move(value)); }
+
+	///
+	/// \brief Default-initialise the next element in place to be filled before commit() (producer only).
+	///
+	/// Saves copying a large element built elsewhere. The consumer cannot see it until commit().
+	/// \returns null if the queue is full
+	///
+	auto try_claim() -> Type* {
+		auto const tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_cached_head > m_mask) {
+			m_cached_head = m_head.load(std::memory_order_acquire);
+			if (tail - m_cached_head > m_mask) { return nullptr; }
+		}
+		return m_slots[tail & m_mask].construct_default();
+	}
+
+	/// \brief Publish the element from the last successful try_claim() (producer only).
+	void commit() { m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+	///
+	/// \brief Pop one element (consumer only).
+	/// \returns false if the queue is empty
+	///
+	auto try_pop(Type& out) -> bool {
+		auto* slot = front_slot();
+		if (!slot) { return false; }
+		out = slot->take();
+		m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		return true;
+	}
+
+	///
+	/// \brief Pop up to out.size() elements with a single release of the consumer index (consumer only).
+	/// \returns Number of elements written to out
+	///
+	auto pop_batch(std::span<Type> out) -> std::size_t {
+		return drain([it = out.begin()](Type&& t) mutable { *it++ = std::move(t); }, out.size());
+	}
+
+	///
+	/// \brief Invoke func(Type&&) for up to max elements (consumer only).
+	/// \returns Number of elements consumed
+	///
+	template <typename Func>
+	auto drain(Func&& func, std::size_t max = std::numeric_limits<std::size_t>::max()) -> std::size_t {
+		auto const head = m_head.load(std::memory_order_relaxed);
+		if (m_cached_tail == head) { m_cached_tail = m_tail.load(std::memory_order_acquire); }
+		auto const count = std::min(m_cached_tail - head, max);
+		for (std::size_t i = 0; i < count; ++i) {
+			auto& slot = m_slots[(head + i) & m_mask];
+			func(std::move(slot.get()));
+			slot.destroy();
+		}
+		if (count > 0) { m_head.store(head + count, std::memory_order_release); }
+		return count;
+	}
+
+	[[nodiscard]] auto capacity() const -> std::size_t { return m_mask + 1; }
+	/// \brief Snapshot of the element count; exact only when called from the producer or consumer while the other is idle.
+	[[nodiscard]] auto size_approx() const -> std::size_t { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+	[[nodiscard]] auto empty() const -> bool { return size_approx() == 0; }
+
+  private:
+	auto front_slot() -> detail::queue_slot<Type>* {
+		auto const head = m_head.load(std::memory_order_relaxed);
+		if (m_cached_tail == head) {
+			m_cached_tail = m_tail.load(std::memory_order_acquire);
+			if (m_cached_tail == head) { return nullptr; }
+		}
+		return &m_slots[head & m_mask];
+	}
+
+	auto pop() -> bool {
+		auto* slot = front_slot();
+		if (!slot) { return false; }
+		slot->destroy();
+		m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		return true;
+	}
+
+	std::unique_ptr<detail::queue_slot<Type>[]> m_slots{};
+	std::size_t m_mask{};
+
+	// consumer line
+	alignas(cache_line_size_v) std::atomic<std::size_t> m_head{};
+	std::size_t m_cached_tail{};
+	// producer line
+	alignas(cache_line_size_v) std::atomic<std::size_t> m_tail{};
+	std::size_t m_cached_head{};
+};
+
+///
+/// \brief Unbounded single-producer single-consumer queue built from linked fixed-size blocks.
+///
+/// The producer only allocates when a block fills up; the consumer frees blocks it has fully drained.
+///
+template <typename Type, std::size_t BlockSize = 256>
+class unbounded_spsc_queue {
+  public:
+	unbounded_spsc_queue() : m_head_block(new block{}), m_tail_block(m_head_block) {}
+
+	~unbounded_spsc_queue() {
+		while (try_pop_discard()) {}
+		while (m_head_block) { delete std::exchange(m_head_block, m_head_block->next.load(std::memory_order_relaxed)); }
+	}
+
+	unbounded_spsc_queue(unbounded_spsc_queue const&) = delete;
+	unbounded_spsc_queue& operator=(unbounded_spsc_queue const&) = delete;
+
+	/// \brief Construct an element in place (producer only).
+	template <typename... Args>
+	void emplace(Args&&... args) {
+		if (m_tail_written == BlockSize) {
+			auto* next = new block{};
+			m_tail_block->next.store(next, std::memory_order_release);
+			m_tail_block = next;
+			m_tail_written = 0;
+		}
+		m_tail_block->slots[m_tail_written].construct(std::forward<Args>(args)...);
+		m_tail_block->written.store(++m_tail_written, std::memory_order_release);
+	}
+
+	void push(Type value) { emplace(std::move(value)); }
+
+	/// \brief Pop one element (consumer only).
+	auto try_pop(Type& out) -> bool {
+		return drain([&out](Type&& t) { out = std::move(t); }, 1) == 1;
+	}
+
+	/// \brief Pop up to out.size() elements (consumer only).
+	auto pop_batch(std::span<Type> out) -> std::size_t {
+		return drain([it = out.begin()](Type&& t) mutable { *it++ = std::move(t); }, out.size());
+	}
+
+	/// \brief Invoke func(Type&&) for up to max elements (consumer only).
+	template <typename Func>
+	auto drain(Func&& func, std::size_t max = std::numeric_limits<std::size_t>::max()) -> std::size_t {
+		std::size_t ret{};
+		while (ret < max) {
+			auto const written = m_head_block->written.load(std::memory_order_acquire);
+			if (m_head_read < written) {
+				auto const count = std::min(written - m_head_read, max - ret);
+				for (std::size_t i = 0; i < count; ++i) { func(m_head_block->slots[m_head_read++].take()); }
+				ret += count;
+				continue;
+			}
+			if (m_head_read < BlockSize) { break; }
+			auto* next = m_head_block->next.load(std::memory_order_acquire);
+			if (!next) { break; }
+			delete std::exchange(m_head_block, next);
+			m_head_read = 0;
+		}
+		return ret;
+	}
+
+  private:
+	struct block {
+		detail::queue_slot<Type> slots[BlockSize];
+		std::atomic<std::size_t> written{};
+		std::atomic<block*> next{};
+	};
+
+	auto try_pop_discard() -> bool {
+		return drain([](Type&&) {}, 1) == 1;
+	}
+
+	// consumer line
+	alignas(cache_line_size_v) block* m_head_block{};
+	std::size_t m_head_read{};
+	// producer line
+	alignas(cache_line_size_v) block* m_tail_block{};
+	std::size_t m_tail_written{};
+};
+} // namespace carise
@@ -0,0 +1,63 @@
+#include <carise/debug/memory_overlay.hpp>
+#include <carise/render/vertices.hpp>
+#include <algorithm>
+
+namespace carise {
+namespace {
+constexpr float bar_width_v{200.0f};
+constexpr float bar_height_v{12.0f};
+constexpr float row_height_v{17.0f};
+constexpr float margin_v{8.0f};
+} // namespace
+
+void memory_overlay::set_font(sf::Font const& font) {
+	m_label.emplace("", font, 14);
+	m_label->setFillColor(sf::Color::White);
+	m_since_refresh = refresh_interval_v;
+}
+
+void memory_overlay::update(float const dt) {
+	if (!m_visible) { return; }
+	m_since_refresh += dt;
+	if (m_since_refresh < refresh_interval_v) { return; }
+	m_since_refresh = 0.0f;
+	refresh();
+}
+
+void memory_overlay::refresh() {
+	m_text.clear();
+	// one sample for both: a second one straight after would measure rates over no time at all
+	m_tracker.sample(m_stats);
+	memory::tracker::write_report(m_text, m_stats);
+	if (m_label) { m_label->setString(m_text); }
+
+	m_bars.clear();
+	// first row of the table is the header, keep bars aligned with the tag rows
+	auto y = margin_v + row_height_v;
+	for (auto const& s : m_stats) {
+		auto const limit = static_cast<float>(std::max(s.budget > 0 ? s.budget : s.peak, std::size_t{1}));
+		auto const fill = std::min(static_cast<float>(s.live) / limit, 1.0f);
+		auto const over = s.budget > 0 && s.live > s.budget;
+		append_quad(m_bars, {margin_v, y}, {bar_width_v, bar_height_v}, sf::Color{40, 40, 40, 200});
+		append_quad(m_bars, {margin_v, y}, {bar_width_v * fill, bar_height_v}, over ? sf::Color{220, 60, 60, 220} : sf::Color{80, 140, 220, 220});
+		y += row_height_v;
+	}
+}
+
+void memory_overlay::draw(sf::RenderTarget& target) const {
+	if (!m_visible) { return; }
+	auto const view = target.getView();
+	target.setView(target.getDefaultView());
+	// bars in the top right corner with the table to their left
+	auto states = sf::RenderStates{};
+	auto const right = static_cast<float>(target.getSize().x);
+	states.transform.translate({right - bar_width_v - 2.0f * margin_v, 0.0f});
+	if (!m_bars.empty()) { target.draw(m_bars.data(), m_bars.size(), sf::PrimitiveType::Triangles, states); }
+	if (m_label) {
+		auto label_states = sf::RenderStates{};
+		label_states.transform.translate({right - bar_width_v - 480.0f, margin_v});
+		target.draw(*m_label, label_states);
+	}
+	target.setView(view);
+}
+} // namespace carise
@@ -0,0 +1,40 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace carise {
+///
+/// \brief In-game view of memory::tracker: one bar per tag (live against budget, or against peak if unbudgeted).
+///
+/// A table of live / peak / budget / allocation rate is shown once set_font() has been called.
+///
+class memory_overlay {
+  public:
+	static constexpr float refresh_interval_v{0.25f};
+
+	explicit memory_overlay(memory::tracker& tracker) : m_tracker(tracker) {}
+
+	void set_font(sf::Font const& font);
+	void toggle() { m_visible = !m_visible; }
+	[[nodiscard]] auto is_visible() const -> bool { return m_visible; }
+
+	void update(float dt);
+	void draw(sf::RenderTarget& target) const;
+
+  private:
+	void refresh();
+
+	memory::tracker& m_tracker;
+	std::array<memory::stats, memory::tag_count_v> m_stats{};
+	std::string m_text{};
+	std::optional<sf::Text> m_label{};
+	std::vector<sf::Vertex> m_bars{};
+
+	float m_since_refresh{refresh_interval_v};
+	bool m_visible{};
+};
+} // namespace carise
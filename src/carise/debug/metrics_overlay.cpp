@@ -0,0 +1,98 @@
+#include <carise/debug/metrics_overlay.hpp>
+#include <carise/render/vertices.hpp>
+#include <charconv>
+#include <iterator>
+
+namespace carise {
+namespace {
+constexpr float graph_height_v{120.0f};
+constexpr float graph_ms_scale_v{graph_height_v / 50.0f};
+constexpr float bar_width_v{2.0f};
+
+void append_fixed(std::string& out, double const value, int const precision) {
+	char buffer[64];
+	auto const result = std::to_chars(std::begin(buffer), std::end(buffer), value, std::chars_format::fixed, precision);
+	out.append(buffer, result.ptr);
+}
+
+auto bar_colour(float const ms) -> sf::Color {
+	if (ms <= 17.0f) { return sf::Color{80, 200, 80, 200}; }
+	if (ms <= 34.0f) { return sf::Color{220, 200, 60, 200}; }
+	return sf::Color{220, 60, 60, 200};
+}
+} // namespace
+
+void metrics_overlay::set_font(sf::Font const& font) {
+	m_label.emplace("", font, 14);
+	m_label->setFillColor(sf::Color::White);
+	m_label->setPosition({8.0f, 8.0f});
+	m_since_refresh = refresh_interval_v;
+}
+
+void metrics_overlay::push_frame_time(float const seconds) {
+	m_frame_times[m_next_frame] = seconds;
+	m_next_frame = (m_next_frame + 1) % graph_frames_v;
+}
+
+void metrics_overlay::update(float const dt) {
+	if (!m_visible) { return; }
+	rebuild_graph();
+	m_since_refresh += dt;
+	if (m_since_refresh < refresh_interval_v) { return; }
+	m_since_refresh = 0.0f;
+	rebuild_text();
+}
+
+void metrics_overlay::rebuild_text() {
+	if (!m_label) { return; }
+	m_registry.collect(m_samples);
+	m_text.clear();
+	for (auto const& sample : m_samples) {
+		m_text.append(sample.name).append("  ");
+		switch (sample.type) {
+		case metrics::kind::histogram:
+			m_text += "p50 ";
+			append_fixed(m_text, sample.p50 * 1000.0, 3);
+			m_text += "  p99 ";
+			append_fixed(m_text, sample.p99 * 1000.0, 3);
+			m_text += "  max ";
+			append_fixed(m_text, sample.max * 1000.0, 3);
+			m_text += " ms  n ";
+			append_fixed(m_text, static_cast<double>(sample.count), 0);
+			break;
+		case metrics::kind::counter: append_fixed(m_text, sample.value, 0); break;
+		default: append_fixed(m_text, sample.value, 2); break;
+		}
+		m_text += '\n';
+	}
+	m_label->setString(m_text);
+}
+
+void metrics_overlay::rebuild_graph() {
+	m_graph.clear();
+	auto const bottom = graph_height_v + 8.0f;
+	auto x = 8.0f;
+	// budget line at 60 Hz
+	append_quad(m_graph, {x, bottom - 16.67f * graph_ms_scale_v}, {bar_width_v * graph_frames_v, 1.0f}, sf::Color{255, 255, 255, 120});
+	for (std::size_t i = 0; i < graph_frames_v; ++i) {
+		auto const ms = m_frame_times[(m_next_frame + i) % graph_frames_v] * 1000.0f;
+		auto const height = std::min(ms * graph_ms_scale_v, graph_height_v);
+		append_quad(m_graph, {x, bottom - height}, {bar_width_v, height}, bar_colour(ms));
+		x += bar_width_v;
+	}
+}
+
+void metrics_overlay::draw(sf::RenderTarget& target) const {
+	if (!m_visible) { return; }
+	auto const view = target.getView();
+	auto const& default_view = target.getDefaultView();
+	target.setView(default_view);
+	auto const size = target.getSize();
+	auto states = sf::RenderStates{};
+	// graph sits in the bottom left corner, text in the top left
+	states.transform.translate({0.0f, static_cast<float>(size.y) - graph_height_v - 16.0f});
+	if (!m_graph.empty()) { target.draw(m_graph.data(), m_graph.size(), sf::PrimitiveType::Triangles, states); }
+	if (m_label) { target.draw(*m_label); }
+	target.setView(view);
+}
+} // namespace carise
@@ -0,0 +1,48 @@
+#pragma once
+#include <carise/core/metrics.hpp>
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace carise {
+///
+/// \brief In-game view of a metrics registry: a frame time graph plus one text line per metric.
+///
+/// Text is rebuilt at refresh_interval rather than every frame, and nothing is collected while hidden.
+/// The graph needs no font; text is shown once set_font() has been called.
+///
+class metrics_overlay {
+  public:
+	static constexpr std::size_t graph_frames_v{240};
+	static constexpr float refresh_interval_v{0.25f};
+
+	explicit metrics_overlay(metrics::registry const& registry) : m_registry(registry) {}
+
+	void set_font(sf::Font const& font);
+	void set_visible(bool const visible) { m_visible = visible; }
+	void toggle() { m_visible = !m_visible; }
+	[[nodiscard]] auto is_visible() const -> bool { return m_visible; }
+
+	void push_frame_time(float seconds);
+	void update(float dt);
+	void draw(sf::RenderTarget& target) const;
+
+  private:
+	void rebuild_text();
+	void rebuild_graph();
+
+	metrics::registry const& m_registry;
+	std::vector<metrics::sample> m_samples{};
+	std::string m_text{};
+	std::optional<sf::Text> m_label{};
+
+	std::array<float, graph_frames_v> m_frame_times{};
+	std::size_t m_next_frame{};
+	std::vector<sf::Vertex> m_graph{};
+
+	float m_since_refresh{refresh_interval_v};
+	bool m_visible{};
+};
+} // namespace carise
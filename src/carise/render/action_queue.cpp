@@ -0,0 +1,124 @@
+#include <carise/render/action_queue.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace carise {
+namespace {
+auto smoothstep(float const t) -> float { return t * t * (3.0f - 2.0f * t); }
+} // namespace
+
+action_queue::action_queue(config const& cfg)
+	: m_config(cfg), m_skipped_total(metrics::global().get_counter("carise_actions_skipped_total", "Turns of visual actions skipped to keep up with input")) {}
+
+void action_queue::push(visual_action const& action) {
+	if (m_actions.empty() || m_actions.back().turn != action.turn) { ++m_turns; }
+	m_actions.push_back(action);
+	if (action.kind == action_kind::projectile) { return; }
+	// the actor stays where it was before the queued turns until its first action plays
+	++m_held.try_emplace(action.actor, held{.position = action.from}).first->second.pending;
+}
+
+void action_queue::update(float const dt, bool const input_pending) {
+	m_skipped = 0;
+	m_projectiles.clear();
+	if (m_actions.empty()) { return; }
+	if (input_pending || m_config.speed <= 0.0f) {
+		skip_all();
+		return;
+	}
+	while (m_turns > m_config.max_turns + 1) {
+		finish_group();
+		++m_skipped;
+		// the front group was the one playing: the next starts from its beginning
+		m_elapsed = 0.0f;
+	}
+	if (m_skipped > 0) { m_skipped_total.add(m_skipped); }
+
+	m_elapsed += dt * m_config.speed;
+	auto count = group_size();
+	auto group_duration = 0.0f;
+	for (std::size_t i = 0; i < count; ++i) { group_duration = std::max(group_duration, duration(m_actions[i])); }
+	// leftover time carries into the next turn so playback keeps pace with the configured speed
+	while (m_elapsed >= group_duration) {
+		m_elapsed -= group_duration;
+		finish_group();
+		if (m_actions.empty()) {
+			m_elapsed = 0.0f;
+			return;
+		}
+		count = group_size();
+		group_duration = 0.0f;
+		for (std::size_t i = 0; i < count; ++i) { group_duration = std::max(group_duration, duration(m_actions[i])); }
+	}
+	for (std::size_t i = 0; i < count; ++i) {
+		auto const& action = m_actions[i];
+		auto const length = duration(action);
+		present(action, length > 0.0f ? std::min(m_elapsed / length, 1.0f) : 1.0f);
+	}
+}
+
+void action_queue::skip_all() {
+	auto skipped = std::size_t{};
+	while (!m_actions.empty()) {
+		finish_group();
+		++skipped;
+	}
+	m_projectiles.clear();
+	m_elapsed = 0.0f;
+	m_skipped += skipped;
+	if (skipped > 0) { m_skipped_total.add(skipped); }
+}
+
+auto action_queue::position(actor_id const actor, sf::Vector2f const logical) const -> sf::Vector2f {
+	auto const it = m_held.find(actor);
+	return it == m_held.end() ? logical : it->second.position;
+}
+
+auto action_queue::duration(visual_action const& action) const -> float {
+	switch (action.kind) {
+	case action_kind::move: return m_config.move_seconds;
+	case action_kind::attack: return m_config.attack_seconds;
+	case action_kind::projectile: {
+		auto const delta = action.to - action.from;
+		return m_config.projectile_speed > 0.0f ? std::hypot(delta.x, delta.y) / m_config.projectile_speed : 0.0f;
+	}
+	}
+	return 0.0f;
+}
+
+auto action_queue::group_size() const -> std::size_t {
+	auto const turn = m_actions.front().turn;
+	auto const it = std::find_if(m_actions.begin(), m_actions.end(), [turn](visual_action const& a) { return a.turn != turn; });
+	return static_cast<std::size_t>(it - m_actions.begin());
+}
+
+void action_queue::finish_group() {
+	auto const count = group_size();
+	for (std::size_t i = 0; i < count; ++i) {
+		auto const& action = m_actions.front();
+		if (action.kind != action_kind::projectile) {
+			auto const it = m_held.find(action.actor);
+			if (action.kind == action_kind::move) { it->second.position = action.to; }
+			if (action.kind == action_kind::attack) { it->second.position = action.from; }
+			if (--it->second.pending == 0) { m_held.erase(it); }
+		}
+		m_actions.pop_front();
+	}
+	--m_turns;
+}
+
+void action_queue::present(visual_action const& action, float const t) {
+	auto const delta = action.to - action.from;
+	switch (action.kind) {
+	case action_kind::move: m_held[action.actor].position = action.from + delta * smoothstep(t); break;
+	case action_kind::attack: m_held[action.actor].position = action.from + delta * (m_config.lunge * std::sin(t * std::numbers::pi_v<float>)); break;
+	case action_kind::projectile:
+		if (t < 1.0f) {
+			auto const length = std::hypot(delta.x, delta.y);
+			m_projectiles.push_back(projectile{.position = action.from + delta * t, .direction = length > 0.0f ? delta / length : sf::Vector2f{}});
+		}
+		break;
+	}
+}
+} // namespace carise
@@ -0,0 +1,105 @@
+#pragma once
+#include <carise/core/metrics.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace carise {
+using actor_id = std::uint32_t;
+
+enum class action_kind : std::uint8_t { move, attack, projectile };
+
+///
+/// \brief Something the simulation resolved that the player should see happen.
+///
+/// For attacks, to is the target's position; projectiles fly from -> to and do not hold their actor.
+///
+struct visual_action {
+	action_kind kind{};
+	actor_id actor{};
+	sf::Vector2f from{};
+	sf::Vector2f to{};
+	/// \brief Actions of the same turn play together.
+	std::uint32_t turn{};
+};
+
+///
+/// \brief Plays back resolved turns after the fact, so turn resolution never waits on animation.
+///
+/// The simulation resolves as many turns as it likes in one frame and push()es what happened; update()
+/// then plays the queued turns one after another at the configured speed. Actors with queued actions
+/// are drawn at position() instead of their logical position until their last action finished.
+///
+/// Playback never holds up the player: pending input or more than max_turns queued turns snap the
+/// oldest turns to their end state. When idle() the main loop has nothing to animate and can stop
+/// redrawing every frame.
+///
+class action_queue {
+  public:
+	struct config {
+		/// \brief Playback speed multiplier; zero or less presents every action instantly.
+		float speed{1.0f};
+		float move_seconds{0.1f};
+		float attack_seconds{0.15f};
+		/// \brief World units per second.
+		float projectile_speed{800.0f};
+		/// \brief Fraction of the distance to the target an attacker lunges.
+		float lunge{0.3f};
+		/// \brief Turns allowed to wait behind the playing one before the oldest are skipped.
+		std::size_t max_turns{4};
+	};
+
+	struct projectile {
+		sf::Vector2f position{};
+		sf::Vector2f direction{};
+	};
+
+	action_queue() : action_queue(config{}) {}
+	explicit action_queue(config const& cfg);
+
+	void push(visual_action const& action);
+	void set_speed(float const speed) { m_config.speed = speed; }
+	[[nodiscard]] auto speed() const -> float { return m_config.speed; }
+
+	///
+	/// \brief Advance playback by dt seconds.
+	/// \param input_pending The player acted this frame: finish everything queued so their new turn shows at once.
+	///
+	void update(float dt, bool input_pending = false);
+	/// \brief Snap every queued action to its end state.
+	void skip_all();
+
+	/// \brief Where to draw actor: its animated position while it has queued actions, otherwise logical.
+	[[nodiscard]] auto position(actor_id actor, sf::Vector2f logical) const -> sf::Vector2f;
+	/// \brief Projectiles in flight after the last update().
+	[[nodiscard]] auto projectiles() const -> std::span<projectile const> { return m_projectiles; }
+	[[nodiscard]] auto idle() const -> bool { return m_actions.empty(); }
+	[[nodiscard]] auto queued_turns() const -> std::size_t { return m_turns; }
+	/// \brief Turns skipped by the last update().
+	[[nodiscard]] auto skipped() const -> std::size_t { return m_skipped; }
+
+  private:
+	struct held {
+		sf::Vector2f position{};
+		std::uint32_t pending{};
+	};
+
+	[[nodiscard]] auto duration(visual_action const& action) const -> float;
+	[[nodiscard]] auto group_size() const -> std::size_t;
+	void finish_group();
+	void present(visual_action const& action, float t);
+
+	config m_config;
+	std::deque<visual_action> m_actions{};
+	std::unordered_map<actor_id, held> m_held{};
+	std::vector<projectile> m_projectiles{};
+	/// \brief Seconds into the playing turn.
+	float m_elapsed{};
+	std::size_t m_turns{};
+	std::size_t m_skipped{};
+	metrics::counter& m_skipped_total;
+};
+} // namespace carise
@@ -0,0 +1,128 @@
+#include <carise/core/log.hpp>
+#include <carise/render/animation.hpp>
+#include <carise/render/vertices.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace carise {
+auto animation_library::add_clip(std::span<tile_id const> const frames, float const fps, bool const loop) -> clip_id {
+	if (frames.empty() || fps <= 0.0f || m_clips.size() >= no_clip_v) {
+		CARISE_LOG_WARN("animation: invalid clip ({} frames at {} fps)", frames.size(), fps);
+		return no_clip_v;
+	}
+	m_clips.push_back(clip{
+		.first = static_cast<std::uint32_t>(m_frames.size()),
+		.count = static_cast<std::uint32_t>(frames.size()),
+		.frame_time = 1.0f / fps,
+		.loop = loop,
+	});
+	m_frames.insert(m_frames.end(), frames.begin(), frames.end());
+	return static_cast<clip_id>(m_clips.size() - 1);
+}
+
+void animation_library::set_tile_animation(tile_id const base, clip_id const clip) {
+	if (clip >= m_clips.size()) {
+		CARISE_LOG_WARN("animation: tile {} given unknown clip {}", base, clip);
+		return;
+	}
+	if (base >= m_tile_clips.size()) { m_tile_clips.resize(std::size_t{base} + 1, no_clip_v); }
+	m_tile_clips[base] = clip;
+}
+
+auto animation_library::frame_at(clip_id const clip, float const seconds) const -> tile_id {
+	auto const& c = m_clips[clip];
+	auto const index = static_cast<std::uint64_t>(std::max(seconds, 0.0f) / c.frame_time);
+	return m_frames[c.first + static_cast<std::uint32_t>(c.loop ? index % c.count : std::min<std::uint64_t>(index, c.count - 1))];
+}
+
+auto animation_system::play(clip_id const clip, std::uint32_t const quad, float const speed, float const start) -> instance_id {
+	if (clip >= m_library.clip_count()) {
+		CARISE_LOG_WARN("animation: cannot play unknown clip {}", clip);
+		return no_instance_v;
+	}
+	auto id = instance_id{};
+	if (m_free.empty()) {
+		id = static_cast<instance_id>(m_dense.size());
+		m_dense.push_back(free_v);
+	} else {
+		id = m_free.back();
+		m_free.pop_back();
+	}
+	m_dense[id] = static_cast<std::uint32_t>(m_clip.size());
+	m_clip.push_back(clip);
+	m_time.push_back(start);
+	m_speed.push_back(speed);
+	// never a real frame: the first update() reports the quad as changed
+	m_frame.push_back(no_tile_v);
+	m_quad.push_back(quad);
+	m_owner.push_back(id);
+	return id;
+}
+
+void animation_system::set_clip(instance_id const id, clip_id const clip) {
+	if (clip >= m_library.clip_count()) {
+		CARISE_LOG_WARN("animation: cannot switch to unknown clip {}", clip);
+		return;
+	}
+	auto const i = m_dense[id];
+	if (m_clip[i] == clip) { return; }
+	m_clip[i] = clip;
+	m_time[i] = 0.0f;
+	m_frame[i] = no_tile_v;
+}
+
+void animation_system::set_speed(instance_id const id, float const speed) { m_speed[m_dense[id]] = speed; }
+
+void animation_system::remove(instance_id const id) {
+	auto const i = m_dense[id];
+	auto const last = static_cast<std::uint32_t>(m_clip.size() - 1);
+	if (i != last) {
+		m_clip[i] = m_clip[last];
+		m_time[i] = m_time[last];
+		m_speed[i] = m_speed[last];
+		m_frame[i] = m_frame[last];
+		m_quad[i] = m_quad[last];
+		m_owner[i] = m_owner[last];
+		m_dense[m_owner[i]] = i;
+	}
+	m_clip.pop_back();
+	m_time.pop_back();
+	m_speed.pop_back();
+	m_frame.pop_back();
+	m_quad.pop_back();
+	m_owner.pop_back();
+	m_dense[id] = free_v;
+	m_free.push_back(id);
+}
+
+void animation_system::update(float const dt) {
+	m_changed.clear();
+	for (std::size_t i = 0; i < m_clip.size(); ++i) {
+		auto const clip = m_clip[i];
+		auto time = m_time[i] + dt * m_speed[i];
+		// wrap looping clips so time stays small and precise however long they run
+		if (m_library.loops(clip)) {
+			auto const duration = m_library.duration(clip);
+			time = std::fmod(time, duration);
+			if (time < 0.0f) { time += duration; }
+		}
+		m_time[i] = time;
+		auto const frame = m_library.frame_at(clip, time);
+		if (frame == m_frame[i]) { continue; }
+		m_frame[i] = frame;
+		m_changed.emplace_back(m_quad[i], frame);
+	}
+}
+
+void animation_system::write_uvs(std::span<sf::Vertex> const vertices, tile_atlas const& atlas) const {
+	for (auto const& [quad, frame] : m_changed) {
+		if (std::size_t{quad} * 6 + 6 > vertices.size()) { continue; }
+		set_quad_uv(vertices.data() + std::size_t{quad} * 6, atlas.uv(frame), atlas.tile_size());
+	}
+}
+
+auto animation_system::finished(instance_id const id) const -> bool {
+	auto const i = m_dense[id];
+	return !m_library.loops(m_clip[i]) && m_time[i] >= m_library.duration(m_clip[i]);
+}
+} // namespace carise
@@ -0,0 +1,99 @@
+#pragma once
+#include <carise/render/tile_atlas.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace carise {
+using clip_id = std::uint16_t;
+
+inline constexpr clip_id no_clip_v{0xffff};
+
+///
+/// \brief Animation clips (sequences of atlas tiles) and which map tiles loop which clip.
+///
+/// Looping clips are functions of time alone, so every tile showing one (water, torches, ...) can be
+/// evaluated from a global clock without any per-tile state.
+///
+class animation_library {
+  public:
+	[[nodiscard]] auto add_clip(std::span<tile_id const> frames, float fps, bool loop = true) -> clip_id;
+	/// \brief Map tiles with id base animate through clip wherever they are drawn by tile_map_renderer; unknown clips are ignored.
+	void set_tile_animation(tile_id base, clip_id clip);
+
+	[[nodiscard]] auto clip_count() const -> std::size_t { return m_clips.size(); }
+	[[nodiscard]] auto tile_clip(tile_id const base) const -> clip_id { return base < m_tile_clips.size() ? m_tile_clips[base] : no_clip_v; }
+	[[nodiscard]] auto frame_count(clip_id const clip) const -> std::size_t { return m_clips[clip].count; }
+	[[nodiscard]] auto loops(clip_id const clip) const -> bool { return m_clips[clip].loop; }
+	[[nodiscard]] auto duration(clip_id const clip) const -> float { return static_cast<float>(m_clips[clip].count) * m_clips[clip].frame_time; }
+	/// \brief Frame shown seconds after the clip started; looping clips wrap, others hold their last frame.
+	[[nodiscard]] auto frame_at(clip_id clip, float seconds) const -> tile_id;
+
+  private:
+	struct clip {
+		std::uint32_t first{};
+		std::uint32_t count{};
+		float frame_time{};
+		bool loop{};
+	};
+
+	std::vector<clip> m_clips{};
+	std::vector<tile_id> m_frames{};
+	std::vector<clip_id> m_tile_clips{};
+};
+
+///
+/// \brief Per-sprite animation state in dense arrays, advanced in one pass per frame.
+///
+/// Each instance animates one quad of a caller-owned vertex array (six vertices from append_quad(), at
+/// quad * 6). update() advances every instance and records only the quads whose frame changed;
+/// write_uvs() then patches those texture coordinates in place, so a batch of sprites is never rebuilt
+/// for animation.
+///
+class animation_system {
+  public:
+	/// \brief Stable handle; dense storage is compacted on removal.
+	using instance_id = std::uint32_t;
+
+	static constexpr instance_id no_instance_v{0xffffffff};
+
+	explicit animation_system(animation_library const& library) : m_library(library) {}
+
+	/// \returns no_instance_v if clip is not in the library (including no_clip_v)
+	[[nodiscard]] auto play(clip_id clip, std::uint32_t quad, float speed = 1.0f, float start = 0.0f) -> instance_id;
+	/// \brief Switch clip, restarting it; does nothing if already playing clip or clip is not in the library.
+	void set_clip(instance_id id, clip_id clip);
+	void set_speed(instance_id id, float speed);
+	void remove(instance_id id);
+
+	void update(float dt);
+	/// \brief Write the frames changed by the last update() into vertices.
+	void write_uvs(std::span<sf::Vertex> vertices, tile_atlas const& atlas) const;
+
+	/// \brief Non-looping clips that reached their last frame.
+	[[nodiscard]] auto finished(instance_id id) const -> bool;
+	[[nodiscard]] auto frame(instance_id const id) const -> tile_id { return m_frame[m_dense[id]]; }
+	[[nodiscard]] auto size() const -> std::size_t { return m_clip.size(); }
+	/// \brief Quads changed by the last update().
+	[[nodiscard]] auto changed() const -> std::size_t { return m_changed.size(); }
+
+  private:
+	static constexpr std::uint32_t free_v{0xffffffff};
+
+	animation_library const& m_library;
+	// dense, one entry per live instance
+	std::vector<clip_id> m_clip{};
+	std::vector<float> m_time{};
+	std::vector<float> m_speed{};
+	std::vector<tile_id> m_frame{};
+	std::vector<std::uint32_t> m_quad{};
+	std::vector<instance_id> m_owner{};
+	/// \brief Instance id to dense index, or free_v.
+	std::vector<std::uint32_t> m_dense{};
+	std::vector<instance_id> m_free{};
+	/// \brief (quad, frame) pairs written by write_uvs().
+	std::vector<std::pair<std::uint32_t, tile_id>> m_changed{};
+};
+} // namespace carise
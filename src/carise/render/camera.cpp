@@ -0,0 +1,31 @@
+#include <carise/render/camera.hpp>
+#include <algorithm>
+
+namespace carise {
+camera::camera(sf::Vector2f const viewport, config const& cfg) : m_config(cfg), m_viewport(viewport), m_center(viewport / 2.0f) { refresh(); }
+
+void camera::resize(sf::Vector2f const viewport) {
+	m_viewport = viewport;
+	refresh();
+}
+
+void camera::set_center(sf::Vector2f const center) {
+	m_center = center;
+	refresh();
+}
+
+void camera::set_zoom(float const zoom) {
+	m_zoom = std::clamp(zoom, m_config.min_zoom, m_config.max_zoom);
+	refresh();
+}
+
+void camera::zoom_at(sf::Vector2f const screen_pos, float const factor) {
+	auto const anchor = to_world(screen_pos);
+	set_zoom(m_zoom * factor);
+	// shift so anchor maps back to screen_pos at the new zoom
+	m_center += anchor - to_world(screen_pos);
+	refresh();
+}
+
+auto camera::to_world(sf::Vector2f const screen_pos) const -> sf::Vector2f { return m_center + (screen_pos - m_viewport / 2.0f) / m_zoom; }
+} // namespace carise
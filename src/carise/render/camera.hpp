@@ -0,0 +1,47 @@
+#pragma once
+#include <carise/render/view_bounds.hpp>
+#include <SFML/Graphics.hpp>
+
+namespace carise {
+///
+/// \brief Pan and zoom state of the world view.
+///
+/// Produces the sf::View every map renderer culls against; zoom is in screen pixels per world unit, so a
+/// renderer can tell how many pixels a tile covers and pick a level of detail. Views are never rotated
+/// (view_bounds() relies on that).
+///
+class camera {
+  public:
+	struct config {
+		float min_zoom{1.0f / 64.0f};
+		float max_zoom{8.0f};
+	};
+
+	explicit camera(sf::Vector2f const viewport) : camera(viewport, config{}) {}
+	camera(sf::Vector2f viewport, config const& cfg);
+
+	/// \brief Keep the zoom and centre when the window is resized.
+	void resize(sf::Vector2f viewport);
+	void set_center(sf::Vector2f center);
+	void pan(sf::Vector2f world_delta) { set_center(m_center + world_delta); }
+	void set_zoom(float zoom);
+	/// \brief Scale the zoom by factor, keeping the world point under screen_pos in place.
+	void zoom_at(sf::Vector2f screen_pos, float factor);
+
+	[[nodiscard]] auto view() const -> sf::View const& { return m_view; }
+	[[nodiscard]] auto center() const -> sf::Vector2f { return m_center; }
+	[[nodiscard]] auto zoom() const -> float { return m_zoom; }
+	[[nodiscard]] auto viewport() const -> sf::Vector2f { return m_viewport; }
+	[[nodiscard]] auto bounds() const -> aabb { return view_bounds(m_view); }
+	[[nodiscard]] auto to_world(sf::Vector2f screen_pos) const -> sf::Vector2f;
+
+  private:
+	void refresh() { m_view = sf::View{m_center, m_viewport / m_zoom}; }
+
+	config m_config;
+	sf::Vector2f m_viewport{};
+	sf::Vector2f m_center{};
+	float m_zoom{1.0f};
+	sf::View m_view{};
+};
+} // namespace carise
@@ -0,0 +1,107 @@
+#include <carise/render/glyph_run.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace carise {
+namespace {
+// font pages keep a white square at texel (1, 1) that sf::Text also samples for its lines
+constexpr sf::Vector2f white_texel_v{1.0f, 1.0f};
+
+void append_line(std::vector<sf::Vertex>& out, float const length, float const baseline, float const offset, float const thickness) {
+	auto const top = std::floor(baseline + offset - thickness / 2.0f + 0.5f);
+	auto const bottom = top + std::floor(thickness + 0.5f);
+	auto const tl = sf::Vertex{{0.0f, top}, sf::Color::White, white_texel_v};
+	auto const br = sf::Vertex{{length, bottom}, sf::Color::White, white_texel_v};
+	out.push_back(tl);
+	out.push_back(sf::Vertex{{length, top}, sf::Color::White, white_texel_v});
+	out.push_back(br);
+	out.push_back(tl);
+	out.push_back(br);
+	out.push_back(sf::Vertex{{0.0f, bottom}, sf::Color::White, white_texel_v});
+}
+
+void append_glyph(std::vector<sf::Vertex>& out, sf::Vector2f const pen, sf::Glyph const& glyph, float const shear) {
+	// one texel of padding, as sf::Text, so smoothed edges are not clipped
+	auto const left = glyph.bounds.left - 1.0f;
+	auto const top = glyph.bounds.top - 1.0f;
+	auto const right = glyph.bounds.left + glyph.bounds.width + 1.0f;
+	auto const bottom = glyph.bounds.top + glyph.bounds.height + 1.0f;
+	auto const u1 = static_cast<float>(glyph.textureRect.left) - 1.0f;
+	auto const v1 = static_cast<float>(glyph.textureRect.top) - 1.0f;
+	auto const u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + 1.0f;
+	auto const v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + 1.0f;
+	auto const tl = sf::Vertex{{pen.x + left - shear * top, pen.y + top}, sf::Color::White, {u1, v1}};
+	auto const br = sf::Vertex{{pen.x + right - shear * bottom, pen.y + bottom}, sf::Color::White, {u2, v2}};
+	out.push_back(tl);
+	out.push_back(sf::Vertex{{pen.x + right - shear * top, pen.y + top}, sf::Color::White, {u2, v1}});
+	out.push_back(br);
+	out.push_back(tl);
+	out.push_back(br);
+	out.push_back(sf::Vertex{{pen.x + left - shear * bottom, pen.y + bottom}, sf::Color::White, {u1, v2}});
+}
+} // namespace
+
+auto next_code_point(std::string_view const str, std::size_t& pos) -> std::uint32_t {
+	auto const lead = static_cast<std::uint8_t>(str[pos++]);
+	auto const trailing = lead >= 0xf0 ? 3u : lead >= 0xe0 ? 2u : lead >= 0xc0 ? 1u : 0u;
+	if (trailing == 0 || pos + trailing > str.size()) { return lead; }
+	auto ret = static_cast<std::uint32_t>(lead & (0x3f >> trailing));
+	for (auto i = 0u; i < trailing; ++i) {
+		auto const byte = static_cast<std::uint8_t>(str[pos + i]);
+		if ((byte & 0xc0) != 0x80) { return lead; }
+		ret = (ret << 6) | (byte & 0x3f);
+	}
+	pos += trailing;
+	return ret;
+}
+
+auto shape_text(sf::Font const& font, std::string_view const utf8, unsigned int const character_size, std::uint32_t const style) -> glyph_run {
+	auto ret = glyph_run{};
+	auto const bold = (style & sf::Text::Bold) != 0;
+	auto const underlined = (style & sf::Text::Underlined) != 0;
+	auto const strike_through = (style & sf::Text::StrikeThrough) != 0;
+	auto const shear = (style & sf::Text::Italic) != 0 ? italic_shear_v : 0.0f;
+	auto const whitespace = font.getGlyph(U' ', character_size, bold).advance;
+	auto const line_spacing = font.getLineSpacing(character_size);
+	auto const underline_offset = font.getUnderlinePosition(character_size);
+	auto const underline_thickness = font.getUnderlineThickness(character_size);
+	auto const x_bounds = font.getGlyph(U'x', character_size, bold).bounds;
+	auto const strike_offset = x_bounds.top + x_bounds.height / 2.0f;
+
+	auto const end_line = [&](float const length, float const baseline) {
+		if (length <= 0.0f) { return; }
+		if (underlined) { append_line(ret.vertices, length, baseline, underline_offset, underline_thickness); }
+		if (strike_through) { append_line(ret.vertices, length, baseline, strike_offset, underline_thickness); }
+	};
+
+	auto pen = sf::Vector2f{0.0f, static_cast<float>(character_size)};
+	auto width = 0.0f;
+	auto previous = std::uint32_t{};
+	for (std::size_t pos = 0; pos < utf8.size();) {
+		auto const code_point = next_code_point(utf8, pos);
+		if (code_point == U'\r') { continue; }
+		pen.x += font.getKerning(previous, code_point, character_size, bold);
+		previous = code_point;
+		switch (code_point) {
+		case U' ': pen.x += whitespace; break;
+		case U'\t': pen.x += whitespace * 4.0f; break;
+		case U'\n':
+			end_line(pen.x, pen.y);
+			width = std::max(width, pen.x);
+			pen = {0.0f, pen.y + line_spacing};
+			break;
+		default: {
+			auto const& glyph = font.getGlyph(code_point, character_size, bold);
+			append_glyph(ret.vertices, pen, glyph, shear);
+			pen.x += glyph.advance;
+			break;
+		}
+		}
+	}
+	end_line(pen.x, pen.y);
+	ret.size = {std::max(width, pen.x), pen.y - static_cast<float>(character_size) + line_spacing};
+	// fetched last: shaping may have added glyphs to (and grown) the page
+	ret.texture = &font.getTexture(character_size);
+	return ret;
+}
+} // namespace carise
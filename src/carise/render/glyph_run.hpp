@@ -0,0 +1,47 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace carise {
+///
+/// \brief Text shaped into textured quads, ready to be copied into any vertex array.
+///
+/// The same layout sf::Text produces (kerning, bold, italic shear, underline, strike through), but kept as
+/// plain vertices so a string is shaped once and then drawn, moved or tinted without touching the font.
+///
+struct glyph_run {
+	/// \brief Two triangles per glyph, relative to the top left of the first line, coloured white.
+	std::vector<sf::Vertex> vertices{};
+	/// \brief Font page the texture coordinates refer to; null when nothing was shaped.
+	sf::Texture const* texture{};
+	/// \brief Width of the longest line by the height of all lines.
+	sf::Vector2f size{};
+};
+
+/// \brief Slant of italic text, as sf::Text applies it (12 degrees).
+inline constexpr float italic_shear_v{0.20944f};
+
+/// \brief Decode one UTF-8 code point, advancing pos; malformed bytes decode as themselves.
+[[nodiscard]] auto next_code_point(std::string_view str, std::size_t& pos) -> std::uint32_t;
+
+///
+/// \brief Shape a UTF-8 string.
+///
+/// Texture coordinates are in pixels of font.getTexture(character_size), which stays valid as the page grows.
+/// Newlines start a new line and tabs advance four spaces.
+///
+[[nodiscard]] auto shape_text(sf::Font const& font, std::string_view utf8, unsigned int character_size, std::uint32_t style = sf::Text::Regular)
+	-> glyph_run;
+
+/// \brief Append run to out translated by origin and tinted colour.
+template <typename Vertices>
+void append_run(Vertices& out, glyph_run const& run, sf::Vector2f const origin, sf::Color const colour) {
+	for (auto vertex : run.vertices) {
+		vertex.position += origin;
+		vertex.color = colour;
+		out.push_back(vertex);
+	}
+}
+} // namespace carise
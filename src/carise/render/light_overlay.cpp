@@ -0,0 +1,75 @@
+#include <carise/core/log.hpp>
+#include <carise/render/light_overlay.hpp>
+#include <carise/render/texture_memory.hpp>
+#include <carise/render/vertices.hpp>
+#include <carise/render/view_bounds.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace carise {
+namespace {
+constexpr auto stale_v{std::numeric_limits<std::uint64_t>::max()};
+}
+
+auto light_overlay::create(light_grid const& grid) -> bool {
+	auto const size = sf::Vector2u{static_cast<unsigned int>(grid.size().x), static_cast<unsigned int>(grid.size().y)};
+	m_size = {};
+	if (size.x == 0 || size.y == 0) { return false; }
+	if (size.x > sf::Texture::getMaximumSize() || size.y > sf::Texture::getMaximumSize()) {
+		CARISE_LOG_WARN("light overlay: {}x{} grid exceeds the maximum texture size", size.x, size.y);
+		return false;
+	}
+	if (!m_texture.create(size)) { return false; }
+	m_texture.setSmooth(true);
+	m_texture_bytes = track_texture(m_texture);
+	m_size = grid.size();
+	m_revisions.assign(static_cast<std::size_t>(grid.chunk_count().x * grid.chunk_count().y), stale_v);
+	return true;
+}
+
+void light_overlay::update(light_grid const& grid, sf::View const& view) {
+	m_uploaded = 0;
+	if (grid.size() != m_size && !create(grid)) {
+		CARISE_LOG_WARN("light overlay: failed to create for {}x{} grid", grid.size().x, grid.size().y);
+		return;
+	}
+	// one tile of margin: filtering reads the neighbouring texel at the view's edge
+	auto box = view_bounds(view);
+	box.min -= m_tile_size;
+	box.max += m_tile_size;
+	auto const chunk_world = m_tile_size * static_cast<float>(tile_map::chunk_size_v);
+	auto const [lo, hi] = cell_range(box, chunk_world, grid.chunk_count());
+	for (int cy = lo.y; cy < hi.y; ++cy) {
+		for (int cx = lo.x; cx < hi.x; ++cx) {
+			if (m_revisions[static_cast<std::size_t>(cy * grid.chunk_count().x + cx)] != grid.chunk_revision({cx, cy})) { upload(grid, {cx, cy}); }
+		}
+	}
+}
+
+void light_overlay::upload(light_grid const& grid, sf::Vector2i const chunk) {
+	auto const origin = chunk * tile_map::chunk_size_v;
+	auto const extent = sf::Vector2i{std::min(tile_map::chunk_size_v, m_size.x - origin.x), std::min(tile_map::chunk_size_v, m_size.y - origin.y)};
+	auto const row = static_cast<std::size_t>(extent.x) * 4;
+	m_scratch.resize(row * static_cast<std::size_t>(extent.y));
+	for (int y = 0; y < extent.y; ++y) { std::copy_n(grid.texels(origin + sf::Vector2i{0, y}), row, m_scratch.data() + static_cast<std::size_t>(y) * row); }
+	m_texture.update(m_scratch.data(), {static_cast<unsigned int>(extent.x), static_cast<unsigned int>(extent.y)},
+					 {static_cast<unsigned int>(origin.x), static_cast<unsigned int>(origin.y)});
+	m_revisions[static_cast<std::size_t>(chunk.y * grid.chunk_count().x + chunk.x)] = grid.chunk_revision(chunk);
+	++m_uploaded;
+}
+
+void light_overlay::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+	if (m_size.x == 0 || m_size.y == 0) { return; }
+	auto const [lo, hi] = cell_range(view_bounds(target.getView()), m_tile_size, m_size);
+	if (lo.x >= hi.x || lo.y >= hi.y) { return; }
+	auto const tile_lo = sf::Vector2f{static_cast<float>(lo.x), static_cast<float>(lo.y)};
+	auto const tiles = sf::Vector2f{static_cast<float>(hi.x - lo.x), static_cast<float>(hi.y - lo.y)};
+	m_quad.clear();
+	// texture coordinates in texels (= tiles), so a texel centre lands on its tile's centre
+	append_quad(m_quad, {tile_lo.x * m_tile_size.x, tile_lo.y * m_tile_size.y}, {tiles.x * m_tile_size.x, tiles.y * m_tile_size.y}, sf::Color::White, tile_lo,
+				tiles);
+	states.texture = &m_texture;
+	states.blendMode = sf::BlendMultiply;
+	target.draw(m_quad.data(), m_quad.size(), sf::PrimitiveType::Triangles, states);
+}
+} // namespace carise
@@ -0,0 +1,49 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <carise/world/light_grid.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace carise {
+///
+/// \brief Multiplies a light_grid over whatever was drawn beneath it, one smoothly filtered texel per tile.
+///
+/// The grid lives in a texture the size of the map. update() re-uploads only chunks in view whose light
+/// revision changed since they were last uploaded; chunks that change off screen wait until they scroll in.
+/// draw() is a single quad with a multiply blend, so the tile layers underneath (static_layer_cache,
+/// shader_tile_map, ...) keep their cached geometry however often the lighting changes.
+///
+/// Texels sit at tile centres and are bilinearly filtered, so light shades smoothly across tile edges.
+///
+class light_overlay {
+  public:
+	explicit light_overlay(sf::Vector2f const tile_size) : m_tile_size(tile_size) {}
+
+	///
+	/// \brief Size the texture for grid; its contents are uploaded by the following update().
+	/// \returns false if the grid exceeds the maximum texture size
+	///
+	[[nodiscard]] auto create(light_grid const& grid) -> bool;
+	/// \brief Upload chunks in view whose light changed (recreates on a resized grid).
+	void update(light_grid const& grid, sf::View const& view);
+	/// \brief Multiply the light over the part of the grid visible in target's current view.
+	void draw(sf::RenderTarget& target, sf::RenderStates states = {}) const;
+
+	/// \brief Chunks uploaded by the last update().
+	[[nodiscard]] auto uploaded() const -> std::size_t { return m_uploaded; }
+
+  private:
+	void upload(light_grid const& grid, sf::Vector2i chunk);
+
+	sf::Vector2f m_tile_size;
+	sf::Texture m_texture{};
+	memory::tracked_bytes m_texture_bytes{};
+	sf::Vector2i m_size{};
+	/// \brief Light revision of each chunk as uploaded.
+	std::vector<std::uint64_t> m_revisions{};
+	std::vector<std::uint8_t> m_scratch{};
+	mutable std::vector<sf::Vertex> m_quad{};
+	std::size_t m_uploaded{};
+};
+} // namespace carise
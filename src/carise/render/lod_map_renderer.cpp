@@ -0,0 +1,25 @@
+#include <carise/render/lod_map_renderer.hpp>
+
+namespace carise {
+lod_map_renderer::lod_map_renderer(tile_map_renderer const& renderer, config const& cfg)
+	: m_atlas(renderer.atlas()), m_config(cfg), m_detail(renderer, cfg.detail), m_overview(renderer.atlas(), cfg.overview) {}
+
+void lod_map_renderer::update(tile_map const& map, camera const& cam) {
+	auto const pixels_per_tile = cam.zoom() * m_atlas.tile_size().x;
+	if (cam.zoom() >= m_config.detail_threshold || m_overview.level_count() == 0) {
+		m_level.reset();
+		m_detail.update(map, cam.view());
+		return;
+	}
+	m_level = m_overview.select_level(pixels_per_tile);
+	m_overview.update(map, cam.view(), *m_level);
+}
+
+void lod_map_renderer::draw(sf::RenderTarget& target, sf::RenderStates const states) const {
+	if (m_level) {
+		m_overview.draw(target, *m_level, states);
+	} else {
+		m_detail.draw(target, states);
+	}
+}
+} // namespace carise
@@ -0,0 +1,43 @@
+#pragma once
+#include <carise/render/camera.hpp>
+#include <carise/render/map_overview.hpp>
+#include <carise/render/static_layer_cache.hpp>
+#include <optional>
+
+namespace carise {
+///
+/// \brief Draws a tile_map at a cost bounded by the screen, not by the zoom.
+///
+/// Above detail_threshold screen pixels per tile texel, visible chunks are drawn from static_layer_cache at
+/// full detail; the threshold caps how many chunks can be on screen. Below it the map_overview level with
+/// just enough texels per screen pixel is drawn instead, a few page quads however far the camera zooms out.
+///
+class lod_map_renderer {
+  public:
+	struct config {
+		float detail_threshold{0.5f};
+		static_layer_cache::config detail{};
+		map_overview::config overview{};
+	};
+
+	explicit lod_map_renderer(tile_map_renderer const& renderer) : lod_map_renderer(renderer, config{}) {}
+	lod_map_renderer(tile_map_renderer const& renderer, config const& cfg);
+
+	/// \brief Pick the level for cam's zoom and refresh what it shows (after renderer.update(map)).
+	void update(tile_map const& map, camera const& cam);
+	/// \brief Draw the level picked by the last update(), culled to target's current view.
+	void draw(sf::RenderTarget& target, sf::RenderStates states = {}) const;
+
+	/// \brief Overview level drawn, or nullopt at full detail.
+	[[nodiscard]] auto level() const -> std::optional<std::size_t> { return m_level; }
+	[[nodiscard]] auto detail() const -> static_layer_cache const& { return m_detail; }
+	[[nodiscard]] auto overview() const -> map_overview const& { return m_overview; }
+
+  private:
+	tile_atlas const& m_atlas;
+	config m_config;
+	static_layer_cache m_detail;
+	map_overview m_overview;
+	std::optional<std::size_t> m_level{};
+};
+} // namespace carise
@@ -0,0 +1,231 @@
+#include <carise/core/log.hpp>
+#include <carise/render/map_overview.hpp>
+#include <carise/render/texture_memory.hpp>
+#include <carise/render/vertices.hpp>
+#include <carise/render/view_bounds.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace carise {
+namespace {
+constexpr auto stale_v{std::numeric_limits<std::uint64_t>::max()};
+
+/// \brief Box filter every atlas tile down to texels, averaging colour weighted by alpha.
+auto downsample(sf::Image const& image, tile_atlas const& atlas, sf::Vector2u const texels) -> std::vector<std::uint8_t> {
+	auto const tile = sf::Vector2u{static_cast<unsigned int>(atlas.tile_size().x), static_cast<unsigned int>(atlas.tile_size().y)};
+	auto ret = std::vector<std::uint8_t>(std::size_t{atlas.tile_count()} * texels.x * texels.y * 4);
+	auto* out = ret.data();
+	for (unsigned int id = 0; id < atlas.tile_count(); ++id) {
+		auto const uv = atlas.uv(static_cast<tile_id>(id));
+		auto const origin = sf::Vector2u{static_cast<unsigned int>(uv.x), static_cast<unsigned int>(uv.y)};
+		for (unsigned int ty = 0; ty < texels.y; ++ty) {
+			for (unsigned int tx = 0; tx < texels.x; ++tx) {
+				auto const x0 = tx * tile.x / texels.x;
+				auto const x1 = std::max((tx + 1) * tile.x / texels.x, x0 + 1);
+				auto const y0 = ty * tile.y / texels.y;
+				auto const y1 = std::max((ty + 1) * tile.y / texels.y, y0 + 1);
+				std::uint32_t r{}, g{}, b{}, a{};
+				for (auto y = y0; y < y1; ++y) {
+					for (auto x = x0; x < x1; ++x) {
+						auto const c = image.getPixel(origin + sf::Vector2u{x, y});
+						r += std::uint32_t{c.r} * c.a;
+						g += std::uint32_t{c.g} * c.a;
+						b += std::uint32_t{c.b} * c.a;
+						a += c.a;
+					}
+				}
+				auto const count = (x1 - x0) * (y1 - y0);
+				*out++ = static_cast<std::uint8_t>(a > 0 ? r / a : 0);
+				*out++ = static_cast<std::uint8_t>(a > 0 ? g / a : 0);
+				*out++ = static_cast<std::uint8_t>(a > 0 ? b / a : 0);
+				*out++ = static_cast<std::uint8_t>(a / count);
+			}
+		}
+	}
+	return ret;
+}
+
+/// \brief Wall over floor, the same blend the tile renderers get from drawing walls after floors.
+void blend_over(std::uint8_t* out, std::uint8_t const* floor, std::uint8_t const* wall) {
+	auto const a = std::uint32_t{wall[3]};
+	for (int i = 0; i < 3; ++i) { out[i] = static_cast<std::uint8_t>((floor[i] * (255 - a) + wall[i] * a + 127) / 255); }
+	out[3] = std::max(floor[3], wall[3]);
+}
+} // namespace
+
+map_overview::map_overview(tile_atlas const& atlas, config const& cfg) : m_atlas(atlas), m_config(cfg) {
+	if (auto const* texture = atlas.texture()) {
+		auto const image = texture->copyToImage();
+		auto const tile = sf::Vector2u{static_cast<unsigned int>(atlas.tile_size().x), static_cast<unsigned int>(atlas.tile_size().y)};
+		for (unsigned int shift = 1;; ++shift) {
+			auto const texels = sf::Vector2u{std::max(tile.x >> shift, 1u), std::max(tile.y >> shift, 1u)};
+			m_levels.push_back(level{.texels = texels, .tiles = downsample(image, atlas, texels)});
+			if (texels == sf::Vector2u{1, 1}) { break; }
+		}
+	}
+	m_evictor = memory::global().add_evictor(memory::tag::textures, [this](std::size_t const over) { return evict(over); });
+}
+
+map_overview::~map_overview() { memory::global().remove_evictor(m_evictor); }
+
+auto map_overview::select_level(float const pixels_per_tile) const -> std::size_t {
+	// levels get coarser with the index: take the coarsest one the screen does not magnify
+	for (auto i = m_levels.size(); i-- > 0;) {
+		if (static_cast<float>(m_levels[i].texels.x) >= pixels_per_tile) { return i; }
+	}
+	return 0;
+}
+
+void map_overview::update(tile_map const& map, sf::View const& view, std::size_t const lvl) {
+	++m_frame;
+	m_refreshed = 0;
+	if (lvl >= m_levels.size()) { return; }
+	auto const page_tiles_v = m_config.page_chunks * tile_map::chunk_size_v;
+	if (map.size() != m_map_size) {
+		for (auto& p : m_pages) { p->in_use = false; }
+		m_map_size = map.size();
+		m_page_count = {(m_map_size.x + page_tiles_v - 1) / page_tiles_v, (m_map_size.y + page_tiles_v - 1) / page_tiles_v};
+		m_page_of.assign(m_levels.size() * static_cast<std::size_t>(m_page_count.x * m_page_count.y), nullptr);
+	}
+	auto const texels = m_levels[lvl].texels;
+	auto const page_world = m_atlas.tile_size() * static_cast<float>(page_tiles_v);
+	auto const [lo, hi] = cell_range(view_bounds(view), page_world, m_page_count);
+	for (int py = lo.y; py < hi.y; ++py) {
+		for (int px = lo.x; px < hi.x; ++px) {
+			auto& cached = m_page_of[page_index(lvl, {px, py})];
+			if (!cached) {
+				auto const tiles = page_tiles({px, py});
+				cached = acquire_page({static_cast<unsigned int>(tiles.x) * texels.x, static_cast<unsigned int>(tiles.y) * texels.y});
+				if (!cached) { continue; }
+				cached->level = lvl;
+				cached->index = {px, py};
+				cached->in_use = true;
+				cached->revisions.assign(static_cast<std::size_t>(m_config.page_chunks * m_config.page_chunks), stale_v);
+			}
+			cached->last_used = m_frame;
+			for (int cy = 0; cy < m_config.page_chunks; ++cy) {
+				for (int cx = 0; cx < m_config.page_chunks; ++cx) {
+					auto const chunk = sf::Vector2i{px, py} * m_config.page_chunks + sf::Vector2i{cx, cy};
+					if (chunk.x >= map.chunk_count().x || chunk.y >= map.chunk_count().y) { continue; }
+					auto& revision = cached->revisions[static_cast<std::size_t>(cy * m_config.page_chunks + cx)];
+					if (revision == map.chunk_revision(chunk)) { continue; }
+					compose(map, *cached, chunk);
+					revision = map.chunk_revision(chunk);
+				}
+			}
+		}
+	}
+}
+
+void map_overview::draw(sf::RenderTarget& target, std::size_t const lvl, sf::RenderStates states) const {
+	if (lvl >= m_levels.size()) { return; }
+	auto const tile = m_atlas.tile_size();
+	auto const page_world = tile * static_cast<float>(m_config.page_chunks * tile_map::chunk_size_v);
+	auto const [lo, hi] = cell_range(view_bounds(target.getView()), page_world, m_page_count);
+	for (int py = lo.y; py < hi.y; ++py) {
+		for (int px = lo.x; px < hi.x; ++px) {
+			auto const* cached = m_page_of[page_index(lvl, {px, py})];
+			if (!cached) { continue; }
+			auto const tiles = page_tiles({px, py});
+			auto const texture_size = cached->texture.getSize();
+			m_quad.clear();
+			append_quad(m_quad, {static_cast<float>(px) * page_world.x, static_cast<float>(py) * page_world.y},
+						{static_cast<float>(tiles.x) * tile.x, static_cast<float>(tiles.y) * tile.y}, sf::Color::White, {},
+						{static_cast<float>(texture_size.x), static_cast<float>(texture_size.y)});
+			states.texture = &cached->texture;
+			target.draw(m_quad.data(), m_quad.size(), sf::PrimitiveType::Triangles, states);
+		}
+	}
+}
+
+auto map_overview::evict(std::size_t const bytes) -> std::size_t {
+	auto candidates = std::vector<page*>{};
+	for (auto& p : m_pages) {
+		// never the pages on screen this frame
+		if (p->last_used < m_frame) { candidates.push_back(p.get()); }
+	}
+	std::sort(candidates.begin(), candidates.end(), [](page const* a, page const* b) { return a->last_used < b->last_used; });
+	std::size_t ret{};
+	for (auto* p : candidates) {
+		if (ret >= bytes) { break; }
+		ret += p->bytes.bytes();
+		release(*p);
+	}
+	std::erase_if(m_pages, [](std::unique_ptr<page> const& p) { return p->bytes.bytes() == 0; });
+	return ret;
+}
+
+auto map_overview::page_tiles(sf::Vector2i const index) const -> sf::Vector2i {
+	auto const page_tiles_v = m_config.page_chunks * tile_map::chunk_size_v;
+	auto const origin = index * page_tiles_v;
+	return {std::min(page_tiles_v, m_map_size.x - origin.x), std::min(page_tiles_v, m_map_size.y - origin.y)};
+}
+
+auto map_overview::acquire_page(sf::Vector2u const size) -> page* {
+	page* ret{};
+	if (m_pages.size() >= m_config.max_pages) {
+		// reuse the least recently drawn page's texture, unless everything in the pool is on screen
+		auto it = std::min_element(m_pages.begin(), m_pages.end(), [](auto const& a, auto const& b) { return a->last_used < b->last_used; });
+		if (it != m_pages.end() && (*it)->last_used < m_frame) {
+			ret = it->get();
+			if (ret->in_use) { m_page_of[page_index(ret->level, ret->index)] = nullptr; }
+			ret->in_use = false;
+		} else {
+			CARISE_LOG_DEBUG("map overview: {} pages visible, growing past {} textures", m_pages.size() + 1, m_config.max_pages);
+		}
+	}
+	if (!ret) { ret = m_pages.emplace_back(std::make_unique<page>()).get(); }
+	// edge pages and other levels differ in size
+	if (ret->texture.getSize() != size) {
+		if (!ret->texture.create(size)) {
+			CARISE_LOG_WARN("map overview: failed to create {}x{} texture", size.x, size.y);
+			std::erase_if(m_pages, [ret](std::unique_ptr<page> const& p) { return p.get() == ret; });
+			return nullptr;
+		}
+		ret->texture.setSmooth(true);
+		ret->bytes = track_texture(ret->texture);
+	}
+	return ret;
+}
+
+void map_overview::release(page& p) {
+	if (p.in_use) { m_page_of[page_index(p.level, p.index)] = nullptr; }
+	p.in_use = false;
+	p.bytes.reset();
+}
+
+void map_overview::compose(tile_map const& map, page& p, sf::Vector2i const chunk) {
+	auto const& lvl = m_levels[p.level];
+	auto const texels = sf::Vector2i{static_cast<int>(lvl.texels.x), static_cast<int>(lvl.texels.y)};
+	auto const origin = chunk * tile_map::chunk_size_v;
+	auto const extent = sf::Vector2i{std::min(tile_map::chunk_size_v, m_map_size.x - origin.x), std::min(tile_map::chunk_size_v, m_map_size.y - origin.y)};
+	auto const stride = static_cast<std::size_t>(extent.x * texels.x * 4);
+	auto const tile_bytes = static_cast<std::size_t>(texels.x * texels.y * 4);
+	m_scratch.resize(stride * static_cast<std::size_t>(extent.y * texels.y));
+	static constexpr std::uint8_t empty_v[4]{};
+	for (int y = 0; y < extent.y; ++y) {
+		for (int x = 0; x < extent.x; ++x) {
+			auto const floor = map.floor(origin + sf::Vector2i{x, y});
+			auto const wall = map.wall(origin + sf::Vector2i{x, y});
+			auto const* f = floor < m_atlas.tile_count() ? lvl.tiles.data() + floor * tile_bytes : nullptr;
+			auto const* w = wall < m_atlas.tile_count() ? lvl.tiles.data() + wall * tile_bytes : nullptr;
+			for (int ty = 0; ty < texels.y; ++ty) {
+				auto* out = m_scratch.data() + static_cast<std::size_t>(y * texels.y + ty) * stride + static_cast<std::size_t>(x * texels.x * 4);
+				for (int tx = 0; tx < texels.x; ++tx, out += 4) {
+					auto const offset = static_cast<std::size_t>((ty * texels.x + tx) * 4);
+					auto const* under = f ? f + offset : empty_v;
+					if (w) {
+						blend_over(out, under, w + offset);
+					} else {
+						std::copy_n(under, 4, out);
+					}
+				}
+			}
+		}
+	}
+	auto const dest = (origin - p.index * (m_config.page_chunks * tile_map::chunk_size_v));
+	p.texture.update(m_scratch.data(), {static_cast<unsigned int>(extent.x * texels.x), static_cast<unsigned int>(extent.y * texels.y)},
+					 {static_cast<unsigned int>(dest.x * texels.x), static_cast<unsigned int>(dest.y * texels.y)});
+	++m_refreshed;
+}
+} // namespace carise
@@ -0,0 +1,96 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <carise/render/tile_atlas.hpp>
+#include <carise/world/tile_map.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace carise {
+///
+/// \brief Reduced-detail images of a tile_map for zoomed out views, one mip-style level per halving.
+///
+/// Level l draws each tile with tile_size >> l texels (at least one), box filtered from the atlas once at
+/// construction. The map is cut into pages of page_chunks x page_chunks chunks; a page is composed on the
+/// CPU when it first becomes visible at a level, then only chunks whose terrain revision changed are
+/// re-uploaded. A fully zoomed out view of a 1024x1024 map is 16 quads.
+///
+/// Page textures are pooled and accounted under memory::tag::textures, released least recently used first.
+///
+class map_overview {
+  public:
+	struct config {
+		int page_chunks{8};
+		/// \brief Pool size; grows past this only if more pages than this are visible at once.
+		std::size_t max_pages{48};
+	};
+
+	explicit map_overview(tile_atlas const& atlas) : map_overview(atlas, config{}) {}
+	map_overview(tile_atlas const& atlas, config const& cfg);
+	~map_overview();
+
+	map_overview(map_overview const&) = delete;
+	map_overview& operator=(map_overview const&) = delete;
+
+	/// \brief Number of levels; level 0 is half the atlas resolution.
+	[[nodiscard]] auto level_count() const -> std::size_t { return m_levels.size(); }
+	/// \brief Texels per tile at a level.
+	[[nodiscard]] auto texels(std::size_t const level) const -> sf::Vector2u { return m_levels[level].texels; }
+	/// \brief Coarsest level that still has at least one texel per screen pixel.
+	[[nodiscard]] auto select_level(float pixels_per_tile) const -> std::size_t;
+
+	/// \brief Compose stale and newly visible pages of level in view.
+	void update(tile_map const& map, sf::View const& view, std::size_t level);
+	/// \brief Draw the pages of level visible in target's current view.
+	void draw(sf::RenderTarget& target, std::size_t level, sf::RenderStates states = {}) const;
+
+	/// \returns Bytes released
+	auto evict(std::size_t bytes) -> std::size_t;
+
+	/// \brief Chunks composed by the last update().
+	[[nodiscard]] auto refreshed() const -> std::size_t { return m_refreshed; }
+	[[nodiscard]] auto resident() const -> std::size_t { return m_pages.size(); }
+
+  private:
+	struct level {
+		sf::Vector2u texels{};
+		/// \brief RGBA texels of every atlas tile, tile after tile.
+		std::vector<std::uint8_t> tiles{};
+	};
+
+	struct page {
+		sf::Texture texture{};
+		memory::tracked_bytes bytes{};
+		std::size_t level{};
+		sf::Vector2i index{};
+		/// \brief Terrain revision of each chunk as composed, row-major within the page.
+		std::vector<std::uint64_t> revisions{};
+		std::uint64_t last_used{};
+		bool in_use{};
+	};
+
+	[[nodiscard]] auto page_index(std::size_t const lvl, sf::Vector2i const index) const -> std::size_t {
+		return (lvl * static_cast<std::size_t>(m_page_count.y) + static_cast<std::size_t>(index.y)) * static_cast<std::size_t>(m_page_count.x) +
+			   static_cast<std::size_t>(index.x);
+	}
+	[[nodiscard]] auto page_tiles(sf::Vector2i index) const -> sf::Vector2i;
+	[[nodiscard]] auto acquire_page(sf::Vector2u size) -> page*;
+	void release(page& p);
+	void compose(tile_map const& map, page& p, sf::Vector2i chunk);
+
+	tile_atlas const& m_atlas;
+	config m_config;
+	std::vector<level> m_levels{};
+	sf::Vector2i m_map_size{};
+	sf::Vector2i m_page_count{};
+	std::vector<std::unique_ptr<page>> m_pages{};
+	/// \brief Per level and page: the texture holding it, or nullptr.
+	std::vector<page*> m_page_of{};
+	std::vector<std::uint8_t> m_scratch{};
+	mutable std::vector<sf::Vertex> m_quad{};
+	std::uint64_t m_frame{};
+	std::size_t m_refreshed{};
+	memory::tracker::evictor_id m_evictor{};
+};
+} // namespace carise
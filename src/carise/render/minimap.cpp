@@ -0,0 +1,196 @@
+#include <carise/core/log.hpp>
+#include <carise/render/minimap.hpp>
+#include <carise/render/texture_memory.hpp>
+#include <carise/render/vertices.hpp>
+#include <algorithm>
+
+namespace carise {
+namespace {
+/// \brief Alpha weighted average of one atlas tile.
+auto average(sf::Image const& image, sf::Vector2u const origin, sf::Vector2u const size) -> sf::Color {
+	std::uint64_t r{}, g{}, b{}, a{};
+	for (auto y = 0u; y < size.y; ++y) {
+		for (auto x = 0u; x < size.x; ++x) {
+			auto const c = image.getPixel(origin + sf::Vector2u{x, y});
+			r += std::uint64_t{c.r} * c.a;
+			g += std::uint64_t{c.g} * c.a;
+			b += std::uint64_t{c.b} * c.a;
+			a += c.a;
+		}
+	}
+	if (a == 0) { return sf::Color::Transparent; }
+	auto const count = std::max(std::uint64_t{size.x} * size.y, std::uint64_t{1});
+	return sf::Color{static_cast<std::uint8_t>(r / a), static_cast<std::uint8_t>(g / a), static_cast<std::uint8_t>(b / a), static_cast<std::uint8_t>(a / count)};
+}
+} // namespace
+
+minimap::minimap(tile_atlas const& atlas, config const& cfg) : m_config(cfg) {
+	auto const* texture = atlas.texture();
+	if (!texture) { return; }
+	auto const image = texture->copyToImage();
+	auto const tile = sf::Vector2u{static_cast<unsigned int>(atlas.tile_size().x), static_cast<unsigned int>(atlas.tile_size().y)};
+	m_tile_colours.reserve(atlas.tile_count());
+	for (unsigned int id = 0; id < atlas.tile_count(); ++id) {
+		auto const uv = atlas.uv(static_cast<tile_id>(id));
+		m_tile_colours.push_back(average(image, {static_cast<unsigned int>(uv.x), static_cast<unsigned int>(uv.y)}, tile));
+	}
+}
+
+auto minimap::create(tile_map const& map) -> bool {
+	auto const size = sf::Vector2u{static_cast<unsigned int>(map.size().x), static_cast<unsigned int>(map.size().y)};
+	m_size = {};
+	if (size.x == 0 || size.y == 0) { return false; }
+	if (size.x > sf::Texture::getMaximumSize() || size.y > sf::Texture::getMaximumSize()) {
+		CARISE_LOG_WARN("minimap: {}x{} map exceeds the maximum texture size", size.x, size.y);
+		return false;
+	}
+	if (!m_texture.create(size)) { return false; }
+	m_texture_bytes = track_texture(m_texture);
+
+	m_size = map.size();
+	m_chunks = map.chunk_count();
+	auto const count = static_cast<std::size_t>(m_size.x * m_size.y);
+	m_revealed.assign(count, m_config.reveal_all ? 1 : 0);
+	m_pixels.resize(count * 4);
+	for (int y = 0; y < m_size.y; ++y) {
+		for (int x = 0; x < m_size.x; ++x) {
+			auto const c = colour_at(map, {x, y});
+			auto* out = m_pixels.data() + index({x, y}) * 4;
+			out[0] = c.r;
+			out[1] = c.g;
+			out[2] = c.b;
+			out[3] = c.a;
+		}
+	}
+	m_texture.update(m_pixels.data());
+
+	auto const chunks = static_cast<std::size_t>(m_chunks.x * m_chunks.y);
+	m_revisions.resize(chunks);
+	for (int cy = 0; cy < m_chunks.y; ++cy) {
+		for (int cx = 0; cx < m_chunks.x; ++cx) { m_revisions[chunk_index({cx, cy})] = map.chunk_revision({cx, cy}); }
+	}
+	m_pending.assign(chunks, span{});
+	m_dirty.clear();
+	return true;
+}
+
+void minimap::update(tile_map const& map) {
+	m_uploads = 0;
+	m_uploaded_texels = 0;
+	if (map.size() != m_size) {
+		if (!create(map)) { CARISE_LOG_WARN("minimap: failed to recreate for resized map"); }
+		return;
+	}
+	for (int cy = 0; cy < m_chunks.y; ++cy) {
+		for (int cx = 0; cx < m_chunks.x; ++cx) {
+			auto& revision = m_revisions[chunk_index({cx, cy})];
+			if (revision == map.chunk_revision({cx, cy})) { continue; }
+			revision = map.chunk_revision({cx, cy});
+			auto const origin = sf::Vector2i{cx, cy} * tile_map::chunk_size_v;
+			mark({cx, cy}, origin, {std::min(origin.x + tile_map::chunk_size_v, m_size.x), std::min(origin.y + tile_map::chunk_size_v, m_size.y)});
+		}
+	}
+	// everything edited or revealed this frame goes up here, at most one sub-rectangle per chunk
+	for (auto const chunk : m_dirty) {
+		auto& pending = m_pending[chunk_index(chunk)];
+		refresh(map, pending);
+		pending = {};
+	}
+	m_dirty.clear();
+}
+
+void minimap::reveal(sf::Vector2i const pos) {
+	if (pos.x < 0 || pos.y < 0 || pos.x >= m_size.x || pos.y >= m_size.y) { return; }
+	auto& revealed = m_revealed[index(pos)];
+	if (revealed) { return; }
+	revealed = 1;
+	mark({pos.x / tile_map::chunk_size_v, pos.y / tile_map::chunk_size_v}, pos, pos + sf::Vector2i{1, 1});
+}
+
+void minimap::reveal(sf::IntRect const& area) {
+	auto const lo = sf::Vector2i{std::max(area.left, 0), std::max(area.top, 0)};
+	auto const hi = sf::Vector2i{std::min(area.left + area.width, m_size.x), std::min(area.top + area.height, m_size.y)};
+	for (int y = lo.y; y < hi.y; ++y) {
+		for (int x = lo.x; x < hi.x; ++x) { reveal({x, y}); }
+	}
+}
+
+auto minimap::is_revealed(sf::Vector2i const pos) const -> bool {
+	return pos.x >= 0 && pos.y >= 0 && pos.x < m_size.x && pos.y < m_size.y && m_revealed[index(pos)] != 0;
+}
+
+void minimap::draw(sf::RenderTarget& target, sf::FloatRect const& bounds, sf::RenderStates states) const {
+	if (m_size.x == 0 || m_size.y == 0) { return; }
+	auto const tiles = sf::Vector2f{static_cast<float>(m_size.x), static_cast<float>(m_size.y)};
+	m_vertices.clear();
+	append_quad(m_vertices, {bounds.left, bounds.top}, {bounds.width, bounds.height}, sf::Color::White, {}, tiles);
+	states.texture = &m_texture;
+	target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+	if (m_markers.empty()) { return; }
+
+	auto const scale = sf::Vector2f{bounds.width / tiles.x, bounds.height / tiles.y};
+	auto const size = sf::Vector2f{m_config.marker_size, m_config.marker_size};
+	m_vertices.clear();
+	for (auto const& m : m_markers) {
+		auto const centre = sf::Vector2f{bounds.left + (m.tile.x + 0.5f) * scale.x, bounds.top + (m.tile.y + 0.5f) * scale.y};
+		append_quad(m_vertices, centre - size * 0.5f, size, m.colour);
+	}
+	states.texture = nullptr;
+	target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+}
+
+auto minimap::colour_at(tile_map const& map, sf::Vector2i const pos) const -> sf::Color {
+	if (!m_revealed[index(pos)]) { return m_config.unexplored; }
+	auto const colour = [this](tile_id const id) { return id < m_tile_colours.size() ? m_tile_colours[id] : sf::Color::Transparent; };
+	auto const floor = colour(map.floor(pos));
+	if (map.wall(pos) == no_tile_v) { return floor; }
+	// wall over floor, as the tile renderers draw them
+	auto const wall = colour(map.wall(pos));
+	auto const a = std::uint32_t{wall.a};
+	auto const mix = [a](std::uint8_t const under, std::uint8_t const over) { return static_cast<std::uint8_t>((under * (255 - a) + over * a + 127) / 255); };
+	return sf::Color{mix(floor.r, wall.r), mix(floor.g, wall.g), mix(floor.b, wall.b), std::max(floor.a, wall.a)};
+}
+
+void minimap::mark(sf::Vector2i const chunk, sf::Vector2i const lo, sf::Vector2i const hi) {
+	auto& pending = m_pending[chunk_index(chunk)];
+	if (pending.lo.x >= pending.hi.x || pending.lo.y >= pending.hi.y) {
+		pending = span{.lo = lo, .hi = hi};
+		m_dirty.push_back(chunk);
+		return;
+	}
+	pending.lo = {std::min(pending.lo.x, lo.x), std::min(pending.lo.y, lo.y)};
+	pending.hi = {std::max(pending.hi.x, hi.x), std::max(pending.hi.y, hi.y)};
+}
+
+void minimap::refresh(tile_map const& map, span const& pending) {
+	// recolour the pending tiles, keeping the bounds of those whose texel really changed
+	auto lo = pending.hi;
+	auto hi = pending.lo;
+	for (int y = pending.lo.y; y < pending.hi.y; ++y) {
+		for (int x = pending.lo.x; x < pending.hi.x; ++x) {
+			auto const c = colour_at(map, {x, y});
+			auto* texel = m_pixels.data() + index({x, y}) * 4;
+			if (texel[0] == c.r && texel[1] == c.g && texel[2] == c.b && texel[3] == c.a) { continue; }
+			texel[0] = c.r;
+			texel[1] = c.g;
+			texel[2] = c.b;
+			texel[3] = c.a;
+			lo = {std::min(lo.x, x), std::min(lo.y, y)};
+			hi = {std::max(hi.x, x + 1), std::max(hi.y, y + 1)};
+		}
+	}
+	if (lo.x >= hi.x || lo.y >= hi.y) { return; }
+
+	auto const extent = hi - lo;
+	auto const row = static_cast<std::size_t>(extent.x) * 4;
+	m_scratch.resize(row * static_cast<std::size_t>(extent.y));
+	for (int y = 0; y < extent.y; ++y) {
+		auto const* from = m_pixels.data() + index({lo.x, lo.y + y}) * 4;
+		std::copy_n(from, row, m_scratch.data() + static_cast<std::size_t>(y) * row);
+	}
+	m_texture.update(m_scratch.data(), {static_cast<unsigned int>(extent.x), static_cast<unsigned int>(extent.y)},
+					 {static_cast<unsigned int>(lo.x), static_cast<unsigned int>(lo.y)});
+	++m_uploads;
+	m_uploaded_texels += static_cast<std::size_t>(extent.x * extent.y);
+}
+} // namespace carise
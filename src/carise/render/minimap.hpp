@@ -0,0 +1,101 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <carise/render/tile_atlas.hpp>
+#include <carise/world/tile_map.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace carise {
+///
+/// \brief A whole-level minimap held in one texture, one texel per tile, patched in place as the level changes.
+///
+/// Each tile is drawn in the average colour of its atlas tile (wall over floor), or the unexplored colour until
+/// reveal() marks it seen. update() rescans only chunks whose terrain revision changed or that had tiles revealed,
+/// and uploads one sub-rectangle per such chunk, trimmed to the texels that actually changed; a level nobody is
+/// editing or exploring costs nothing to keep current.
+///
+/// Entity markers are rebuilt by the caller each frame and drawn over the map as a single vertex array.
+///
+class minimap {
+  public:
+	struct config {
+		/// \brief Colour of tiles not yet revealed.
+		sf::Color unexplored{sf::Color::Transparent};
+		/// \brief Every tile starts revealed (no fog of war).
+		bool reveal_all{};
+		/// \brief Marker edge length in target pixels.
+		float marker_size{3.0f};
+	};
+
+	explicit minimap(tile_atlas const& atlas) : minimap(atlas, config{}) {}
+	minimap(tile_atlas const& atlas, config const& cfg);
+
+	///
+	/// \brief Size the texture for map and upload all of it; resets what has been revealed.
+	/// \returns false if the map exceeds the maximum texture size
+	///
+	[[nodiscard]] auto create(tile_map const& map) -> bool;
+	/// \brief Upload tiles edited or revealed since the previous call (recreates on a resized map).
+	void update(tile_map const& map);
+
+	/// \brief Mark a tile seen; it shows from the next update(). Out of bounds is ignored.
+	void reveal(sf::Vector2i pos);
+	void reveal(sf::IntRect const& area);
+	[[nodiscard]] auto is_revealed(sf::Vector2i pos) const -> bool;
+
+	void clear_markers() { m_markers.clear(); }
+	/// \brief Mark an entity until the next clear_markers(); tile {x, y} puts the marker in the middle of that tile.
+	void add_marker(sf::Vector2f const tile, sf::Color const colour) { m_markers.push_back(marker{.tile = tile, .colour = colour}); }
+
+	/// \brief Draw the map stretched over bounds (in target coordinates), then the markers.
+	void draw(sf::RenderTarget& target, sf::FloatRect const& bounds, sf::RenderStates states = {}) const;
+
+	/// \brief Texture sub-rectangle uploads issued by the last update().
+	[[nodiscard]] auto uploads() const -> std::size_t { return m_uploads; }
+	/// \brief Texels those uploads covered.
+	[[nodiscard]] auto uploaded_texels() const -> std::size_t { return m_uploaded_texels; }
+	[[nodiscard]] auto texture() const -> sf::Texture const& { return m_texture; }
+
+  private:
+	struct marker {
+		sf::Vector2f tile{};
+		sf::Color colour{};
+	};
+
+	/// \brief Tiles [lo, hi) of one chunk; empty when lo is not below hi.
+	struct span {
+		sf::Vector2i lo{};
+		sf::Vector2i hi{};
+	};
+
+	[[nodiscard]] auto index(sf::Vector2i const pos) const -> std::size_t { return static_cast<std::size_t>(pos.y * m_size.x + pos.x); }
+	[[nodiscard]] auto chunk_index(sf::Vector2i const chunk) const -> std::size_t { return static_cast<std::size_t>(chunk.y * m_chunks.x + chunk.x); }
+	[[nodiscard]] auto colour_at(tile_map const& map, sf::Vector2i pos) const -> sf::Color;
+	/// \brief Widen a chunk's pending rescan to cover [lo, hi).
+	void mark(sf::Vector2i chunk, sf::Vector2i lo, sf::Vector2i hi);
+	/// \brief Recolour the pending tiles of a chunk and upload the ones that changed.
+	void refresh(tile_map const& map, span const& pending);
+
+	config m_config;
+	/// \brief Average colour of each atlas tile.
+	std::vector<sf::Color> m_tile_colours{};
+	sf::Texture m_texture{};
+	memory::tracked_bytes m_texture_bytes{};
+	sf::Vector2i m_size{};
+	sf::Vector2i m_chunks{};
+	/// \brief CPU copy of the texture, row-major RGBA.
+	memory::tagged_vector<std::uint8_t, memory::tag::ui> m_pixels{};
+	memory::tagged_vector<std::uint8_t, memory::tag::ui> m_revealed{};
+	std::vector<std::uint64_t> m_revisions{};
+	/// \brief Per chunk, the tiles to rescan at the next update().
+	std::vector<span> m_pending{};
+	/// \brief Chunks with a non-empty pending range, each listed once.
+	std::vector<sf::Vector2i> m_dirty{};
+	std::vector<std::uint8_t> m_scratch{};
+	std::vector<marker> m_markers{};
+	mutable std::vector<sf::Vertex> m_vertices{};
+	std::size_t m_uploads{};
+	std::size_t m_uploaded_texels{};
+};
+} // namespace carise
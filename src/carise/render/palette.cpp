@@ -0,0 +1,142 @@
+#include <carise/core/log.hpp>
+#include <carise/render/palette.hpp>
+#include <carise/render/texture_memory.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace carise {
+namespace {
+constexpr float speed_scale_v{64.0f};
+
+constexpr auto fragment_shader_v = R"(#version 120
+uniform sampler2D indexed;
+uniform sampler2D palette;
+uniform float time;
+
+float to_byte(float channel) { return floor(channel * 255.0 + 0.5); }
+
+void main() {
+	vec4 texel = texture2D(indexed, gl_TexCoord[0].xy);
+	float index = to_byte(texel.r);
+	vec4 cycle = texture2D(palette, vec2((index + 0.5) / 256.0, 0.75));
+	float count = to_byte(cycle.g);
+	if (count > 1.0) {
+		float first = to_byte(cycle.r);
+		float raw = to_byte(cycle.b) + to_byte(cycle.a) * 256.0;
+		float speed = (raw >= 32768.0 ? raw - 65536.0 : raw) / 64.0;
+		index = first + mod(index - first + floor(time * speed), count);
+	}
+	vec4 colour = texture2D(palette, vec2((index + 0.5) / 256.0, 0.25));
+	gl_FragColor = vec4(colour.rgb, colour.a * texel.a) * gl_Color;
+}
+)";
+} // namespace
+
+void palette::set_colour(std::uint8_t const index, sf::Color const colour) {
+	if (m_colours[index] == colour) { return; }
+	m_colours[index] = colour;
+	m_dirty = true;
+}
+
+void palette::add_cycle(cycle const& c) {
+	auto const count = std::min<std::size_t>(c.count, size_v - c.first);
+	if (count < 2) { return; }
+	auto const speed = static_cast<long>(std::lround(std::clamp(c.steps_per_second * speed_scale_v, -32768.0f, 32767.0f)));
+	auto const raw = static_cast<std::uint16_t>(speed);
+	// row 1 texels of entries from .. to - 1 as one cycle, or as no cycle if that leaves fewer than 2
+	auto const assign = [this](std::size_t const from, std::size_t const to, std::uint8_t const speed_lo, std::uint8_t const speed_hi) {
+		auto const length = to - from;
+		for (auto i = from; i < to; ++i) {
+			m_cycles[i] = length < 2 ? std::array<std::uint8_t, 4>{}
+									 : std::array<std::uint8_t, 4>{static_cast<std::uint8_t>(from), static_cast<std::uint8_t>(length), speed_lo, speed_hi};
+		}
+	};
+	auto const end = std::size_t{c.first} + count;
+	// cycles this one overlaps shrink to their entries outside it, or the shader would still rotate them into its range
+	for (auto i = std::size_t{c.first}; i < end;) {
+		auto const old = m_cycles[i];
+		if (old[1] == 0) {
+			++i;
+			continue;
+		}
+		auto const old_end = std::size_t{old[0]} + old[1];
+		if (old[0] < c.first) { assign(old[0], c.first, old[2], old[3]); }
+		if (old_end > end) { assign(end, old_end, old[2], old[3]); }
+		i = old_end;
+	}
+	assign(c.first, end, static_cast<std::uint8_t>(raw & 0xff), static_cast<std::uint8_t>(raw >> 8));
+	m_dirty = true;
+}
+
+void palette::clear_cycles() {
+	m_cycles = {};
+	m_dirty = true;
+}
+
+auto palette::index_image(sf::Image const& image) const -> sf::Image {
+	auto const size = image.getSize();
+	auto ret = sf::Image{};
+	ret.create(size, sf::Color::Transparent);
+	for (auto y = 0u; y < size.y; ++y) {
+		for (auto x = 0u; x < size.x; ++x) {
+			auto const c = image.getPixel({x, y});
+			if (c.a == 0) { continue; }
+			auto best = std::size_t{};
+			auto best_distance = std::numeric_limits<int>::max();
+			for (std::size_t i = 0; i < size_v && best_distance > 0; ++i) {
+				auto const dr = int{c.r} - m_colours[i].r;
+				auto const dg = int{c.g} - m_colours[i].g;
+				auto const db = int{c.b} - m_colours[i].b;
+				if (auto const distance = dr * dr + dg * dg + db * db; distance < best_distance) {
+					best = i;
+					best_distance = distance;
+				}
+			}
+			ret.setPixel({x, y}, sf::Color{static_cast<std::uint8_t>(best), 0, 0, c.a});
+		}
+	}
+	return ret;
+}
+
+auto palette::update() -> bool {
+	if (!m_dirty) { return true; }
+	auto const size = sf::Vector2u{static_cast<unsigned int>(size_v), 2};
+	if (m_texture.getSize() != size) {
+		if (!m_texture.create(size)) {
+			CARISE_LOG_WARN("palette: failed to create texture");
+			return false;
+		}
+		m_texture_bytes = track_texture(m_texture);
+	}
+	auto pixels = std::vector<std::uint8_t>(size_v * 2 * 4);
+	for (std::size_t i = 0; i < size_v; ++i) {
+		auto* colour = pixels.data() + i * 4;
+		colour[0] = m_colours[i].r;
+		colour[1] = m_colours[i].g;
+		colour[2] = m_colours[i].b;
+		colour[3] = m_colours[i].a;
+		std::copy_n(m_cycles[i].data(), 4, pixels.data() + (size_v + i) * 4);
+	}
+	m_texture.update(pixels.data());
+	m_dirty = false;
+	return true;
+}
+
+auto palette_shader::create() -> bool {
+	if (!is_available()) { return false; }
+	if (!m_shader.loadFromMemory(fragment_shader_v, sf::Shader::Type::Fragment)) {
+		CARISE_LOG_WARN("palette shader: failed to compile fragment shader");
+		return false;
+	}
+	m_shader.setUniform("indexed", sf::Shader::CurrentTexture);
+	m_shader.setUniform("time", 0.0f);
+	return true;
+}
+
+void palette_shader::apply(palette const& pal, float const seconds) {
+	m_shader.setUniform("palette", pal.texture());
+	m_shader.setUniform("time", seconds);
+}
+} // namespace carise
@@ -0,0 +1,74 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+
+namespace carise {
+///
+/// \brief 256 colours, some of which rotate through colour cycles, kept in a 256x2 texture.
+///
+/// Row 0 holds the colours; row 1 holds, for every entry inside a cycle, the cycle's first entry, length
+/// and speed. palette_shader resolves indexed texels through both rows against a time uniform, so water,
+/// lava and runes keep moving with no per-frame CPU work at all.
+///
+class palette {
+  public:
+	static constexpr std::size_t size_v{256};
+
+	/// \brief Entries first .. first + count - 1 rotate by one step every 1 / steps_per_second seconds.
+	struct cycle {
+		std::uint8_t first{};
+		std::uint8_t count{};
+		/// \brief Negative runs the cycle backwards; resolution is 1/64 step per second.
+		float steps_per_second{};
+	};
+
+	[[nodiscard]] auto colour(std::uint8_t const index) const -> sf::Color { return m_colours[index]; }
+	void set_colour(std::uint8_t index, sf::Color colour);
+	/// \brief Add a cycle; cycles it overlaps keep only their entries outside it. Count is clamped to the end of the palette.
+	void add_cycle(cycle const& c);
+	void clear_cycles();
+
+	///
+	/// \brief Convert truecolour art to indexed texels: red is the nearest palette entry, alpha is kept.
+	///
+	/// Lets tiles be painted in the palette's colours with any editor and indexed at load time.
+	///
+	[[nodiscard]] auto index_image(sf::Image const& image) const -> sf::Image;
+
+	/// \brief Upload the palette if it changed since the last call.
+	/// \returns false if the texture could not be created
+	[[nodiscard]] auto update() -> bool;
+	[[nodiscard]] auto texture() const -> sf::Texture const& { return m_texture; }
+
+  private:
+	std::array<sf::Color, size_v> m_colours{};
+	/// \brief Row 1 texels: first, count, speed as signed 10.6 fixed point (low, high byte).
+	std::array<std::array<std::uint8_t, 4>, size_v> m_cycles{};
+	sf::Texture m_texture{};
+	memory::tracked_bytes m_texture_bytes{};
+	bool m_dirty{true};
+};
+
+///
+/// \brief Fragment shader that draws palette-indexed tiles: the texel's red channel picks a palette entry.
+///
+/// Bind it when drawing a tile_map_renderer (or any vertices) built from an indexed atlas, such as one made
+/// by palette::index_image(). Alpha comes from the texel, and the vertex colour still tints the result.
+/// Needs GLSL 1.20; check is_available().
+///
+class palette_shader {
+  public:
+	[[nodiscard]] static auto is_available() -> bool { return sf::Shader::isAvailable(); }
+
+	[[nodiscard]] auto create() -> bool;
+	/// \brief Use pal (after pal.update()) at seconds on the cycle clock.
+	void apply(palette const& pal, float seconds);
+
+	[[nodiscard]] auto shader() const -> sf::Shader const& { return m_shader; }
+
+  private:
+	sf::Shader m_shader{};
+};
+} // namespace carise
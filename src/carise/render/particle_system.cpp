@@ -0,0 +1,163 @@
+#include <carise/render/particle_system.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CARISE_PARTICLES_SSE2 1
+#else
+#define CARISE_PARTICLES_SSE2 0
+#endif
+
+namespace carise {
+namespace {
+constexpr std::size_t lanes_v{4};
+
+constexpr auto round_up(std::size_t const value, std::size_t const multiple) -> std::size_t { return (value + multiple - 1) / multiple * multiple; }
+
+#if CARISE_PARTICLES_SSE2
+// the aligned loads below rely on every float array starting on a 16 byte boundary
+static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= 16);
+#endif
+} // namespace
+
+particle_system::particle_system(job_pool* jobs, config const& cfg) : m_jobs(jobs), m_config(cfg) {
+	m_config.grain = round_up(std::max(m_config.grain, lanes_v), lanes_v);
+}
+
+auto particle_system::add_type(particle_type const& type) -> type_id {
+	auto e = std::make_unique<emitter>();
+	e->type = type;
+	// padded to whole SIMD lanes: the kernels run over the tail without a scalar remainder loop
+	auto const padded = round_up(type.capacity, lanes_v);
+	for (auto* array : {&e->x, &e->y, &e->vx, &e->vy, &e->life, &e->inverse_lifetime}) { array->resize(padded); }
+	e->colour.resize(padded);
+	e->vertices.resize(type.capacity * 6);
+	m_emitters.push_back(std::move(e));
+	return static_cast<type_id>(m_emitters.size() - 1);
+}
+
+auto particle_system::spawn(type_id const type, particle_spawn const& particle) -> bool {
+	auto& e = *m_emitters[type];
+	if (e.count == e.type.capacity) {
+		++m_pending_dropped;
+		return false;
+	}
+	auto const i = e.count++;
+	e.x[i] = particle.position.x;
+	e.y[i] = particle.position.y;
+	e.vx[i] = particle.velocity.x;
+	e.vy[i] = particle.velocity.y;
+	e.life[i] = particle.life;
+	e.inverse_lifetime[i] = particle.life > 0.0f ? 1.0f / particle.life : 0.0f;
+	e.colour[i] = particle.colour;
+	return true;
+}
+
+void particle_system::clear() {
+	for (auto& e : m_emitters) { e->count = 0; }
+}
+
+void particle_system::update(float const dt) {
+	m_dropped = std::exchange(m_pending_dropped, 0);
+	for (auto& e : m_emitters) {
+		if (e->count == 0) { continue; }
+		auto const damping = std::pow(e->type.drag, dt);
+		auto const padded = round_up(e->count, lanes_v);
+		auto const step = [&](std::size_t const begin, std::size_t const end) { integrate(*e, begin, end, dt, damping); };
+		auto const quads = [&](std::size_t const begin, std::size_t const end) { write_quads(*e, begin, end); };
+		if (m_jobs) {
+			m_jobs->parallel_for(padded, m_config.grain, step);
+			compact(*e);
+			m_jobs->parallel_for(e->count, m_config.grain, quads);
+		} else {
+			step(0, padded);
+			compact(*e);
+			quads(0, e->count);
+		}
+	}
+}
+
+void particle_system::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+	for (auto const& e : m_emitters) {
+		if (e->count == 0) { continue; }
+		states.texture = e->type.texture;
+		states.blendMode = e->type.blend;
+		target.draw(e->vertices.data(), e->count * 6, sf::PrimitiveType::Triangles, states);
+	}
+}
+
+auto particle_system::count() const -> std::size_t {
+	return std::accumulate(m_emitters.begin(), m_emitters.end(), std::size_t{}, [](std::size_t const sum, auto const& e) { return sum + e->count; });
+}
+
+void particle_system::integrate(emitter& e, std::size_t const begin, std::size_t const end, float const dt, float const damping) {
+	auto const gx = e.type.gravity.x * dt;
+	auto const gy = e.type.gravity.y * dt;
+#if CARISE_PARTICLES_SSE2
+	auto const v_dt = _mm_set1_ps(dt);
+	auto const v_damping = _mm_set1_ps(damping);
+	auto const v_gx = _mm_set1_ps(gx);
+	auto const v_gy = _mm_set1_ps(gy);
+	for (auto i = begin; i < end; i += lanes_v) {
+		auto const vx = _mm_mul_ps(_mm_add_ps(_mm_load_ps(e.vx.data() + i), v_gx), v_damping);
+		auto const vy = _mm_mul_ps(_mm_add_ps(_mm_load_ps(e.vy.data() + i), v_gy), v_damping);
+		_mm_store_ps(e.vx.data() + i, vx);
+		_mm_store_ps(e.vy.data() + i, vy);
+		_mm_store_ps(e.x.data() + i, _mm_add_ps(_mm_load_ps(e.x.data() + i), _mm_mul_ps(vx, v_dt)));
+		_mm_store_ps(e.y.data() + i, _mm_add_ps(_mm_load_ps(e.y.data() + i), _mm_mul_ps(vy, v_dt)));
+		_mm_store_ps(e.life.data() + i, _mm_sub_ps(_mm_load_ps(e.life.data() + i), v_dt));
+	}
+#else
+	for (auto i = begin; i < end; ++i) {
+		e.vx[i] = (e.vx[i] + gx) * damping;
+		e.vy[i] = (e.vy[i] + gy) * damping;
+		e.x[i] += e.vx[i] * dt;
+		e.y[i] += e.vy[i] * dt;
+		e.life[i] -= dt;
+	}
+#endif
+}
+
+void particle_system::compact(emitter& e) {
+	for (std::size_t i = 0; i < e.count;) {
+		if (e.life[i] > 0.0f) {
+			++i;
+			continue;
+		}
+		// the last particle takes the dead one's slot and is checked next
+		auto const last = --e.count;
+		e.x[i] = e.x[last];
+		e.y[i] = e.y[last];
+		e.vx[i] = e.vx[last];
+		e.vy[i] = e.vy[last];
+		e.life[i] = e.life[last];
+		e.inverse_lifetime[i] = e.inverse_lifetime[last];
+		e.colour[i] = e.colour[last];
+	}
+}
+
+void particle_system::write_quads(emitter& e, std::size_t const begin, std::size_t const end) {
+	auto const half = e.type.size / 2.0f;
+	auto const uv = e.type.uv;
+	auto const uv_size = e.type.uv_size;
+	for (auto i = begin; i < end; ++i) {
+		auto colour = e.colour[i];
+		if (e.type.fade) { colour.a = static_cast<std::uint8_t>(static_cast<float>(colour.a) * std::clamp(e.life[i] * e.inverse_lifetime[i], 0.0f, 1.0f)); }
+		auto const centre = sf::Vector2f{e.x[i], e.y[i]};
+		auto* out = e.vertices.data() + i * 6;
+		auto const tl = sf::Vertex{centre - half, colour, uv};
+		auto const tr = sf::Vertex{{centre.x + half.x, centre.y - half.y}, colour, {uv.x + uv_size.x, uv.y}};
+		auto const br = sf::Vertex{centre + half, colour, uv + uv_size};
+		auto const bl = sf::Vertex{{centre.x - half.x, centre.y + half.y}, colour, {uv.x, uv.y + uv_size.y}};
+		out[0] = tl;
+		out[1] = tr;
+		out[2] = br;
+		out[3] = tl;
+		out[4] = br;
+		out[5] = bl;
+	}
+}
+} // namespace carise
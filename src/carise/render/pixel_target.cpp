@@ -0,0 +1,131 @@
+#include <carise/core/log.hpp>
+#include <carise/render/pixel_target.hpp>
+#include <carise/render/texture_memory.hpp>
+#include <carise/render/vertices.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace carise {
+namespace {
+// source texels are a prescale x prescale block with a one screen pixel bilinear seam (after the libretro sharp-bilinear shader)
+constexpr auto fragment_shader_v = R"(#version 120
+uniform sampler2D source;
+uniform vec2 source_size;
+uniform vec2 prescale;
+
+void main() {
+	vec2 texel = gl_TexCoord[0].xy * source_size;
+	vec2 region = 0.5 - 0.5 / prescale;
+	vec2 centre = fract(texel) - 0.5;
+	vec2 f = (centre - clamp(centre, -region, region)) * prescale + 0.5;
+	gl_FragColor = texture2D(source, (floor(texel) + f) / source_size) * gl_Color;
+}
+)";
+
+[[nodiscard]] auto to_vector(sf::Vector2u const size) -> sf::Vector2f { return {static_cast<float>(size.x), static_cast<float>(size.y)}; }
+} // namespace
+
+pixel_target::pixel_target(config const& cfg) : m_config(cfg) {
+	if (sf::Shader::isAvailable()) {
+		m_has_shader = m_shader.loadFromMemory(fragment_shader_v, sf::Shader::Type::Fragment);
+		if (m_has_shader) {
+			m_shader.setUniform("source", sf::Shader::CurrentTexture);
+		} else {
+			CARISE_LOG_WARN("pixel target: failed to compile sharp bilinear shader, prescaling instead");
+		}
+	}
+}
+
+auto pixel_target::begin(sf::Color const clear) -> sf::RenderTexture* {
+	if (!m_world_ready) {
+		auto const res = sf::Vector2u{std::max(m_config.resolution.x, 1u), std::max(m_config.resolution.y, 1u)};
+		if (!m_world.create(res)) {
+			CARISE_LOG_WARN("pixel target: failed to create {}x{} render texture", res.x, res.y);
+			return nullptr;
+		}
+		m_world_bytes = track_texture(m_world);
+		m_world_ready = true;
+		++m_recreated;
+	}
+	m_world.clear(clear);
+	return &m_world;
+}
+
+void pixel_target::present(sf::RenderTarget& target) {
+	target.clear(m_config.border);
+	if (!m_world_ready) { return; }
+	m_world.display();
+
+	auto const window = to_vector(target.getSize());
+	auto const source = to_vector(m_world.getSize());
+	auto const fit = std::min(window.x / source.x, window.y / source.y);
+	// integer scaling keeps whole multiples; a window smaller than the resolution can only shrink
+	m_scale = m_config.upscale == filter::integer && fit >= 1.0f ? std::floor(fit) : fit;
+	auto const size = sf::Vector2f{std::round(source.x * m_scale), std::round(source.y * m_scale)};
+	m_output = sf::FloatRect{{std::floor((window.x - size.x) * 0.5f), std::floor((window.y - size.y) * 0.5f)}, size};
+
+	auto const* texture = &m_world.getTexture();
+	auto states = sf::RenderStates{};
+	if (m_config.upscale == filter::integer || m_scale <= 1.0f) {
+		m_world.setSmooth(m_scale < 1.0f);
+	} else if (m_has_shader) {
+		m_world.setSmooth(true);
+		auto const prescale = std::max(std::floor(m_scale), 1.0f);
+		m_shader.setUniform("source_size", sf::Glsl::Vec2{source.x, source.y});
+		m_shader.setUniform("prescale", sf::Glsl::Vec2{prescale, prescale});
+		states.shader = &m_shader;
+	} else {
+		// nearest up to the next whole multiple, then one bilinear step down to the window
+		auto const factor = static_cast<unsigned int>(std::ceil(m_scale));
+		if (ensure_prescale(factor)) {
+			m_world.setSmooth(false);
+			m_quad.clear();
+			append_quad(m_quad, {}, source * static_cast<float>(factor), sf::Color::White, {}, source);
+			m_prescale.setView(m_prescale.getDefaultView());
+			m_prescale.clear(sf::Color::Transparent);
+			m_prescale.draw(m_quad.data(), m_quad.size(), sf::PrimitiveType::Triangles, sf::RenderStates{texture});
+			m_prescale.display();
+			texture = &m_prescale.getTexture();
+		} else {
+			m_world.setSmooth(true);
+		}
+	}
+
+	m_quad.clear();
+	append_quad(m_quad, {m_output.left, m_output.top}, {m_output.width, m_output.height}, sf::Color::White, {}, to_vector(texture->getSize()));
+	states.texture = texture;
+	auto const previous = target.getView();
+	target.setView(sf::View{sf::FloatRect{{}, window}});
+	target.draw(m_quad.data(), m_quad.size(), sf::PrimitiveType::Triangles, states);
+	target.setView(previous);
+}
+
+void pixel_target::set_resolution(sf::Vector2u const resolution) {
+	if (resolution == m_config.resolution) { return; }
+	m_config.resolution = resolution;
+	m_world_ready = false;
+	// the prescale target is a multiple of the old resolution
+	m_prescale_factor = 0;
+}
+
+auto pixel_target::to_internal(sf::Vector2f const target_pos) const -> sf::Vector2f {
+	if (m_scale <= 0.0f) { return target_pos; }
+	return {(target_pos.x - m_output.left) / m_scale, (target_pos.y - m_output.top) / m_scale};
+}
+
+auto pixel_target::ensure_prescale(unsigned int const factor) -> bool {
+	if (factor == m_prescale_factor) { return true; }
+	auto const size = m_world.getSize() * factor;
+	if (!m_prescale.create(size)) {
+		CARISE_LOG_WARN("pixel target: failed to create {}x{} prescale texture", size.x, size.y);
+		m_prescale_factor = 0;
+		m_prescale_bytes.reset();
+		return false;
+	}
+	m_prescale.setSmooth(true);
+	m_prescale_bytes = track_texture(m_prescale);
+	m_prescale_factor = factor;
+	++m_recreated;
+	return true;
+}
+} // namespace carise
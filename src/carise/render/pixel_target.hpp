@@ -0,0 +1,76 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace carise {
+///
+/// \brief Fixed low-resolution render target for the world, upscaled to the window when presented.
+///
+/// Pixel art drawn at window resolution pays fill cost for every screen pixel; drawn here, the world costs
+/// the same at 4K as at 720p. The internal resolution only changes through set_resolution() (a setting for
+/// weak machines), so resizing the window reallocates nothing but, with sharp bilinear on a machine
+/// without shaders, the prescale target, and that only when the whole-number scale bucket changes.
+///
+/// Upscaling is letterboxed to keep the aspect ratio:
+/// - integer: the largest whole-number scale that fits, nearest filtering; pixels stay perfectly square.
+/// - sharp_bilinear: fills the window; each texel is a sharp block blended only across the last screen
+///   pixel at its edge, so non-integer scales neither shimmer nor blur. A fragment shader when available,
+///   otherwise a nearest-neighbour prescale to the next whole multiple followed by one bilinear draw.
+///
+class pixel_target {
+  public:
+	enum class filter : std::uint8_t { integer, sharp_bilinear };
+
+	struct config {
+		sf::Vector2u resolution{480, 270};
+		filter upscale{filter::sharp_bilinear};
+		/// \brief Colour of the letterbox bars.
+		sf::Color border{sf::Color::Black};
+	};
+
+	pixel_target() : pixel_target(config{}) {}
+	explicit pixel_target(config const& cfg);
+
+	///
+	/// \brief Clear the internal target for a new frame, creating it first if needed.
+	/// \returns The target to draw the world into (its view spans resolution() at 1:1 by default), or null if it could not be created
+	///
+	[[nodiscard]] auto begin(sf::Color clear = sf::Color::Black) -> sf::RenderTexture*;
+	/// \brief Clear target to the border colour and draw the frame upscaled into it (target's view is left unchanged).
+	void present(sf::RenderTarget& target);
+
+	/// \brief Takes effect at the next begin().
+	void set_resolution(sf::Vector2u resolution);
+	void set_filter(filter const upscale) { m_config.upscale = upscale; }
+
+	[[nodiscard]] auto resolution() const -> sf::Vector2u { return m_config.resolution; }
+	/// \brief Target pixels per internal pixel at the last present().
+	[[nodiscard]] auto scale() const -> float { return m_scale; }
+	/// \brief Where the frame was drawn at the last present(), in target pixels.
+	[[nodiscard]] auto output() const -> sf::FloatRect const& { return m_output; }
+	/// \brief Map a target pixel (the mouse, say) to internal pixel coordinates.
+	[[nodiscard]] auto to_internal(sf::Vector2f target_pos) const -> sf::Vector2f;
+	/// \brief Render textures (re)created so far.
+	[[nodiscard]] auto recreated() const -> std::size_t { return m_recreated; }
+
+  private:
+	[[nodiscard]] auto ensure_prescale(unsigned int factor) -> bool;
+
+	config m_config;
+	sf::RenderTexture m_world{};
+	memory::tracked_bytes m_world_bytes{};
+	bool m_world_ready{};
+	/// \brief Nearest-neighbour intermediate for sharp_bilinear without shaders, created on first use.
+	sf::RenderTexture m_prescale{};
+	memory::tracked_bytes m_prescale_bytes{};
+	unsigned int m_prescale_factor{};
+	sf::Shader m_shader{};
+	bool m_has_shader{};
+	float m_scale{1.0f};
+	sf::FloatRect m_output{};
+	std::vector<sf::Vertex> m_quad{};
+	std::size_t m_recreated{};
+};
+} // namespace carise
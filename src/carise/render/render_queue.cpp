@@ -0,0 +1,159 @@
+#include <carise/core/log.hpp>
+#include <carise/render/render_queue.hpp>
+#include <carise/render/vertices.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace carise {
+namespace {
+constexpr std::size_t max_materials_v{256};
+constexpr std::size_t max_textures_v{65536};
+
+auto texture_hash(sf::Texture const* const texture) -> std::size_t {
+	// Fibonacci hashing: textures are heap objects, so the low bits of the address carry little
+	return static_cast<std::size_t>((reinterpret_cast<std::uintptr_t>(texture) >> 4) * 0x9e3779b97f4a7c15ULL >> 32);
+}
+} // namespace
+
+render_queue::render_queue()
+	: m_batches_total(metrics::global().get_counter("carise_render_batches_total", "Draw calls issued by the render queue")),
+	  m_batches_saved_total(metrics::global().get_counter("carise_render_batches_saved_total", "Draw calls saved by sorting and merging queued commands")) {
+	m_layer_orders.fill(layer_order::depth);
+}
+
+void render_queue::submit(draw_key const& key, std::span<sf::Vertex const> const triangles, sf::Transform const& transform) {
+	if (triangles.empty() || !begin_command(key, triangles.size())) { return; }
+	for (auto vertex : triangles) {
+		vertex.position = transform.transformPoint(vertex.position);
+		m_vertices.push_back(vertex);
+	}
+}
+
+void render_queue::submit_quad(draw_key const& key, sf::Vector2f const top_left, sf::Vector2f const size, sf::Color const colour,
+							   sf::Vector2f const uv_top_left, sf::Vector2f const uv_size) {
+	if (!begin_command(key, 6)) { return; }
+	append_quad(m_vertices, top_left, size, colour, uv_top_left, uv_size);
+}
+
+auto render_queue::begin_command(draw_key const& key, std::size_t const vertex_count) -> bool {
+	auto mat = std::find_if(m_materials.begin(), m_materials.end(), [&key](material const& m) { return m.shader == key.shader && m.blend == key.blend; });
+	if (mat == m_materials.end()) {
+		if (m_materials.size() == max_materials_v) {
+			++m_stats.dropped;
+			return false;
+		}
+		mat = m_materials.insert(m_materials.end(), material{.shader = key.shader, .blend = key.blend});
+	}
+	// consecutive commands usually share a texture
+	auto const tex = !m_commands.empty() && m_textures[m_commands.back().texture] == key.texture ? std::size_t{m_commands.back().texture} : find_texture(key.texture);
+	if (tex == max_textures_v) {
+		++m_stats.dropped;
+		return false;
+	}
+
+	auto const material_id = static_cast<std::uint8_t>(mat - m_materials.begin());
+	auto const texture_id = static_cast<std::uint16_t>(tex);
+	auto const layer = std::uint64_t{key.layer} << 56;
+	auto const sort_key = m_layer_orders[key.layer] == layer_order::depth
+							  ? layer | std::uint64_t{key.depth} << 24 | std::uint64_t{material_id} << 16 | texture_id
+							  : layer | std::uint64_t{material_id} << 48 | std::uint64_t{texture_id} << 32 | key.depth;
+	if (m_commands.empty() || m_commands.back().texture != texture_id || m_commands.back().material != material_id) { ++m_stats.unsorted_batches; }
+	m_commands.push_back(command{
+		.key = sort_key,
+		.first = static_cast<std::uint32_t>(m_vertices.size()),
+		.count = static_cast<std::uint32_t>(vertex_count),
+		.texture = texture_id,
+		.material = material_id,
+	});
+	++m_stats.commands;
+	m_stats.vertices += vertex_count;
+	return true;
+}
+
+auto render_queue::find_texture(sf::Texture const* const texture) -> std::size_t {
+	// keep the table at most half full so probe runs stay short
+	if (m_textures.size() * 2 >= m_texture_slots.size() && m_textures.size() < max_textures_v) { rehash_textures(); }
+	auto const mask = m_texture_slots.size() - 1;
+	for (auto i = texture_hash(texture) & mask;; i = (i + 1) & mask) {
+		auto& slot = m_texture_slots[i];
+		if (slot.frame != m_frame) {
+			if (m_textures.size() == max_textures_v) { return max_textures_v; }
+			slot = texture_slot{.texture = texture, .frame = m_frame, .id = static_cast<std::uint16_t>(m_textures.size())};
+			m_textures.push_back(texture);
+			return slot.id;
+		}
+		if (slot.texture == texture) { return slot.id; }
+	}
+}
+
+void render_queue::rehash_textures() {
+	m_texture_slots.assign(std::max<std::size_t>(64, m_texture_slots.size() * 2), texture_slot{});
+	auto const mask = m_texture_slots.size() - 1;
+	for (std::size_t id = 0; id < m_textures.size(); ++id) {
+		auto i = texture_hash(m_textures[id]) & mask;
+		while (m_texture_slots[i].frame == m_frame) { i = (i + 1) & mask; }
+		m_texture_slots[i] = texture_slot{.texture = m_textures[id], .frame = m_frame, .id = static_cast<std::uint16_t>(id)};
+	}
+}
+
+void render_queue::sort() {
+	m_sorted.clear();
+	for (std::size_t i = 0; i < m_commands.size(); ++i) { m_sorted.push_back(sort_entry{.key = m_commands[i].key, .command = static_cast<std::uint32_t>(i)}); }
+	m_scratch.resize(m_sorted.size());
+
+	// LSD radix sort, one byte per pass; stable, so equal keys keep submission order
+	std::array<std::array<std::uint32_t, 256>, 8> histograms{};
+	for (auto const& e : m_sorted) {
+		for (std::size_t pass = 0; pass < 8; ++pass) { ++histograms[pass][(e.key >> (pass * 8)) & 0xff]; }
+	}
+	for (std::size_t pass = 0; pass < 8; ++pass) {
+		auto& counts = histograms[pass];
+		// every key has the same byte here (unused depth bits, a single layer, ...): nothing to reorder
+		if (std::find(counts.begin(), counts.end(), static_cast<std::uint32_t>(m_sorted.size())) != counts.end()) { continue; }
+		std::uint32_t offset{};
+		for (auto& count : counts) { offset += std::exchange(count, offset); }
+		for (auto const& e : m_sorted) { m_scratch[counts[(e.key >> (pass * 8)) & 0xff]++] = e; }
+		std::swap(m_sorted, m_scratch);
+	}
+}
+
+void render_queue::flush(sf::RenderTarget& target, sf::RenderStates const& states) {
+	sort();
+	m_batched.clear();
+	auto const draw_run = [&](command const& run, std::size_t const first) {
+		auto batch_states = states;
+		batch_states.texture = m_textures[run.texture];
+		batch_states.shader = m_materials[run.material].shader;
+		batch_states.blendMode = m_materials[run.material].blend;
+		target.draw(m_batched.data() + first, m_batched.size() - first, sf::PrimitiveType::Triangles, batch_states);
+		++m_stats.batches;
+	};
+	command const* run{};
+	std::size_t run_first{};
+	for (auto const& e : m_sorted) {
+		auto const& c = m_commands[e.command];
+		if (run && (c.texture != run->texture || c.material != run->material)) {
+			draw_run(*run, run_first);
+			run_first = m_batched.size();
+		}
+		run = &c;
+		m_batched.insert(m_batched.end(), m_vertices.begin() + c.first, m_vertices.begin() + c.first + c.count);
+	}
+	if (run) { draw_run(*run, run_first); }
+
+	m_batches_total.add(m_stats.batches);
+	// depth ordering can interleave states worse than submission order did
+	if (m_stats.unsorted_batches > m_stats.batches) { m_batches_saved_total.add(m_stats.unsorted_batches - m_stats.batches); }
+	if (m_stats.dropped > 0) { CARISE_LOG_DEBUG("render queue: {} commands over the per-frame shader / texture limits dropped", m_stats.dropped); }
+	m_last = std::exchange(m_stats, frame_stats{});
+	m_commands.clear();
+	m_vertices.clear();
+	m_materials.clear();
+	m_textures.clear();
+	// empties the texture table without touching it; on wrap around every stale stamp could look current again
+	if (++m_frame == 0) {
+		std::fill(m_texture_slots.begin(), m_texture_slots.end(), texture_slot{});
+		m_frame = 1;
+	}
+}
+} // namespace carise
@@ -0,0 +1,122 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <carise/core/metrics.hpp>
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace carise {
+/// \brief How commands within a layer are ordered.
+enum class layer_order : std::uint8_t {
+	/// \brief Back to front by depth, then by state: correct for overlapping translucent geometry.
+	depth,
+	/// \brief By state, then depth: fewest draws, for layers whose contents never overlap (or are opaque).
+	state,
+};
+
+/// \brief Render state and ordering of one submitted batch of triangles.
+struct draw_key {
+	/// \brief Drawn in ascending order.
+	std::uint8_t layer{};
+	/// \brief Back to front within the layer (eg screen y for a top-down view).
+	std::uint32_t depth{};
+	sf::Texture const* texture{};
+	sf::Shader const* shader{};
+	sf::BlendMode blend{sf::BlendAlpha};
+};
+
+///
+/// \brief Collects keyed triangle lists during the frame and draws them sorted and merged.
+///
+/// Vertices are copied (and transformed) at submission, so consecutive commands that end up with the same
+/// texture, shader and blend mode after the sort are drawn with a single call regardless of their layers,
+/// depths or transforms. Keys are 64 bit (layer, then shader+blend, texture and depth in the layer's order),
+/// sorted with a stable LSD radix sort.
+///
+/// Commands are triangle lists (see append_quad()). Storage, including the frame's texture and material
+/// tables, grows to the frame's high water mark and is reused, so a steady frame does not allocate.
+///
+class render_queue {
+  public:
+	struct frame_stats {
+		std::size_t commands{};
+		std::size_t vertices{};
+		/// \brief Draw calls issued.
+		std::size_t batches{};
+		/// \brief Draw calls the commands would have needed drawn in submission order.
+		std::size_t unsorted_batches{};
+		/// \brief Commands over the per-frame shader / texture limits, not drawn.
+		std::size_t dropped{};
+	};
+
+	render_queue();
+
+	render_queue(render_queue const&) = delete;
+	render_queue& operator=(render_queue const&) = delete;
+
+	void set_layer_order(std::uint8_t const layer, layer_order const order) { m_layer_orders[layer] = order; }
+
+	/// \brief Queue a triangle list, transformed to world space now.
+	void submit(draw_key const& key, std::span<sf::Vertex const> triangles, sf::Transform const& transform = sf::Transform::Identity);
+	/// \brief Queue one quad (a sprite, a glyph, ...).
+	void submit_quad(draw_key const& key, sf::Vector2f top_left, sf::Vector2f size, sf::Color colour, sf::Vector2f uv_top_left = {},
+					 sf::Vector2f uv_size = {});
+
+	/// \brief Draw everything queued since the last flush and clear the queue.
+	void flush(sf::RenderTarget& target, sf::RenderStates const& states = {});
+
+	[[nodiscard]] auto last_frame() const -> frame_stats const& { return m_last; }
+
+  private:
+	struct material {
+		sf::Shader const* shader{};
+		sf::BlendMode blend{};
+	};
+
+	struct command {
+		std::uint64_t key{};
+		std::uint32_t first{};
+		std::uint32_t count{};
+		std::uint16_t texture{};
+		std::uint8_t material{};
+	};
+
+	struct sort_entry {
+		std::uint64_t key{};
+		std::uint32_t command{};
+	};
+
+	/// \brief Open addressing slot mapping a texture to its index in m_textures; empty unless stamped this frame.
+	struct texture_slot {
+		sf::Texture const* texture{};
+		std::uint32_t frame{};
+		std::uint16_t id{};
+	};
+
+	/// \returns false if the frame's shader or texture tables are full
+	auto begin_command(draw_key const& key, std::size_t vertex_count) -> bool;
+	/// \returns The texture's index in m_textures, added if new; max_textures_v if the table is full
+	auto find_texture(sf::Texture const* texture) -> std::size_t;
+	void rehash_textures();
+	void sort();
+
+	std::array<layer_order, 256> m_layer_orders{};
+	std::vector<material> m_materials{};
+	std::vector<sf::Texture const*> m_textures{};
+	/// \brief Index into m_textures, power of two sized; flush() empties it by advancing m_frame.
+	std::vector<texture_slot> m_texture_slots{};
+	std::uint32_t m_frame{1};
+	std::vector<command> m_commands{};
+	std::vector<sort_entry> m_sorted{};
+	std::vector<sort_entry> m_scratch{};
+	memory::tagged_vector<sf::Vertex, memory::tag::render> m_vertices{};
+	memory::tagged_vector<sf::Vertex, memory::tag::render> m_batched{};
+	frame_stats m_stats{};
+	frame_stats m_last{};
+
+	metrics::counter& m_batches_total;
+	metrics::counter& m_batches_saved_total;
+};
+} // namespace carise
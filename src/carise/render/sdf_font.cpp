@@ -0,0 +1,382 @@
+#include <carise/core/log.hpp>
+#include <carise/render/sdf_font.hpp>
+#include <carise/render/texture_memory.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+
+namespace carise {
+namespace {
+constexpr std::uint32_t cache_magic_v{0x46445343}; // "CSDF"
+constexpr std::uint32_t cache_version_v{1};
+constexpr unsigned int atlas_width_v{512};
+constexpr float far_v{1e20f};
+
+constexpr auto fragment_shader_v = R"(#version 120
+uniform sampler2D atlas;
+uniform vec4 outline_colour;
+uniform float outline_width;
+uniform vec4 shadow_colour;
+uniform vec2 shadow_offset;
+uniform float shadow_softness;
+
+void main() {
+	vec2 uv = gl_TexCoord[0].xy;
+	float dist = texture2D(atlas, uv).a;
+	// one screen pixel in field units, so edges stay one pixel soft at any scale
+	float aa = max(fwidth(dist), 1e-4);
+	float body = smoothstep(0.5 - aa, 0.5 + aa, dist);
+	float outer = smoothstep(0.5 - outline_width - aa, 0.5 - outline_width + aa, dist);
+	vec4 glyph = mix(outline_colour, gl_Color, body);
+	glyph.a *= max(outer, body);
+	float shadow_dist = texture2D(atlas, uv - shadow_offset).a;
+	float shadow = smoothstep(0.5 - shadow_softness - aa, 0.5 + aa, shadow_dist) * shadow_colour.a;
+	float alpha = glyph.a + shadow * (1.0 - glyph.a);
+	vec3 rgb = (glyph.rgb * glyph.a + shadow_colour.rgb * shadow * (1.0 - glyph.a)) / max(alpha, 1e-4);
+	gl_FragColor = vec4(rgb, alpha);
+}
+)";
+
+/// \brief Exact 1D squared distance transform (Felzenszwalb and Huttenlocher) of n samples of f, stride apart.
+void distance_1d(float* f, std::size_t const n, std::size_t const stride, std::vector<float>& d, std::vector<std::size_t>& v, std::vector<float>& z) {
+	d.resize(n);
+	v.resize(n);
+	z.resize(n + 1);
+	auto const at = [&](std::size_t const i) -> float& { return f[i * stride]; };
+	auto k = std::size_t{};
+	v[0] = 0;
+	z[0] = -far_v;
+	z[1] = far_v;
+	auto const intersect = [&](std::size_t const q, std::size_t const p) {
+		return ((at(q) + static_cast<float>(q * q)) - (at(p) + static_cast<float>(p * p))) / (2.0f * static_cast<float>(q) - 2.0f * static_cast<float>(p));
+	};
+	for (std::size_t q = 1; q < n; ++q) {
+		auto s = intersect(q, v[k]);
+		// samples are at most far_v, so s stays above z[0] and the walk back ends at the first parabola
+		while (s <= z[k]) {
+			--k;
+			s = intersect(q, v[k]);
+		}
+		++k;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = far_v;
+	}
+	k = 0;
+	for (std::size_t q = 0; q < n; ++q) {
+		while (z[k + 1] < static_cast<float>(q)) { ++k; }
+		auto const delta = static_cast<float>(q) - static_cast<float>(v[k]);
+		d[q] = delta * delta + at(v[k]);
+	}
+	for (std::size_t q = 0; q < n; ++q) { at(q) = d[q]; }
+}
+
+/// \brief Squared distance from every cell of a width x height grid to the nearest cell that is 0 (others far_v).
+void distance_2d(std::vector<float>& grid, std::size_t const width, std::size_t const height) {
+	auto d = std::vector<float>{};
+	auto v = std::vector<std::size_t>{};
+	auto z = std::vector<float>{};
+	for (std::size_t x = 0; x < width; ++x) { distance_1d(grid.data() + x, height, width, d, v, z); }
+	for (std::size_t y = 0; y < height; ++y) { distance_1d(grid.data() + y * width, width, 1, d, v, z); }
+}
+
+template <typename Type>
+void write_value(std::ofstream& out, Type const& value) {
+	out.write(reinterpret_cast<char const*>(&value), sizeof(Type));
+}
+
+template <typename Type>
+auto read_value(std::ifstream& in) -> Type {
+	auto ret = Type{};
+	in.read(reinterpret_cast<char*>(&ret), sizeof(Type));
+	return ret;
+}
+} // namespace
+
+auto sdf_font::load(sf::Font const& font, std::string_view const font_key, std::filesystem::path const& cache_path, config const& cfg) -> bool {
+	m_config = cfg;
+	m_config.base_size = std::max(m_config.base_size, 1u);
+	m_config.spread = std::max(m_config.spread, 1u);
+	m_config.oversample = std::max(m_config.oversample, 1u);
+	m_font = &font;
+	if (read_cache(cache_path, font_key)) { return upload(); }
+	CARISE_LOG_INFO("sdf font: generating {} ({} px, spread {})", font_key, m_config.base_size, m_config.spread);
+	if (!generate(font)) { return false; }
+	write_cache(cache_path, font_key);
+	return upload();
+}
+
+auto sdf_font::shape(std::string_view const utf8, float const character_size, std::uint32_t const style) const -> glyph_run {
+	auto ret = glyph_run{};
+	if (m_glyphs.empty()) { return ret; }
+	auto const scale = character_size / static_cast<float>(m_config.base_size);
+	auto const shear = (style & sf::Text::Italic) != 0 ? italic_shear_v : 0.0f;
+	auto const space = m_glyphs.find(U' ');
+	auto const whitespace = space == m_glyphs.end() ? 0.0f : space->second.advance * scale;
+	auto const spacing = line_spacing(character_size);
+
+	auto pen = sf::Vector2f{0.0f, character_size};
+	auto width = 0.0f;
+	auto previous = std::uint32_t{};
+	for (std::size_t pos = 0; pos < utf8.size();) {
+		auto const code_point = next_code_point(utf8, pos);
+		if (code_point == U'\r') { continue; }
+		if (m_font) { pen.x += m_font->getKerning(previous, code_point, m_config.base_size) * scale; }
+		previous = code_point;
+		if (code_point == U'\n') {
+			width = std::max(width, pen.x);
+			pen = {0.0f, pen.y + spacing};
+			continue;
+		}
+		if (code_point == U'\t') {
+			pen.x += whitespace * 4.0f;
+			continue;
+		}
+		auto it = m_glyphs.find(code_point);
+		if (it == m_glyphs.end()) { it = m_glyphs.find(U'?'); }
+		if (it == m_glyphs.end()) { continue; }
+		auto const& g = it->second;
+		if (g.texels.x > 0) {
+			auto const top = g.cell.top * scale;
+			auto const bottom = (g.cell.top + g.cell.height) * scale;
+			auto const left = pen.x + g.cell.left * scale;
+			auto const right = left + g.cell.width * scale;
+			auto const uv = sf::Vector2f{static_cast<float>(g.texel.x), static_cast<float>(g.texel.y)};
+			auto const uv_end = uv + sf::Vector2f{static_cast<float>(g.texels.x), static_cast<float>(g.texels.y)};
+			auto const tl = sf::Vertex{{left - shear * top, pen.y + top}, sf::Color::White, uv};
+			auto const br = sf::Vertex{{right - shear * bottom, pen.y + bottom}, sf::Color::White, uv_end};
+			ret.vertices.push_back(tl);
+			ret.vertices.push_back(sf::Vertex{{right - shear * top, pen.y + top}, sf::Color::White, {uv_end.x, uv.y}});
+			ret.vertices.push_back(br);
+			ret.vertices.push_back(tl);
+			ret.vertices.push_back(br);
+			ret.vertices.push_back(sf::Vertex{{left - shear * bottom, pen.y + bottom}, sf::Color::White, {uv.x, uv_end.y}});
+		}
+		pen.x += g.advance * scale;
+	}
+	ret.size = {std::max(width, pen.x), pen.y - character_size + spacing};
+	ret.texture = &m_texture;
+	return ret;
+}
+
+auto sdf_font::generate(sf::Font const& font) -> bool {
+	auto const os = m_config.oversample;
+	auto const size = m_config.base_size * os;
+	auto const pad = static_cast<std::size_t>(m_config.spread * os);
+	m_glyphs.clear();
+	m_line_spacing = font.getLineSpacing(m_config.base_size);
+
+	// rasterise everything first: the page may grow (and move glyphs' pixels) while glyphs are added
+	auto code_points = std::vector<std::uint32_t>{};
+	for (auto cp = m_config.first; cp <= m_config.last; ++cp) {
+		if (cp < 32 || (cp >= 127 && cp < 160)) { continue; }
+		[[maybe_unused]] auto const& g = font.getGlyph(cp, size, false);
+		code_points.push_back(cp);
+	}
+	auto const page = font.getTexture(size).copyToImage();
+	auto const* pixels = page.getPixelsPtr();
+	auto const page_width = std::size_t{page.getSize().x};
+
+	// fields are packed on shelves atlas_width_v wide
+	struct pending {
+		std::uint32_t code_point{};
+		std::vector<std::uint8_t> field{};
+		sf::Vector2u texels{};
+	};
+	auto fields = std::vector<pending>{};
+	auto grid_inside = std::vector<float>{};
+	auto grid_outside = std::vector<float>{};
+	for (auto const cp : code_points) {
+		auto const& hi = font.getGlyph(cp, size, false);
+		auto& g = m_glyphs[cp];
+		g.advance = hi.advance / static_cast<float>(os);
+		auto const rect = hi.textureRect;
+		if (rect.width <= 0 || rect.height <= 0) { continue; }
+		// padded and rounded up to whole output texels
+		auto const w = (static_cast<std::size_t>(rect.width) + 2 * pad + os - 1) / os * os;
+		auto const h = (static_cast<std::size_t>(rect.height) + 2 * pad + os - 1) / os * os;
+		grid_inside.assign(w * h, far_v);
+		grid_outside.assign(w * h, 0.0f);
+		for (std::size_t y = 0; y < static_cast<std::size_t>(rect.height); ++y) {
+			for (std::size_t x = 0; x < static_cast<std::size_t>(rect.width); ++x) {
+				auto const source = (static_cast<std::size_t>(rect.top) + y) * page_width + static_cast<std::size_t>(rect.left) + x;
+				if (pixels[source * 4 + 3] < 128) { continue; }
+				auto const i = (y + pad) * w + x + pad;
+				grid_inside[i] = 0.0f;
+				grid_outside[i] = far_v;
+			}
+		}
+		// distance to the nearest inside texel (for outside texels) and to the nearest outside one (for inside texels)
+		distance_2d(grid_inside, w, h);
+		distance_2d(grid_outside, w, h);
+
+		auto out = pending{.code_point = cp, .texels = {static_cast<unsigned int>(w / os), static_cast<unsigned int>(h / os)}};
+		out.field.resize(std::size_t{out.texels.x} * out.texels.y);
+		auto const range = 2.0f * static_cast<float>(m_config.spread * os);
+		for (std::size_t ty = 0; ty < out.texels.y; ++ty) {
+			for (std::size_t tx = 0; tx < out.texels.x; ++tx) {
+				auto sum = 0.0f;
+				for (std::size_t sy = 0; sy < os; ++sy) {
+					for (std::size_t sx = 0; sx < os; ++sx) {
+						auto const i = (ty * os + sy) * w + tx * os + sx;
+						sum += grid_outside[i] > 0.0f ? std::sqrt(grid_outside[i]) - 0.5f : 0.5f - std::sqrt(grid_inside[i]);
+					}
+				}
+				auto const distance = sum / static_cast<float>(os * os);
+				out.field[ty * out.texels.x + tx] = static_cast<std::uint8_t>(std::clamp(0.5f + distance / range, 0.0f, 1.0f) * 255.0f + 0.5f);
+			}
+		}
+		g.cell = sf::FloatRect{{hi.bounds.left / static_cast<float>(os) - static_cast<float>(m_config.spread),
+								hi.bounds.top / static_cast<float>(os) - static_cast<float>(m_config.spread)},
+							   {static_cast<float>(out.texels.x), static_cast<float>(out.texels.y)}};
+		g.texels = out.texels;
+		fields.push_back(std::move(out));
+	}
+
+	// a field wider than the atlas cannot be packed; without its glyph, shape() falls back to '?'
+	std::erase_if(fields, [this](pending const& f) {
+		if (f.texels.x <= atlas_width_v) { return false; }
+		CARISE_LOG_WARN("sdf font: code point {} is {} texels wide, over the {} texel atlas", f.code_point, f.texels.x, atlas_width_v);
+		m_glyphs.erase(f.code_point);
+		return true;
+	});
+	// tallest first keeps the shelves tight
+	std::sort(fields.begin(), fields.end(), [](pending const& a, pending const& b) { return a.texels.y > b.texels.y; });
+	auto cursor = sf::Vector2u{};
+	auto shelf = 0u;
+	for (auto const& f : fields) {
+		if (cursor.x + f.texels.x > atlas_width_v) { cursor = {0, cursor.y + shelf}; }
+		if (cursor.x == 0) { shelf = f.texels.y; }
+		m_glyphs[f.code_point].texel = cursor;
+		cursor.x += f.texels.x;
+	}
+	m_atlas_size = {atlas_width_v, std::bit_ceil(std::max(cursor.y + shelf, 1u))};
+	if (m_atlas_size.y > sf::Texture::getMaximumSize()) {
+		CARISE_LOG_WARN("sdf font: {}x{} atlas exceeds the maximum texture size", m_atlas_size.x, m_atlas_size.y);
+		return false;
+	}
+	m_field.assign(std::size_t{m_atlas_size.x} * m_atlas_size.y, 0);
+	for (auto const& f : fields) {
+		auto const origin = m_glyphs[f.code_point].texel;
+		for (std::size_t y = 0; y < f.texels.y; ++y) {
+			std::copy_n(f.field.data() + y * f.texels.x, f.texels.x, m_field.data() + (origin.y + y) * m_atlas_size.x + origin.x);
+		}
+	}
+	return true;
+}
+
+auto sdf_font::read_cache(std::filesystem::path const& path, std::string_view const font_key) -> bool {
+	auto in = std::ifstream{path, std::ios::binary};
+	if (!in) { return false; }
+	if (read_value<std::uint32_t>(in) != cache_magic_v || read_value<std::uint32_t>(in) != cache_version_v) { return false; }
+	auto const key_length = read_value<std::uint32_t>(in);
+	auto key = std::string(key_length, '\0');
+	in.read(key.data(), key_length);
+	auto const stored = config{
+		.base_size = read_value<std::uint32_t>(in),
+		.spread = read_value<std::uint32_t>(in),
+		.oversample = read_value<std::uint32_t>(in),
+		.first = read_value<std::uint32_t>(in),
+		.last = read_value<std::uint32_t>(in),
+	};
+	if (!in || key != font_key || stored.base_size != m_config.base_size || stored.spread != m_config.spread || stored.oversample != m_config.oversample ||
+		stored.first != m_config.first || stored.last != m_config.last) {
+		return false;
+	}
+	m_line_spacing = read_value<float>(in);
+	m_atlas_size.x = read_value<std::uint32_t>(in);
+	m_atlas_size.y = read_value<std::uint32_t>(in);
+	auto const count = read_value<std::uint32_t>(in);
+	if (!in || m_atlas_size.x > sf::Texture::getMaximumSize() || m_atlas_size.y > sf::Texture::getMaximumSize()) { return false; }
+	m_glyphs.clear();
+	for (std::uint32_t i = 0; i < count && in; ++i) {
+		auto const cp = read_value<std::uint32_t>(in);
+		auto& g = m_glyphs[cp];
+		g.advance = read_value<float>(in);
+		auto const left = read_value<float>(in);
+		auto const top = read_value<float>(in);
+		g.texel = {read_value<std::uint32_t>(in), read_value<std::uint32_t>(in)};
+		g.texels = {read_value<std::uint32_t>(in), read_value<std::uint32_t>(in)};
+		g.cell = sf::FloatRect{{left, top}, {static_cast<float>(g.texels.x), static_cast<float>(g.texels.y)}};
+	}
+	m_field.resize(std::size_t{m_atlas_size.x} * m_atlas_size.y);
+	in.read(reinterpret_cast<char*>(m_field.data()), static_cast<std::streamsize>(m_field.size()));
+	if (!in) {
+		CARISE_LOG_WARN("sdf font: {} is truncated, regenerating", path.string());
+		m_glyphs.clear();
+		return false;
+	}
+	return true;
+}
+
+void sdf_font::write_cache(std::filesystem::path const& path, std::string_view const font_key) const {
+	auto ec = std::error_code{};
+	if (path.has_parent_path()) { std::filesystem::create_directories(path.parent_path(), ec); }
+	auto out = std::ofstream{path, std::ios::binary | std::ios::trunc};
+	if (!out) {
+		CARISE_LOG_WARN("sdf font: cannot write {}, the atlas will be generated again next run", path.string());
+		return;
+	}
+	write_value(out, cache_magic_v);
+	write_value(out, cache_version_v);
+	write_value(out, static_cast<std::uint32_t>(font_key.size()));
+	out.write(font_key.data(), static_cast<std::streamsize>(font_key.size()));
+	for (auto const value : {m_config.base_size, m_config.spread, m_config.oversample, m_config.first, m_config.last}) { write_value(out, std::uint32_t{value}); }
+	write_value(out, m_line_spacing);
+	write_value(out, m_atlas_size.x);
+	write_value(out, m_atlas_size.y);
+	write_value(out, static_cast<std::uint32_t>(m_glyphs.size()));
+	for (auto const& [cp, g] : m_glyphs) {
+		write_value(out, cp);
+		write_value(out, g.advance);
+		write_value(out, g.cell.left);
+		write_value(out, g.cell.top);
+		for (auto const value : {g.texel.x, g.texel.y, g.texels.x, g.texels.y}) { write_value(out, std::uint32_t{value}); }
+	}
+	out.write(reinterpret_cast<char const*>(m_field.data()), static_cast<std::streamsize>(m_field.size()));
+}
+
+auto sdf_font::upload() -> bool {
+	auto pixels = std::vector<std::uint8_t>(m_field.size() * 4, 255);
+	for (std::size_t i = 0; i < m_field.size(); ++i) { pixels[i * 4 + 3] = m_field[i]; }
+	auto image = sf::Image{};
+	image.create(m_atlas_size, pixels.data());
+	if (!m_texture.loadFromImage(image)) {
+		CARISE_LOG_WARN("sdf font: failed to upload {}x{} atlas", m_atlas_size.x, m_atlas_size.y);
+		return false;
+	}
+	// bilinear filtering of the field is what keeps magnified edges smooth
+	m_texture.setSmooth(true);
+	m_texture_bytes = track_texture(m_texture, false, memory::tag::ui);
+	return true;
+}
+
+auto sdf_shader::create() -> bool {
+	if (!is_available()) { return false; }
+	if (!m_shader.loadFromMemory(fragment_shader_v, sf::Shader::Type::Fragment)) {
+		CARISE_LOG_WARN("sdf shader: failed to compile fragment shader");
+		return false;
+	}
+	m_shader.setUniform("atlas", sf::Shader::CurrentTexture);
+	m_shader.setUniform("outline_colour", sf::Glsl::Vec4{sf::Color::Transparent});
+	m_shader.setUniform("outline_width", 0.0f);
+	m_shader.setUniform("shadow_colour", sf::Glsl::Vec4{sf::Color::Transparent});
+	m_shader.setUniform("shadow_offset", sf::Glsl::Vec2{});
+	m_shader.setUniform("shadow_softness", 0.0f);
+	return true;
+}
+
+void sdf_shader::apply(sdf_font const& font, effects const& fx) {
+	// the field spans 2 * spread pixels at base size over 0..1
+	auto const field_per_pixel = 1.0f / (2.0f * static_cast<float>(font.spread()));
+	auto const atlas = font.texture().getSize();
+	auto const spread = static_cast<float>(font.spread());
+	m_shader.setUniform("outline_colour", sf::Glsl::Vec4{fx.outline});
+	m_shader.setUniform("outline_width", std::min(fx.outline_width, spread) * field_per_pixel);
+	m_shader.setUniform("shadow_colour", sf::Glsl::Vec4{fx.shadow});
+	m_shader.setUniform("shadow_offset",
+						sf::Glsl::Vec2{atlas.x > 0 ? fx.shadow_offset.x / static_cast<float>(atlas.x) : 0.0f, atlas.y > 0 ? fx.shadow_offset.y / static_cast<float>(atlas.y) : 0.0f});
+	m_shader.setUniform("shadow_softness", std::min(fx.shadow_softness, spread) * field_per_pixel);
+}
+} // namespace carise
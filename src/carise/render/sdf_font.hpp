@@ -0,0 +1,113 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <carise/render/glyph_run.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace carise {
+///
+/// \brief One signed distance field atlas that draws a font crisply at any size.
+///
+/// Each glyph is rasterised once, oversampled, through sf::Font; its distance field is stored in the alpha
+/// channel, 0.5 on the outline and falling off over spread pixels either side. Generating the atlas takes a
+/// moment, so load() writes it next to the game and reuses it while the font key and config match.
+///
+/// Draw shaped runs with an sdf_shader bound; without one the raw field shows as blurry glyphs. Kerning is
+/// still queried from the sf::Font, which must outlive the sdf_font.
+///
+class sdf_font {
+  public:
+	struct config {
+		/// \brief Size the field is stored at; quads are scaled from it.
+		unsigned int base_size{32};
+		/// \brief Distance range either side of the outline, in pixels at base_size (bounds outline width and shadow offset).
+		unsigned int spread{6};
+		/// \brief Each glyph is rasterised this many times larger before its field is downsampled.
+		unsigned int oversample{4};
+		std::uint32_t first{32};
+		std::uint32_t last{255};
+	};
+
+	///
+	/// \brief Load the atlas from cache_path, or generate it from font and write it there.
+	/// \param font_key Identifies the font (its path, say); a cache made from another key or config is regenerated
+	/// \returns false if the atlas could not be generated or uploaded
+	///
+	[[nodiscard]] auto load(sf::Font const& font, std::string_view font_key, std::filesystem::path const& cache_path, config const& cfg) -> bool;
+	[[nodiscard]] auto load(sf::Font const& font, std::string_view const font_key, std::filesystem::path const& cache_path) -> bool {
+		return load(font, font_key, cache_path, config{});
+	}
+
+	///
+	/// \brief Shape a UTF-8 string at character_size (any size, fractional included).
+	///
+	/// Supports regular and italic text; the quads are padded by the spread so outlines and shadows fit.
+	///
+	[[nodiscard]] auto shape(std::string_view utf8, float character_size, std::uint32_t style = sf::Text::Regular) const -> glyph_run;
+
+	[[nodiscard]] auto texture() const -> sf::Texture const& { return m_texture; }
+	[[nodiscard]] auto base_size() const -> unsigned int { return m_config.base_size; }
+	[[nodiscard]] auto spread() const -> unsigned int { return m_config.spread; }
+	[[nodiscard]] auto line_spacing(float const character_size) const -> float { return m_line_spacing * character_size / static_cast<float>(m_config.base_size); }
+
+  private:
+	/// \brief Metrics at base_size; the cell rectangle already includes the spread.
+	struct glyph {
+		float advance{};
+		sf::FloatRect cell{};
+		sf::Vector2u texel{};
+		sf::Vector2u texels{};
+	};
+
+	[[nodiscard]] auto generate(sf::Font const& font) -> bool;
+	[[nodiscard]] auto read_cache(std::filesystem::path const& path, std::string_view font_key) -> bool;
+	void write_cache(std::filesystem::path const& path, std::string_view font_key) const;
+	[[nodiscard]] auto upload() -> bool;
+
+	config m_config{};
+	sf::Font const* m_font{};
+	std::unordered_map<std::uint32_t, glyph> m_glyphs{};
+	float m_line_spacing{};
+	sf::Vector2u m_atlas_size{};
+	/// \brief One distance byte per texel.
+	std::vector<std::uint8_t> m_field{};
+	sf::Texture m_texture{};
+	memory::tracked_bytes m_texture_bytes{};
+};
+
+///
+/// \brief Fragment shader that turns an sdf_font atlas into anti-aliased text, with optional outline and drop shadow.
+///
+/// Both effects are evaluated from the same field in the one pass, so styled text costs no extra draws.
+/// Needs GLSL 1.20; check is_available().
+///
+class sdf_shader {
+  public:
+	struct effects {
+		sf::Color outline{sf::Color::Transparent};
+		/// \brief Outline thickness in pixels at the font's base size (at most its spread).
+		float outline_width{};
+		sf::Color shadow{sf::Color::Transparent};
+		/// \brief Shadow offset in pixels at the font's base size (keep its length under the spread).
+		sf::Vector2f shadow_offset{};
+		/// \brief Extra blur of the shadow edge, in pixels at the font's base size.
+		float shadow_softness{};
+	};
+
+	[[nodiscard]] static auto is_available() -> bool { return sf::Shader::isAvailable(); }
+
+	[[nodiscard]] auto create() -> bool;
+	/// \brief Set the effects for font; call before each draw whose font or effects differ.
+	void apply(sdf_font const& font, effects const& fx);
+
+	[[nodiscard]] auto shader() const -> sf::Shader const& { return m_shader; }
+
+  private:
+	sf::Shader m_shader{};
+};
+} // namespace carise
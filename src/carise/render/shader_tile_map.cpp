@@ -0,0 +1,122 @@
+#include <carise/core/log.hpp>
+#include <carise/render/shader_tile_map.hpp>
+#include <carise/render/texture_memory.hpp>
+#include <carise/render/vertices.hpp>
+#include <carise/render/view_bounds.hpp>
+#include <algorithm>
+
+namespace carise {
+namespace {
+// texture coordinates arrive normalised over the index texture (SFML scales pixel coordinates for us)
+constexpr auto fragment_shader_v = R"(#version 120
+uniform sampler2D index_map;
+uniform sampler2D atlas;
+uniform vec2 map_size;
+uniform vec2 tile_uv;
+uniform vec2 tile_inset;
+uniform float columns;
+
+float decode(vec2 bytes) { return floor(bytes.x * 255.0 + 0.5) + floor(bytes.y * 255.0 + 0.5) * 256.0; }
+
+vec4 tile(float id, vec2 within) {
+	vec2 cell = vec2(mod(id, columns), floor(id / columns));
+	return texture2D(atlas, (cell + within) * tile_uv);
+}
+
+void main() {
+	vec2 pos = gl_TexCoord[0].xy * map_size;
+	vec2 cell = floor(pos);
+	// keep half a texel away from tile edges so neighbouring atlas tiles never bleed in
+	vec2 within = clamp(pos - cell, tile_inset, 1.0 - tile_inset);
+	vec4 index = texture2D(index_map, (cell + 0.5) / map_size);
+	vec4 colour = tile(decode(index.rg), within);
+	float wall = decode(index.ba);
+	if (wall < 65535.0) {
+		vec4 top = tile(wall, within);
+		colour = vec4(mix(colour.rgb, top.rgb, top.a), max(colour.a, top.a));
+	}
+	gl_FragColor = colour * gl_Color;
+}
+)";
+} // namespace
+
+auto shader_tile_map::create(tile_map const& map) -> bool {
+	if (!is_available() || !m_atlas.texture()) { return false; }
+	auto const size = sf::Vector2u{static_cast<unsigned int>(map.size().x), static_cast<unsigned int>(map.size().y)};
+	if (size.x > sf::Texture::getMaximumSize() || size.y > sf::Texture::getMaximumSize()) {
+		CARISE_LOG_WARN("shader tile map: {}x{} map exceeds the maximum texture size", size.x, size.y);
+		return false;
+	}
+	if (!m_shader.loadFromMemory(fragment_shader_v, sf::Shader::Type::Fragment)) {
+		CARISE_LOG_WARN("shader tile map: failed to compile fragment shader");
+		return false;
+	}
+	if (!m_index.create(size)) { return false; }
+	m_index_bytes = track_texture(m_index);
+
+	auto const atlas_size = m_atlas.texture()->getSize();
+	auto const tile = m_atlas.tile_size();
+	m_shader.setUniform("index_map", sf::Shader::CurrentTexture);
+	m_shader.setUniform("atlas", *m_atlas.texture());
+	m_shader.setUniform("map_size", sf::Glsl::Vec2{static_cast<float>(size.x), static_cast<float>(size.y)});
+	m_shader.setUniform("tile_uv", sf::Glsl::Vec2{tile.x / static_cast<float>(atlas_size.x), tile.y / static_cast<float>(atlas_size.y)});
+	m_shader.setUniform("tile_inset", sf::Glsl::Vec2{0.5f / tile.x, 0.5f / tile.y});
+	m_shader.setUniform("columns", static_cast<float>(m_atlas.columns()));
+
+	m_map_size = map.size();
+	m_revisions.assign(static_cast<std::size_t>(map.chunk_count().x * map.chunk_count().y), 0);
+	m_pixels.resize(static_cast<std::size_t>(tile_map::chunk_size_v * tile_map::chunk_size_v * 4));
+	for (int cy = 0; cy < map.chunk_count().y; ++cy) {
+		for (int cx = 0; cx < map.chunk_count().x; ++cx) { upload(map, {cx, cy}); }
+	}
+	return true;
+}
+
+void shader_tile_map::update(tile_map const& map) {
+	m_uploaded = 0;
+	if (map.size() != m_map_size) {
+		if (!create(map)) { CARISE_LOG_WARN("shader tile map: failed to recreate for resized map"); }
+		return;
+	}
+	for (int cy = 0; cy < map.chunk_count().y; ++cy) {
+		for (int cx = 0; cx < map.chunk_count().x; ++cx) {
+			if (map.chunk_revision({cx, cy}) != m_revisions[static_cast<std::size_t>(cy * map.chunk_count().x + cx)]) { upload(map, {cx, cy}); }
+		}
+	}
+}
+
+void shader_tile_map::upload(tile_map const& map, sf::Vector2i const chunk) {
+	auto const origin = chunk * tile_map::chunk_size_v;
+	auto const extent = sf::Vector2i{std::min(tile_map::chunk_size_v, m_map_size.x - origin.x), std::min(tile_map::chunk_size_v, m_map_size.y - origin.y)};
+	auto* out = m_pixels.data();
+	for (int y = 0; y < extent.y; ++y) {
+		for (int x = 0; x < extent.x; ++x) {
+			auto const floor = map.floor(origin + sf::Vector2i{x, y});
+			auto const wall = map.wall(origin + sf::Vector2i{x, y});
+			*out++ = static_cast<std::uint8_t>(floor & 0xff);
+			*out++ = static_cast<std::uint8_t>(floor >> 8);
+			*out++ = static_cast<std::uint8_t>(wall & 0xff);
+			*out++ = static_cast<std::uint8_t>(wall >> 8);
+		}
+	}
+	m_index.update(m_pixels.data(), {static_cast<unsigned int>(extent.x), static_cast<unsigned int>(extent.y)},
+				   {static_cast<unsigned int>(origin.x), static_cast<unsigned int>(origin.y)});
+	m_revisions[static_cast<std::size_t>(chunk.y * map.chunk_count().x + chunk.x)] = map.chunk_revision(chunk);
+	++m_uploaded;
+}
+
+void shader_tile_map::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+	if (m_map_size.x == 0 || m_map_size.y == 0) { return; }
+	auto const tile = m_atlas.tile_size();
+	auto const [lo, hi] = cell_range(view_bounds(target.getView()), tile, m_map_size);
+	if (lo.x >= hi.x || lo.y >= hi.y) { return; }
+	auto const tile_lo = sf::Vector2f{static_cast<float>(lo.x), static_cast<float>(lo.y)};
+	auto const tiles = sf::Vector2f{static_cast<float>(hi.x - lo.x), static_cast<float>(hi.y - lo.y)};
+	m_quad.clear();
+	// position in world units, texture coordinates in index texels (= tiles)
+	append_quad(m_quad, {tile_lo.x * tile.x, tile_lo.y * tile.y}, {tiles.x * tile.x, tiles.y * tile.y}, sf::Color::White, tile_lo, tiles);
+	states.texture = &m_index;
+	states.shader = &m_shader;
+	target.draw(m_quad.data(), m_quad.size(), sf::PrimitiveType::Triangles, states);
+}
+} // namespace carise
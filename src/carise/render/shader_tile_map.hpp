@@ -0,0 +1,53 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <carise/render/tile_atlas.hpp>
+#include <carise/world/tile_map.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace carise {
+///
+/// \brief Draws a tile_map as a single quad per frame, resolving tiles in a fragment shader.
+///
+/// The map's floor and wall ids live in an RGBA8 index texture, one texel per tile (floor id in RG, wall id in
+/// BA); the shader finds the tile under each pixel, fetches its id and samples the atlas. The CPU only draws one
+/// quad over the visible part of the map and re-uploads the chunks whose revision changed, so scrolling and
+/// zooming cost nothing beyond fill rate.
+///
+/// Needs GLSL 1.20 (any desktop GL 2.1 driver, including Mesa's llvmpipe); check is_available() and keep
+/// tile_map_renderer as the fallback.
+///
+class shader_tile_map {
+  public:
+	explicit shader_tile_map(tile_atlas const& atlas) : m_atlas(atlas) {}
+
+	[[nodiscard]] static auto is_available() -> bool { return sf::Shader::isAvailable(); }
+
+	///
+	/// \brief Compile the shader and upload the whole map.
+	/// \returns false if shaders are unsupported or the map exceeds the maximum texture size
+	///
+	[[nodiscard]] auto create(tile_map const& map) -> bool;
+	/// \brief Re-upload chunks edited since the previous call.
+	void update(tile_map const& map);
+	/// \brief Draw the part of the map visible in target's current view.
+	void draw(sf::RenderTarget& target, sf::RenderStates states = {}) const;
+
+	/// \brief Chunks uploaded by the last update().
+	[[nodiscard]] auto uploaded() const -> std::size_t { return m_uploaded; }
+
+  private:
+	void upload(tile_map const& map, sf::Vector2i chunk);
+
+	tile_atlas const& m_atlas;
+	sf::Shader m_shader{};
+	sf::Texture m_index{};
+	memory::tracked_bytes m_index_bytes{};
+	sf::Vector2i m_map_size{};
+	std::vector<std::uint64_t> m_revisions{};
+	std::vector<std::uint8_t> m_pixels{};
+	mutable std::vector<sf::Vertex> m_quad{};
+	std::size_t m_uploaded{};
+};
+} // namespace carise
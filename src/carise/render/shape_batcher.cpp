@@ -0,0 +1,101 @@
+#include <carise/core/log.hpp>
+#include <carise/render/shape_batcher.hpp>
+#include <carise/render/vertices.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+
+namespace carise {
+shape_batcher::shape_batcher() : m_use_buffer(sf::VertexBuffer::isAvailable()) {}
+
+void shape_batcher::circle(sf::Vector2f const centre, float const radius, sf::Color const colour, std::size_t const points) {
+	auto const unit = unit_circle(points);
+	for (std::size_t i = 0; i + 1 < unit.size(); ++i) {
+		m_vertices.push_back(sf::Vertex{centre, colour});
+		m_vertices.push_back(sf::Vertex{centre + unit[i] * radius, colour});
+		m_vertices.push_back(sf::Vertex{centre + unit[i + 1] * radius, colour});
+	}
+}
+
+void shape_batcher::ring(sf::Vector2f const centre, float const radius, float const thickness, sf::Color const colour, std::size_t const points) {
+	auto const unit = unit_circle(points);
+	auto const inner = radius - thickness / 2.0f;
+	auto const outer = radius + thickness / 2.0f;
+	for (std::size_t i = 0; i + 1 < unit.size(); ++i) {
+		auto const a = sf::Vertex{centre + unit[i] * inner, colour};
+		auto const b = sf::Vertex{centre + unit[i] * outer, colour};
+		auto const c = sf::Vertex{centre + unit[i + 1] * outer, colour};
+		auto const d = sf::Vertex{centre + unit[i + 1] * inner, colour};
+		m_vertices.push_back(a);
+		m_vertices.push_back(b);
+		m_vertices.push_back(c);
+		m_vertices.push_back(a);
+		m_vertices.push_back(c);
+		m_vertices.push_back(d);
+	}
+}
+
+void shape_batcher::rectangle(sf::Vector2f const top_left, sf::Vector2f const size, sf::Color const colour) { append_quad(m_vertices, top_left, size, colour); }
+
+void shape_batcher::line(sf::Vector2f const from, sf::Vector2f const to, float const thickness, sf::Color const colour) {
+	auto const delta = to - from;
+	auto const length = std::hypot(delta.x, delta.y);
+	if (length <= 0.0f) { return; }
+	auto const normal = sf::Vector2f{-delta.y, delta.x} * (thickness / 2.0f / length);
+	auto const a = sf::Vertex{from + normal, colour};
+	auto const b = sf::Vertex{to + normal, colour};
+	auto const c = sf::Vertex{to - normal, colour};
+	auto const d = sf::Vertex{from - normal, colour};
+	m_vertices.push_back(a);
+	m_vertices.push_back(b);
+	m_vertices.push_back(c);
+	m_vertices.push_back(a);
+	m_vertices.push_back(c);
+	m_vertices.push_back(d);
+}
+
+void shape_batcher::polygon(std::span<sf::Vector2f const> const points, sf::Color const colour) {
+	// fan from the first point: exact for convex polygons
+	for (std::size_t i = 1; i + 1 < points.size(); ++i) {
+		m_vertices.push_back(sf::Vertex{points[0], colour});
+		m_vertices.push_back(sf::Vertex{points[i], colour});
+		m_vertices.push_back(sf::Vertex{points[i + 1], colour});
+	}
+}
+
+void shape_batcher::flush(sf::RenderTarget& target, sf::RenderStates const& states) {
+	if (m_vertices.empty()) { return; }
+	if (m_use_buffer) {
+		if (m_buffer.getVertexCount() < m_vertices.size()) {
+			// grow in powers of two so a slowly growing frame does not reallocate every flush
+			if (!m_buffer.create(std::bit_ceil(m_vertices.size()))) {
+				CARISE_LOG_WARN("shape batcher: failed to create vertex buffer, falling back to vertex arrays");
+				m_use_buffer = false;
+			}
+		}
+		if (m_use_buffer && m_buffer.update(m_vertices.data(), m_vertices.size(), 0)) {
+			target.draw(m_buffer, 0, m_vertices.size(), states);
+			m_vertices.clear();
+			return;
+		}
+	}
+	target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+	m_vertices.clear();
+}
+
+auto shape_batcher::unit_circle(std::size_t points) -> std::span<sf::Vector2f const> {
+	points = std::clamp(points, std::size_t{3}, max_points_v);
+	if (m_unit_circles.size() <= points) { m_unit_circles.resize(points + 1); }
+	auto& ret = m_unit_circles[points];
+	if (ret.empty()) {
+		ret.reserve(points + 1);
+		for (std::size_t i = 0; i <= points; ++i) {
+			// same start point and winding as sf::CircleShape
+			auto const angle = static_cast<float>(i % points) * 2.0f * std::numbers::pi_v<float> / static_cast<float>(points) - std::numbers::pi_v<float> / 2.0f;
+			ret.emplace_back(std::cos(angle), std::sin(angle));
+		}
+	}
+	return ret;
+}
+} // namespace carise
@@ -0,0 +1,47 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <SFML/Graphics.hpp>
+#include <span>
+#include <vector>
+
+namespace carise {
+///
+/// \brief Immediate-mode untextured shapes (debug draw, UI primitives), drawn with one call per flush.
+///
+/// Every sf::Shape owns its own geometry and costs at least one draw call. Here shapes are tessellated into
+/// one triangle list instead: circles are scaled copies of a unit circle cached per point count, and the
+/// list is streamed into a single sf::VertexBuffer grown to the frame's high water mark (plain vertex
+/// arrays where vertex buffers are unsupported).
+///
+class shape_batcher {
+  public:
+	shape_batcher();
+
+	shape_batcher(shape_batcher const&) = delete;
+	shape_batcher& operator=(shape_batcher const&) = delete;
+
+	void circle(sf::Vector2f centre, float radius, sf::Color colour, std::size_t points = 30);
+	/// \brief Circle outline of thickness centred on radius.
+	void ring(sf::Vector2f centre, float radius, float thickness, sf::Color colour, std::size_t points = 30);
+	void rectangle(sf::Vector2f top_left, sf::Vector2f size, sf::Color colour);
+	void line(sf::Vector2f from, sf::Vector2f to, float thickness, sf::Color colour);
+	/// \brief Filled convex polygon, points in order around it.
+	void polygon(std::span<sf::Vector2f const> points, sf::Color colour);
+
+	/// \brief Draw every shape added since the last flush and clear the batch.
+	void flush(sf::RenderTarget& target, sf::RenderStates const& states = {});
+
+	[[nodiscard]] auto vertex_count() const -> std::size_t { return m_vertices.size(); }
+
+  private:
+	static constexpr std::size_t max_points_v{256};
+
+	[[nodiscard]] auto unit_circle(std::size_t points) -> std::span<sf::Vector2f const>;
+
+	/// \brief Indexed by point count, filled on first use; each holds points + 1 entries (first repeated).
+	std::vector<std::vector<sf::Vector2f>> m_unit_circles{};
+	memory::tagged_vector<sf::Vertex, memory::tag::render> m_vertices{};
+	sf::VertexBuffer m_buffer{sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Stream};
+	bool m_use_buffer{};
+};
+} // namespace carise
@@ -0,0 +1,117 @@
+#include <carise/core/log.hpp>
+#include <carise/render/static_layer_cache.hpp>
+#include <carise/render/texture_memory.hpp>
+#include <carise/render/vertices.hpp>
+#include <carise/render/view_bounds.hpp>
+#include <algorithm>
+
+namespace carise {
+static_layer_cache::static_layer_cache(tile_map_renderer const& renderer, config const& cfg) : m_renderer(renderer), m_config(cfg) {
+	auto const tile = renderer.atlas().tile_size();
+	m_texture_size = {static_cast<unsigned int>(tile.x) * tile_map::chunk_size_v, static_cast<unsigned int>(tile.y) * tile_map::chunk_size_v};
+	m_evictor = memory::global().add_evictor(memory::tag::textures, [this](std::size_t const over) { return evict(over); });
+}
+
+static_layer_cache::~static_layer_cache() { memory::global().remove_evictor(m_evictor); }
+
+void static_layer_cache::update(tile_map const& map, sf::View const& view) {
+	++m_frame;
+	m_refreshed = 0;
+	if (map.chunk_count() != m_chunk_count) {
+		for (auto& s : m_slots) { s->in_use = false; }
+		m_chunk_count = map.chunk_count();
+		m_slot_of.assign(static_cast<std::size_t>(m_chunk_count.x * m_chunk_count.y), nullptr);
+	}
+	auto const chunk_size = m_renderer.atlas().tile_size() * static_cast<float>(tile_map::chunk_size_v);
+	auto const [lo, hi] = cell_range(view_bounds(view), chunk_size, m_chunk_count);
+	for (int cy = lo.y; cy < hi.y; ++cy) {
+		for (int cx = lo.x; cx < hi.x; ++cx) {
+			auto& cached = m_slot_of[chunk_index({cx, cy})];
+			if (!cached) {
+				cached = acquire_slot();
+				if (!cached) { continue; }
+				cached->chunk = {cx, cy};
+				cached->in_use = true;
+				render(*cached, {cx, cy});
+			} else if (cached->revision != map.chunk_revision({cx, cy}) || cached->animation != m_renderer.animation_revision({cx, cy})) {
+				render(*cached, {cx, cy});
+			}
+			cached->revision = map.chunk_revision({cx, cy});
+			// read after rendering: drawing the chunk is what tells the renderer which clips it shows
+			cached->animation = m_renderer.animation_revision({cx, cy});
+			cached->last_used = m_frame;
+		}
+	}
+}
+
+void static_layer_cache::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+	auto const chunk_size = m_renderer.atlas().tile_size() * static_cast<float>(tile_map::chunk_size_v);
+	auto const [lo, hi] = cell_range(view_bounds(target.getView()), chunk_size, m_chunk_count);
+	auto const uv_size = sf::Vector2f{static_cast<float>(m_texture_size.x), static_cast<float>(m_texture_size.y)};
+	for (int cy = lo.y; cy < hi.y; ++cy) {
+		for (int cx = lo.x; cx < hi.x; ++cx) {
+			auto const* cached = m_slot_of[chunk_index({cx, cy})];
+			if (!cached) { continue; }
+			m_quad.clear();
+			append_quad(m_quad, {static_cast<float>(cx) * chunk_size.x, static_cast<float>(cy) * chunk_size.y}, chunk_size, sf::Color::White, {}, uv_size);
+			states.texture = &cached->texture.getTexture();
+			target.draw(m_quad.data(), m_quad.size(), sf::PrimitiveType::Triangles, states);
+		}
+	}
+}
+
+auto static_layer_cache::evict(std::size_t const bytes) -> std::size_t {
+	auto candidates = std::vector<slot*>{};
+	for (auto& s : m_slots) {
+		// never the chunks on screen this frame
+		if (s->last_used < m_frame) { candidates.push_back(s.get()); }
+	}
+	std::sort(candidates.begin(), candidates.end(), [](slot const* a, slot const* b) { return a->last_used < b->last_used; });
+	std::size_t ret{};
+	for (auto* s : candidates) {
+		if (ret >= bytes) { break; }
+		ret += s->bytes.bytes();
+		release(*s);
+	}
+	std::erase_if(m_slots, [](std::unique_ptr<slot> const& s) { return s->bytes.bytes() == 0; });
+	return ret;
+}
+
+auto static_layer_cache::resident() const -> std::size_t { return m_slots.size(); }
+
+auto static_layer_cache::acquire_slot() -> slot* {
+	if (m_slots.size() >= m_config.max_textures) {
+		// reuse the least recently drawn chunk's texture, unless everything in the pool is on screen
+		auto it = std::min_element(m_slots.begin(), m_slots.end(), [](auto const& a, auto const& b) { return a->last_used < b->last_used; });
+		if (it != m_slots.end() && (*it)->last_used < m_frame) {
+			if ((*it)->in_use) { m_slot_of[chunk_index((*it)->chunk)] = nullptr; }
+			return it->get();
+		}
+		CARISE_LOG_DEBUG("static layer cache: {} chunks visible, growing past {} textures", m_slots.size() + 1, m_config.max_textures);
+	}
+	auto created = std::make_unique<slot>();
+	if (!created->texture.create(m_texture_size)) {
+		CARISE_LOG_WARN("static layer cache: failed to create {}x{} render texture", m_texture_size.x, m_texture_size.y);
+		return nullptr;
+	}
+	created->bytes = track_texture(created->texture);
+	return m_slots.emplace_back(std::move(created)).get();
+}
+
+void static_layer_cache::release(slot& s) {
+	if (s.in_use) { m_slot_of[chunk_index(s.chunk)] = nullptr; }
+	s.in_use = false;
+	s.bytes.reset();
+}
+
+void static_layer_cache::render(slot& s, sf::Vector2i const chunk) {
+	auto const chunk_size = m_renderer.atlas().tile_size() * static_cast<float>(tile_map::chunk_size_v);
+	auto const origin = sf::Vector2f{static_cast<float>(chunk.x) * chunk_size.x, static_cast<float>(chunk.y) * chunk_size.y};
+	s.texture.clear(sf::Color::Transparent);
+	s.texture.setView(sf::View{origin + chunk_size / 2.0f, chunk_size});
+	m_renderer.draw_chunk(s.texture, chunk, tile_layer::floor);
+	m_renderer.draw_chunk(s.texture, chunk, tile_layer::walls);
+	s.texture.display();
+	++m_refreshed;
+}
+} // namespace carise
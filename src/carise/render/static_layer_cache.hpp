@@ -0,0 +1,74 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <carise/render/tile_map_renderer.hpp>
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+namespace carise {
+///
+/// \brief Floor and wall layers pre-rendered into one sf::RenderTexture per chunk.
+///
+/// A chunk is rendered when it first becomes visible and again only when its terrain revision changes or one
+/// of its animated tiles moves to another frame; each frame then draws one textured quad per visible chunk
+/// instead of every tile, leaving the frame budget to the dynamic layers drawn on top.
+///
+/// Textures are pooled and accounted under memory::tag::textures; chunks not drawn recently are released
+/// least recently used first when the pool is full or the textures budget is exceeded.
+///
+class static_layer_cache {
+  public:
+	struct config {
+		/// \brief Pool size; grows past this only if more chunks than this are visible at once.
+		std::size_t max_textures{64};
+	};
+
+	explicit static_layer_cache(tile_map_renderer const& renderer) : static_layer_cache(renderer, config{}) {}
+	static_layer_cache(tile_map_renderer const& renderer, config const& cfg);
+	~static_layer_cache();
+
+	static_layer_cache(static_layer_cache const&) = delete;
+	static_layer_cache& operator=(static_layer_cache const&) = delete;
+
+	/// \brief Render stale and newly visible chunks in view (after renderer.update(map)).
+	void update(tile_map const& map, sf::View const& view);
+	/// \brief Draw the cached chunks visible in target's current view.
+	void draw(sf::RenderTarget& target, sf::RenderStates states = {}) const;
+
+	/// \returns Bytes released
+	auto evict(std::size_t bytes) -> std::size_t;
+
+	/// \brief Chunks rendered by the last update().
+	[[nodiscard]] auto refreshed() const -> std::size_t { return m_refreshed; }
+	[[nodiscard]] auto resident() const -> std::size_t;
+
+  private:
+	struct slot {
+		sf::RenderTexture texture{};
+		memory::tracked_bytes bytes{};
+		sf::Vector2i chunk{};
+		std::uint64_t revision{};
+		/// \brief tile_map_renderer::animation_revision() of the chunk when it was rendered.
+		std::uint64_t animation{};
+		std::uint64_t last_used{};
+		bool in_use{};
+	};
+
+	[[nodiscard]] auto chunk_index(sf::Vector2i const chunk) const -> std::size_t { return static_cast<std::size_t>(chunk.y * m_chunk_count.x + chunk.x); }
+	[[nodiscard]] auto acquire_slot() -> slot*;
+	void release(slot& s);
+	void render(slot& s, sf::Vector2i chunk);
+
+	tile_map_renderer const& m_renderer;
+	config m_config;
+	sf::Vector2u m_texture_size{};
+	sf::Vector2i m_chunk_count{};
+	std::vector<std::unique_ptr<slot>> m_slots{};
+	/// \brief Per chunk: the slot holding it, or nullptr.
+	std::vector<slot*> m_slot_of{};
+	mutable std::vector<sf::Vertex> m_quad{};
+	std::uint64_t m_frame{};
+	std::size_t m_refreshed{};
+	memory::tracker::evictor_id m_evictor{};
+};
+} // namespace carise
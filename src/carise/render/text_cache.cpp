@@ -0,0 +1,88 @@
+#include <carise/render/text_cache.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace carise {
+auto text_cache::key_hash::operator()(key const& k) const -> std::size_t {
+	auto ret = std::hash<std::string_view>{}(k.text);
+	auto const mix = [&ret](std::size_t const value) { ret ^= value + 0x9e3779b97f4a7c15ull + (ret << 6) + (ret >> 2); };
+	mix(std::hash<sf::Font const*>{}(k.font));
+	mix((std::size_t{k.character_size} << 32) | k.style);
+	return ret;
+}
+
+text_cache::text_cache(config const& cfg)
+	: m_config(cfg), m_hits(metrics::global().get_counter("carise_text_cache_hits_total", "Text runs served without shaping")),
+	  m_misses(metrics::global().get_counter("carise_text_cache_misses_total", "Text runs shaped on a cache miss")) {
+	m_config.max_runs = std::max(m_config.max_runs, std::size_t{1});
+	m_evictor = memory::global().add_evictor(memory::tag::ui, [this](std::size_t const over) { return evict(over); });
+}
+
+text_cache::~text_cache() { memory::global().remove_evictor(m_evictor); }
+
+auto text_cache::get(sf::Font const& font, std::string_view const text, unsigned int const character_size, std::uint32_t const style) -> glyph_run const& {
+	if (auto const it = m_index.find(key{.font = &font, .text = text, .character_size = character_size, .style = style}); it != m_index.end()) {
+		m_hits.add();
+		m_entries.splice(m_entries.begin(), m_entries, it->second);
+		return it->second->run;
+	}
+	m_misses.add();
+	auto const attribute = memory::scope{memory::tag::ui};
+	auto& e = m_entries.emplace_front();
+	e.text.assign(text);
+	e.run = shape_text(font, e.text, character_size, style);
+	// list nodes never move, so the key can view the entry's own string
+	e.lookup = key{.font = &font, .text = e.text, .character_size = character_size, .style = style};
+	e.bytes = sizeof(entry) + e.text.capacity() + e.run.vertices.capacity() * sizeof(sf::Vertex);
+	m_bytes += e.bytes;
+#if !CARISE_TRACK_ALLOCATIONS
+	// without allocation tracking the scope above attributes nothing, so account the entry explicitly
+	e.tracked = memory::tracked_bytes{memory::tag::ui, e.bytes};
+#endif
+	m_index.emplace(e.lookup, m_entries.begin());
+	while (m_entries.size() > m_config.max_runs) { pop_oldest(); }
+	return e.run;
+}
+
+auto text_cache::evict(std::size_t const bytes) -> std::size_t {
+	auto const before = m_bytes;
+	while (!m_entries.empty() && before - m_bytes < bytes) { pop_oldest(); }
+	return before - m_bytes;
+}
+
+void text_cache::clear() {
+	m_index.clear();
+	m_entries.clear();
+	m_bytes = 0;
+}
+
+void text_cache::pop_oldest() {
+	auto const& oldest = m_entries.back();
+	m_index.erase(oldest.lookup);
+	m_bytes -= oldest.bytes;
+	m_entries.pop_back();
+}
+
+void text_batcher::add(sf::Font const& font, std::string_view const text, unsigned int const character_size, sf::Vector2f const position,
+					   sf::Color const colour, std::uint32_t const style) {
+	add(m_cache.get(font, text, character_size, style), position, colour);
+}
+
+void text_batcher::add(glyph_run const& run, sf::Vector2f const position, sf::Color const colour) {
+	if (run.vertices.empty()) { return; }
+	auto it = std::find_if(m_batches.begin(), m_batches.end(), [&run](batch const& b) { return b.texture == run.texture; });
+	if (it == m_batches.end()) { it = m_batches.insert(m_batches.end(), batch{.texture = run.texture}); }
+	append_run(it->vertices, run, position, colour);
+}
+
+void text_batcher::flush(sf::RenderTarget& target, sf::RenderStates states) {
+	m_draw_calls = 0;
+	for (auto& b : m_batches) {
+		if (b.vertices.empty()) { continue; }
+		states.texture = b.texture;
+		target.draw(b.vertices.data(), b.vertices.size(), sf::PrimitiveType::Triangles, states);
+		b.vertices.clear();
+		++m_draw_calls;
+	}
+}
+} // namespace carise
@@ -0,0 +1,117 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <carise/core/metrics.hpp>
+#include <carise/render/glyph_run.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace carise {
+///
+/// \brief Shaped glyph runs keyed by (string, font, size, style), least recently used dropped first.
+///
+/// Message logs and tooltips show the same strings frame after frame; get() hands back the run shaped the
+/// first time instead of walking the font again. Runs are accounted under memory::tag::ui and the oldest
+/// are evicted when that budget is exceeded as well as past max_runs.
+///
+class text_cache {
+  public:
+	struct config {
+		std::size_t max_runs{2048};
+	};
+
+	text_cache() : text_cache(config{}) {}
+	explicit text_cache(config const& cfg);
+	~text_cache();
+
+	text_cache(text_cache const&) = delete;
+	text_cache& operator=(text_cache const&) = delete;
+
+	/// \brief The run for text, shaping it on a miss; valid until the next get() or evict().
+	[[nodiscard]] auto get(sf::Font const& font, std::string_view text, unsigned int character_size, std::uint32_t style = sf::Text::Regular)
+		-> glyph_run const&;
+
+	///
+	/// \brief Drop least recently used runs.
+	/// \returns Bytes released
+	///
+	auto evict(std::size_t bytes) -> std::size_t;
+	void clear();
+
+	[[nodiscard]] auto size() const -> std::size_t { return m_entries.size(); }
+	[[nodiscard]] auto resident_bytes() const -> std::size_t { return m_bytes; }
+
+  private:
+	/// \brief Lookup key; text views the owning entry's string (or the caller's, while looking up).
+	struct key {
+		sf::Font const* font{};
+		std::string_view text{};
+		unsigned int character_size{};
+		std::uint32_t style{};
+
+		auto operator==(key const&) const -> bool = default;
+	};
+
+	struct key_hash {
+		auto operator()(key const& k) const -> std::size_t;
+	};
+
+	struct entry {
+		std::string text{};
+		glyph_run run{};
+		key lookup{};
+		std::size_t bytes{};
+		memory::tracked_bytes tracked{};
+	};
+
+	using entry_list = std::list<entry>;
+
+	void pop_oldest();
+
+	config m_config;
+	/// \brief Most recently used at the front.
+	entry_list m_entries{};
+	std::unordered_map<key, entry_list::iterator, key_hash> m_index{};
+	std::size_t m_bytes{};
+
+	metrics::counter& m_hits;
+	metrics::counter& m_misses;
+	memory::tracker::evictor_id m_evictor{};
+};
+
+///
+/// \brief Collects text for a frame and draws it with one call per font texture.
+///
+/// Runs come from a text_cache, so unchanged strings are copied rather than shaped. Text set in different
+/// fonts or sizes is drawn texture by texture, so overlapping text of different fonts may reorder.
+///
+class text_batcher {
+  public:
+	explicit text_batcher(text_cache& cache) : m_cache(cache) {}
+
+	void add(sf::Font const& font, std::string_view text, unsigned int character_size, sf::Vector2f position, sf::Color colour,
+			 std::uint32_t style = sf::Text::Regular);
+	void add(glyph_run const& run, sf::Vector2f position, sf::Color colour);
+
+	/// \brief Draw everything added since the last flush and clear the batch.
+	void flush(sf::RenderTarget& target, sf::RenderStates states = {});
+
+	/// \brief Draw calls issued by the last flush.
+	[[nodiscard]] auto last_draw_calls() const -> std::size_t { return m_draw_calls; }
+
+  private:
+	struct batch {
+		sf::Texture const* texture{};
+		memory::tagged_vector<sf::Vertex, memory::tag::render> vertices{};
+	};
+
+	text_cache& m_cache;
+	/// \brief One per font texture seen; kept across flushes so their capacity is reused.
+	std::vector<batch> m_batches{};
+	std::size_t m_draw_calls{};
+};
+} // namespace carise
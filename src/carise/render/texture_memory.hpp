@@ -0,0 +1,22 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <SFML/Graphics.hpp>
+
+namespace carise {
+/// \brief Estimated GPU footprint of an RGBA8 texture; a full mip chain adds a third.
+[[nodiscard]] constexpr auto estimate_texture_bytes(sf::Vector2u const size, bool const mipmapped = false) -> std::size_t {
+	auto const base = std::size_t{size.x} * std::size_t{size.y} * 4;
+	return mipmapped ? base + base / 3 : base;
+}
+
+/// \brief Account a texture's estimated GPU memory for as long as the returned token lives (keep it next to the texture).
+[[nodiscard]] inline auto track_texture(sf::Texture const& texture, bool const mipmapped = false, memory::tag const t = memory::tag::textures)
+	-> memory::tracked_bytes {
+	return memory::tracked_bytes{t, estimate_texture_bytes(texture.getSize(), mipmapped)};
+}
+
+/// \brief Account a render texture's colour buffer.
+[[nodiscard]] inline auto track_texture(sf::RenderTexture const& texture, memory::tag const t = memory::tag::textures) -> memory::tracked_bytes {
+	return memory::tracked_bytes{t, estimate_texture_bytes(texture.getSize())};
+}
+} // namespace carise
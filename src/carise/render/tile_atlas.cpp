@@ -0,0 +1,35 @@
+#include <carise/core/random.hpp>
+#include <carise/render/tile_atlas.hpp>
+#include <algorithm>
+
+namespace carise {
+tile_atlas::tile_atlas(sf::Texture const& texture, sf::Vector2u const tile_size)
+	: m_texture(&texture), m_tile_size(static_cast<float>(tile_size.x), static_cast<float>(tile_size.y)) {
+	auto const size = texture.getSize();
+	m_columns = std::max(size.x / std::max(tile_size.x, 1u), 1u);
+	m_count = m_columns * (size.y / std::max(tile_size.y, 1u));
+}
+
+auto make_debug_atlas_image(sf::Vector2u const tile_size, unsigned int const count) -> sf::Image {
+	auto const columns = 16u;
+	auto const rows = (count + columns - 1) / columns;
+	auto ret = sf::Image{};
+	ret.create({tile_size.x * columns, tile_size.y * rows}, sf::Color::Transparent);
+	auto random = rng{count};
+	for (unsigned int id = 0; id < count; ++id) {
+		auto const base = sf::Color{static_cast<std::uint8_t>(random.range(40, 220)), static_cast<std::uint8_t>(random.range(40, 220)),
+									static_cast<std::uint8_t>(random.range(40, 220))};
+		auto const origin = sf::Vector2u{(id % columns) * tile_size.x, (id / columns) * tile_size.y};
+		for (unsigned int y = 0; y < tile_size.y; ++y) {
+			for (unsigned int x = 0; x < tile_size.x; ++x) {
+				// bevelled edge plus per-pixel noise so tiles are distinguishable and filtering artifacts visible
+				auto const edge = x == 0 || y == 0 || x + 1 == tile_size.x || y + 1 == tile_size.y;
+				auto const noise = random.range(-12, 12);
+				auto const shade = [&](std::uint8_t const c) { return static_cast<std::uint8_t>(std::clamp(c + noise - (edge ? 40 : 0), 0, 255)); };
+				ret.setPixel(origin + sf::Vector2u{x, y}, sf::Color{shade(base.r), shade(base.g), shade(base.b)});
+			}
+		}
+	}
+	return ret;
+}
+} // namespace carise
@@ -0,0 +1,33 @@
+#pragma once
+#include <carise/world/tile_map.hpp>
+#include <SFML/Graphics.hpp>
+
+namespace carise {
+///
+/// \brief Grid of equally sized tiles in one texture, indexed row-major by tile_id.
+///
+class tile_atlas {
+  public:
+	tile_atlas() = default;
+	tile_atlas(sf::Texture const& texture, sf::Vector2u tile_size);
+
+	[[nodiscard]] auto texture() const -> sf::Texture const* { return m_texture; }
+	[[nodiscard]] auto tile_size() const -> sf::Vector2f { return m_tile_size; }
+	[[nodiscard]] auto columns() const -> unsigned int { return m_columns; }
+	[[nodiscard]] auto tile_count() const -> unsigned int { return m_count; }
+
+	/// \brief Top left texture coordinate of a tile, in pixels.
+	[[nodiscard]] auto uv(tile_id const id) const -> sf::Vector2f {
+		return {static_cast<float>(id % m_columns) * m_tile_size.x, static_cast<float>(id / m_columns) * m_tile_size.y};
+	}
+
+  private:
+	sf::Texture const* m_texture{};
+	sf::Vector2f m_tile_size{};
+	unsigned int m_columns{1};
+	unsigned int m_count{};
+};
+
+/// \brief Procedural atlas of count distinct patterned tiles, for benchmarks and missing assets.
+[[nodiscard]] auto make_debug_atlas_image(sf::Vector2u tile_size, unsigned int count) -> sf::Image;
+} // namespace carise
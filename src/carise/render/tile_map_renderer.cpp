@@ -0,0 +1,143 @@
+#include <carise/render/tile_map_renderer.hpp>
+#include <carise/render/vertices.hpp>
+#include <carise/render/view_bounds.hpp>
+#include <algorithm>
+
+namespace carise {
+void tile_map_renderer::update(tile_map const& map) {
+	m_map = &map;
+	++m_frame;
+	m_rebuilt = 0;
+	m_animated = 0;
+	if (map.chunk_count() != m_chunk_count || map.size() != m_map_size) {
+		m_chunk_count = map.chunk_count();
+		m_map_size = map.size();
+		reset_chunks();
+	}
+	std::erase_if(m_resident, [this](std::uint32_t const index) {
+		auto& mesh = m_chunks[index];
+		if (m_frame - mesh.last_drawn <= m_config.idle_frames) { return false; }
+		mesh.floor = {};
+		mesh.walls = {};
+		mesh.animated = {};
+		mesh.built = false;
+		return true;
+	});
+}
+
+void tile_map_renderer::set_animations(animation_library const* library) {
+	m_animations = library;
+	m_clip_frames.clear();
+	m_clip_changed.clear();
+	reset_chunks();
+}
+
+void tile_map_renderer::animate(float const seconds) {
+	if (!m_animations) { return; }
+	// clips change frame a few times a second: most frames nothing moved and no mesh needs patching
+	m_clip_frames.resize(m_animations->clip_count(), no_tile_v);
+	m_clip_changed.resize(m_clip_frames.size());
+	auto changed = false;
+	for (std::size_t clip = 0; clip < m_clip_frames.size(); ++clip) {
+		auto const frame = m_animations->frame_at(static_cast<clip_id>(clip), seconds);
+		if (frame == m_clip_frames[clip]) { continue; }
+		m_clip_frames[clip] = frame;
+		m_clip_changed[clip] = m_generation + 1;
+		changed = true;
+	}
+	if (changed) { ++m_generation; }
+}
+
+auto tile_map_renderer::animation_revision(sf::Vector2i const chunk) const -> std::uint64_t {
+	if (chunk_index(chunk) >= m_chunks.size()) { return 0; }
+	auto ret = std::uint64_t{};
+	for (auto const clip : m_chunks[chunk_index(chunk)].clips) {
+		if (clip < m_clip_changed.size()) { ret = std::max(ret, m_clip_changed[clip]); }
+	}
+	return ret;
+}
+
+auto tile_map_renderer::prepare(sf::Vector2i const chunk) const -> chunk_mesh const* {
+	if (!m_map || chunk_index(chunk) >= m_chunks.size()) { return nullptr; }
+	auto& mesh = m_chunks[chunk_index(chunk)];
+	auto const revision = m_map->chunk_revision(chunk);
+	if (!mesh.built || mesh.revision != revision) {
+		if (!mesh.built) { m_resident.push_back(static_cast<std::uint32_t>(chunk_index(chunk))); }
+		build(*m_map, chunk, mesh);
+		mesh.revision = revision;
+		mesh.patched = m_generation;
+		mesh.built = true;
+		++m_rebuilt;
+	} else if (mesh.patched != m_generation) {
+		patch(mesh);
+	}
+	mesh.last_drawn = m_frame;
+	return &mesh;
+}
+
+void tile_map_renderer::build(tile_map const& map, sf::Vector2i const chunk, chunk_mesh& out) const {
+	out.floor.clear();
+	out.walls.clear();
+	out.animated.clear();
+	out.clips.clear();
+	auto const size = m_atlas.tile_size();
+	auto const origin = chunk * tile_map::chunk_size_v;
+	auto const end = sf::Vector2i{std::min(origin.x + tile_map::chunk_size_v, map.size().x), std::min(origin.y + tile_map::chunk_size_v, map.size().y)};
+	for (int y = origin.y; y < end.y; ++y) {
+		for (int x = origin.x; x < end.x; ++x) {
+			auto const pos = sf::Vector2f{static_cast<float>(x) * size.x, static_cast<float>(y) * size.y};
+			append_tile(out, tile_layer::floor, pos, map.floor({x, y}));
+			if (auto const wall = map.wall({x, y}); wall != no_tile_v) { append_tile(out, tile_layer::walls, pos, wall); }
+		}
+	}
+}
+
+void tile_map_renderer::append_tile(chunk_mesh& out, tile_layer const layer, sf::Vector2f const pos, tile_id const id) const {
+	auto& vertices = layer == tile_layer::floor ? out.floor : out.walls;
+	auto shown = id;
+	if (auto const clip = m_animations ? m_animations->tile_clip(id) : no_clip_v; clip != no_clip_v) {
+		if (clip < m_clip_frames.size()) { shown = m_clip_frames[clip]; }
+		out.animated.push_back(animated_quad{.vertex = static_cast<std::uint32_t>(vertices.size()), .clip = clip, .layer = layer, .shown = shown});
+		if (std::find(out.clips.begin(), out.clips.end(), clip) == out.clips.end()) { out.clips.push_back(clip); }
+	}
+	append_quad(vertices, pos, m_atlas.tile_size(), sf::Color::White, m_atlas.uv(shown), m_atlas.tile_size());
+}
+
+void tile_map_renderer::patch(chunk_mesh& mesh) const {
+	auto const size = m_atlas.tile_size();
+	for (auto& quad : mesh.animated) {
+		if (quad.clip >= m_clip_frames.size()) { continue; }
+		auto const frame = m_clip_frames[quad.clip];
+		if (frame == quad.shown) { continue; }
+		auto& vertices = quad.layer == tile_layer::floor ? mesh.floor : mesh.walls;
+		set_quad_uv(vertices.data() + quad.vertex, m_atlas.uv(frame), size);
+		quad.shown = frame;
+		++m_animated;
+	}
+	mesh.patched = m_generation;
+}
+
+void tile_map_renderer::reset_chunks() {
+	m_chunks.clear();
+	m_chunks.resize(static_cast<std::size_t>(m_chunk_count.x * m_chunk_count.y));
+	m_resident.clear();
+}
+
+void tile_map_renderer::draw(sf::RenderTarget& target, tile_layer const layer, sf::RenderStates states) const {
+	auto const chunk_size = m_atlas.tile_size() * static_cast<float>(tile_map::chunk_size_v);
+	auto const [lo, hi] = cell_range(view_bounds(target.getView()), chunk_size, m_chunk_count);
+	states.texture = m_atlas.texture();
+	for (int cy = lo.y; cy < hi.y; ++cy) {
+		for (int cx = lo.x; cx < hi.x; ++cx) { draw_chunk(target, {cx, cy}, layer, states); }
+	}
+}
+
+void tile_map_renderer::draw_chunk(sf::RenderTarget& target, sf::Vector2i const chunk, tile_layer const layer, sf::RenderStates states) const {
+	auto const* mesh = prepare(chunk);
+	if (!mesh) { return; }
+	auto const& vertices = layer == tile_layer::floor ? mesh->floor : mesh->walls;
+	if (vertices.empty()) { return; }
+	states.texture = m_atlas.texture();
+	target.draw(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles, states);
+}
+} // namespace carise
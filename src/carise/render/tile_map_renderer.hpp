@@ -0,0 +1,106 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <carise/render/animation.hpp>
+#include <carise/render/tile_atlas.hpp>
+#include <carise/world/tile_map.hpp>
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+namespace carise {
+enum class tile_layer : std::uint8_t { floor, walls };
+
+///
+/// \brief Draws a tile_map as one vertex batch per chunk and layer.
+///
+/// A chunk's mesh is built when the chunk is first drawn (by draw(), or by draw_chunk() for a cache baking
+/// it), rebuilt when its revision changes and released once it has gone config::idle_frames updates
+/// without being drawn, so memory and per-frame work follow what is on screen rather than the map's size.
+///
+/// Tiles with a looping clip in the animation library are evaluated from a global clock. animate() only
+/// records which clips changed frame; a mesh's texture coordinates are patched when it is next drawn, and
+/// animation_revision() tells caches that bake chunks (static_layer_cache) when to draw them again.
+///
+class tile_map_renderer {
+  public:
+	struct config {
+		/// \brief Updates a chunk may go undrawn before its mesh is released.
+		std::uint64_t idle_frames{60};
+	};
+
+	explicit tile_map_renderer(tile_atlas const& atlas) : tile_map_renderer(atlas, config{}) {}
+	tile_map_renderer(tile_atlas const& atlas, config const& cfg) : m_atlas(atlas), m_config(cfg) {}
+
+	/// \brief Draw map from now on (it must outlive the draws) and release meshes that have gone unused.
+	void update(tile_map const& map);
+	/// \brief Animate tiles through library's tile clips (null to stop); releases every mesh.
+	void set_animations(animation_library const* library);
+	/// \brief Show the frame of every animated tile at seconds on the global clock.
+	void animate(float seconds);
+	/// \brief Draw one layer of the chunks visible in target's current view.
+	void draw(sf::RenderTarget& target, tile_layer layer, sf::RenderStates states = {}) const;
+	/// \brief Draw one layer of a single chunk, building or patching its mesh first if needed.
+	void draw_chunk(sf::RenderTarget& target, sf::Vector2i chunk, tile_layer layer, sf::RenderStates states = {}) const;
+
+	/// \brief Changes whenever an animated tile of chunk moves to another frame; 0 until the chunk has been drawn.
+	[[nodiscard]] auto animation_revision(sf::Vector2i chunk) const -> std::uint64_t;
+
+	[[nodiscard]] auto atlas() const -> tile_atlas const& { return m_atlas; }
+	[[nodiscard]] auto chunk_count() const -> sf::Vector2i { return m_chunk_count; }
+	/// \brief Chunk meshes built since the last update().
+	[[nodiscard]] auto rebuilt() const -> std::size_t { return m_rebuilt; }
+	/// \brief Chunk meshes currently held.
+	[[nodiscard]] auto resident() const -> std::size_t { return m_resident.size(); }
+	/// \brief Tile quads moved to a new frame since the last update().
+	[[nodiscard]] auto animated() const -> std::size_t { return m_animated; }
+
+  private:
+	struct animated_quad {
+		/// \brief First of the quad's six vertices.
+		std::uint32_t vertex{};
+		clip_id clip{};
+		tile_layer layer{};
+		tile_id shown{};
+	};
+
+	struct chunk_mesh {
+		std::uint64_t revision{};
+		/// \brief m_generation the animated quads were last patched for.
+		std::uint64_t patched{};
+		std::uint64_t last_drawn{};
+		bool built{};
+		memory::tagged_vector<sf::Vertex, memory::tag::render> floor{};
+		memory::tagged_vector<sf::Vertex, memory::tag::render> walls{};
+		std::vector<animated_quad> animated{};
+		/// \brief Distinct clips shown in the chunk; kept when the mesh is released, for animation_revision().
+		std::vector<clip_id> clips{};
+	};
+
+	[[nodiscard]] auto chunk_index(sf::Vector2i const chunk) const -> std::size_t { return static_cast<std::size_t>(chunk.y * m_chunk_count.x + chunk.x); }
+	/// \returns The chunk's mesh, built or patched up to date, or null before the first update()
+	[[nodiscard]] auto prepare(sf::Vector2i chunk) const -> chunk_mesh const*;
+	void build(tile_map const& map, sf::Vector2i chunk, chunk_mesh& out) const;
+	void append_tile(chunk_mesh& out, tile_layer layer, sf::Vector2f pos, tile_id id) const;
+	void patch(chunk_mesh& mesh) const;
+	void reset_chunks();
+
+	tile_atlas const& m_atlas;
+	config m_config;
+	tile_map const* m_map{};
+	sf::Vector2i m_chunk_count{};
+	sf::Vector2i m_map_size{};
+	std::uint64_t m_frame{};
+	// meshes are built and patched from the const draw calls
+	mutable std::vector<chunk_mesh> m_chunks{};
+	/// \brief Indices of the chunks with a built mesh.
+	mutable std::vector<std::uint32_t> m_resident{};
+	mutable std::size_t m_rebuilt{};
+	mutable std::size_t m_animated{};
+	animation_library const* m_animations{};
+	/// \brief Current frame of each clip, as of the last animate().
+	std::vector<tile_id> m_clip_frames{};
+	/// \brief m_generation at which each clip last changed frame.
+	std::vector<std::uint64_t> m_clip_changed{};
+	/// \brief Bumped by every animate() that moved at least one clip.
+	std::uint64_t m_generation{};
+};
+} // namespace carise
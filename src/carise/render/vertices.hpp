@@ -0,0 +1,36 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+namespace carise {
+///
+/// \brief Append two triangles covering [top_left, top_left + size].
+///
+/// SFML has no quad primitive, so every batched quad in the renderer goes through here.
+/// Vertices is any contiguous container of sf::Vertex (std::vector, memory::tagged_vector, ...).
+///
+template <typename Vertices = std::vector<sf::Vertex>>
+void append_quad(Vertices& out, sf::Vector2f const top_left, sf::Vector2f const size, sf::Color const colour,
+						sf::Vector2f const uv_top_left = {}, sf::Vector2f const uv_size = {}) {
+	auto const tr = sf::Vertex{{top_left.x + size.x, top_left.y}, colour, {uv_top_left.x + uv_size.x, uv_top_left.y}};
+	auto const br = sf::Vertex{top_left + size, colour, uv_top_left + uv_size};
+	auto const tl = sf::Vertex{top_left, colour, uv_top_left};
+	auto const bl = sf::Vertex{{top_left.x, top_left.y + size.y}, colour, {uv_top_left.x, uv_top_left.y + uv_size.y}};
+	out.push_back(tl);
+	out.push_back(tr);
+	out.push_back(br);
+	out.push_back(tl);
+	out.push_back(br);
+	out.push_back(bl);
+}
+
+/// \brief Retarget the texture coordinates of six vertices written by append_quad().
+inline void set_quad_uv(sf::Vertex* quad, sf::Vector2f const uv_top_left, sf::Vector2f const uv_size) {
+	quad[0].texCoords = uv_top_left;
+	quad[1].texCoords = {uv_top_left.x + uv_size.x, uv_top_left.y};
+	quad[2].texCoords = uv_top_left + uv_size;
+	quad[3].texCoords = uv_top_left;
+	quad[4].texCoords = uv_top_left + uv_size;
+	quad[5].texCoords = {uv_top_left.x, uv_top_left.y + uv_size.y};
+}
+} // namespace carise
@@ -0,0 +1,28 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+
+namespace carise {
+/// \brief Axis aligned box in world space.
+struct aabb {
+	sf::Vector2f min{};
+	sf::Vector2f max{};
+
+	[[nodiscard]] constexpr auto size() const -> sf::Vector2f { return max - min; }
+	[[nodiscard]] constexpr auto intersects(aabb const& rhs) const -> bool { return min.x < rhs.max.x && rhs.min.x < max.x && min.y < rhs.max.y && rhs.min.y < max.y; }
+};
+
+/// \brief World space area covered by an unrotated view.
+[[nodiscard]] inline auto view_bounds(sf::View const& view) -> aabb {
+	auto const half = view.getSize() / 2.0f;
+	return aabb{view.getCenter() - half, view.getCenter() + half};
+}
+
+/// \brief Half-open range of cells [min, max) of size cell_size overlapping box, clamped to [0, count).
+[[nodiscard]] inline auto cell_range(aabb const& box, sf::Vector2f const cell_size, sf::Vector2i const count) -> std::pair<sf::Vector2i, sf::Vector2i> {
+	auto const lo = sf::Vector2i{std::clamp(static_cast<int>(box.min.x / cell_size.x), 0, count.x), std::clamp(static_cast<int>(box.min.y / cell_size.y), 0, count.y)};
+	auto const hi = sf::Vector2i{std::clamp(static_cast<int>(box.max.x / cell_size.x) + 1, 0, count.x),
+								 std::clamp(static_cast<int>(box.max.y / cell_size.y) + 1, 0, count.y)};
+	return {lo, hi};
+}
+} // namespace carise
@@ -0,0 +1,52 @@
+#include <carise/core/log.hpp>
+#include <carise/ui/canvas.hpp>
+#include <bit>
+
+namespace carise::ui {
+canvas::canvas(sf::Vector2f const size)
+	: m_root(std::make_unique<panel>(panel::layout::free)), m_size(size), m_use_buffer(sf::VertexBuffer::isAvailable()) {
+	m_root->set_min_size(size);
+}
+
+void canvas::resize(sf::Vector2f const size) {
+	if (size == m_size) { return; }
+	m_size = size;
+	m_root->set_min_size(size);
+}
+
+auto canvas::update() -> bool {
+	widget& root = *m_root;
+	if (!root.m_layout_dirty && !root.m_geometry_dirty && !root.m_children_dirty) { return false; }
+	if (root.m_layout_dirty) {
+		root.measure_tree();
+		root.place(sf::FloatRect{{}, m_size});
+	}
+	root.rebuild();
+	m_geometry.clear();
+	root.collect(m_geometry);
+	++m_rebuilds;
+
+	m_uploaded = false;
+	if (!m_use_buffer || m_geometry.empty()) { return true; }
+	auto const vertices = m_geometry.vertices();
+	if (m_buffer.getVertexCount() < vertices.size() && !m_buffer.create(std::bit_ceil(vertices.size()))) {
+		CARISE_LOG_WARN("ui: failed to create vertex buffer, falling back to vertex arrays");
+		m_use_buffer = false;
+		return true;
+	}
+	m_uploaded = m_buffer.update(vertices.data(), vertices.size(), 0);
+	return true;
+}
+
+void canvas::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+	auto const vertices = m_geometry.vertices();
+	for (auto const& seg : m_geometry.segments()) {
+		states.texture = seg.texture;
+		if (m_uploaded) {
+			target.draw(m_buffer, seg.first, seg.count, states);
+		} else {
+			target.draw(vertices.data() + seg.first, seg.count, sf::PrimitiveType::Triangles, states);
+		}
+	}
+}
+} // namespace carise::ui
@@ -0,0 +1,44 @@
+#pragma once
+#include <carise/ui/geometry.hpp>
+#include <carise/ui/widgets.hpp>
+#include <SFML/Graphics.hpp>
+#include <memory>
+
+namespace carise::ui {
+///
+/// \brief Root of a widget tree and the vertex buffer its geometry lives in.
+///
+/// update() lays out and rebuilds only what was invalidated since the last call, then re-uploads the
+/// concatenated geometry; when nothing changed it returns straight away and draw() replays the uploaded
+/// buffer, one draw call per font texture run (plain vertex arrays where vertex buffers are unsupported).
+///
+class canvas {
+  public:
+	explicit canvas(sf::Vector2f size);
+
+	canvas(canvas const&) = delete;
+	canvas& operator=(canvas const&) = delete;
+
+	/// \brief Free layout panel covering the canvas; place top level widgets with set_position().
+	[[nodiscard]] auto root() -> panel& { return *m_root; }
+	void resize(sf::Vector2f size);
+
+	/// \returns Whether anything was laid out or rebuilt
+	auto update() -> bool;
+	void draw(sf::RenderTarget& target, sf::RenderStates states = {}) const;
+
+	[[nodiscard]] auto draw_calls() const -> std::size_t { return m_geometry.segments().size(); }
+	[[nodiscard]] auto vertex_count() const -> std::size_t { return m_geometry.vertices().size(); }
+	/// \brief Updates that had to rebuild geometry.
+	[[nodiscard]] auto rebuilds() const -> std::size_t { return m_rebuilds; }
+
+  private:
+	std::unique_ptr<panel> m_root;
+	sf::Vector2f m_size;
+	geometry m_geometry{};
+	sf::VertexBuffer m_buffer{sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static};
+	std::size_t m_rebuilds{};
+	bool m_use_buffer{};
+	bool m_uploaded{};
+};
+} // namespace carise::ui
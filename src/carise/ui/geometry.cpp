@@ -0,0 +1,48 @@
+#include <carise/render/vertices.hpp>
+#include <carise/ui/geometry.hpp>
+
+namespace carise::ui {
+namespace {
+constexpr sf::Vector2f white_texel_v{1.0f, 1.0f};
+} // namespace
+
+void geometry::clear() {
+	m_vertices.clear();
+	m_segments.clear();
+}
+
+void geometry::rectangle(sf::FloatRect const& rect, sf::Color const colour) {
+	if (rect.width <= 0.0f || rect.height <= 0.0f || colour.a == 0) { return; }
+	auto& seg = begin(nullptr);
+	append_quad(m_vertices, {rect.left, rect.top}, {rect.width, rect.height}, colour, white_texel_v);
+	seg.count += 6;
+}
+
+void geometry::text(glyph_run const& run, sf::Vector2f const origin, sf::Color const colour) {
+	if (run.vertices.empty() || colour.a == 0) { return; }
+	auto& seg = begin(run.texture);
+	append_run(m_vertices, run, origin, colour);
+	seg.count += run.vertices.size();
+}
+
+void geometry::append(geometry const& other) {
+	for (auto const& from : other.m_segments) {
+		auto& seg = begin(from.texture);
+		auto const source = other.vertices().subspan(from.first, from.count);
+		m_vertices.insert(m_vertices.end(), source.begin(), source.end());
+		seg.count += from.count;
+	}
+}
+
+auto geometry::begin(sf::Texture const* texture) -> segment& {
+	if (!m_segments.empty()) {
+		auto& last = m_segments.back();
+		if (!texture || last.texture == texture) { return last; }
+		if (!last.texture) {
+			last.texture = texture;
+			return last;
+		}
+	}
+	return m_segments.emplace_back(segment{.texture = texture, .first = m_vertices.size()});
+}
+} // namespace carise::ui
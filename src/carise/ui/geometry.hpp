@@ -0,0 +1,39 @@
+#pragma once
+#include <carise/render/glyph_run.hpp>
+#include <SFML/Graphics.hpp>
+#include <span>
+#include <vector>
+
+namespace carise::ui {
+///
+/// \brief Triangles of one or more widgets, split into runs that share a texture.
+///
+/// Untextured rectangles sample the white texel every font page reserves, so they join whichever font
+/// segment they follow: a UI set in one font is a single draw call however its panels and text interleave.
+///
+class geometry {
+  public:
+	struct segment {
+		/// \brief Null until the segment contains text.
+		sf::Texture const* texture{};
+		std::size_t first{};
+		std::size_t count{};
+	};
+
+	void clear();
+	void rectangle(sf::FloatRect const& rect, sf::Color colour);
+	void text(glyph_run const& run, sf::Vector2f origin, sf::Color colour);
+	void append(geometry const& other);
+
+	[[nodiscard]] auto vertices() const -> std::span<sf::Vertex const> { return m_vertices; }
+	[[nodiscard]] auto segments() const -> std::span<segment const> { return m_segments; }
+	[[nodiscard]] auto empty() const -> bool { return m_vertices.empty(); }
+
+  private:
+	/// \brief Make the last segment one that can take vertices drawn with texture.
+	auto begin(sf::Texture const* texture) -> segment&;
+
+	std::vector<sf::Vertex> m_vertices{};
+	std::vector<segment> m_segments{};
+};
+} // namespace carise::ui
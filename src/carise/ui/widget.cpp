@@ -0,0 +1,91 @@
+#include <carise/ui/widget.hpp>
+#include <algorithm>
+
+namespace carise::ui {
+void widget::remove(widget const& child) {
+	auto const it = std::find_if(m_children.begin(), m_children.end(), [&child](auto const& c) { return c.get() == &child; });
+	if (it == m_children.end()) { return; }
+	m_children.erase(it);
+	invalidate_layout();
+}
+
+void widget::clear() {
+	if (m_children.empty()) { return; }
+	m_children.clear();
+	invalidate_layout();
+}
+
+void widget::set_visible(bool const visible) {
+	if (m_visible == visible) { return; }
+	m_visible = visible;
+	invalidate_layout();
+	invalidate_geometry();
+}
+
+void widget::set_position(sf::Vector2f const position) {
+	if (m_position == position) { return; }
+	m_position = position;
+	invalidate_layout();
+}
+
+void widget::set_min_size(sf::Vector2f const size) {
+	if (m_min_size == size) { return; }
+	m_min_size = size;
+	invalidate_layout();
+}
+
+void widget::invalidate_layout() {
+	// ancestors of a dirty widget are always dirty, so the walk stops at the first one already marked
+	for (auto* w = this; w && !w->m_layout_dirty; w = w->m_parent) { w->m_layout_dirty = true; }
+}
+
+void widget::invalidate_geometry() {
+	m_geometry_dirty = true;
+	for (auto* w = m_parent; w && !w->m_children_dirty; w = w->m_parent) { w->m_children_dirty = true; }
+}
+
+void widget::adopt(std::unique_ptr<widget> child) {
+	child->m_parent = this;
+	m_children.push_back(std::move(child));
+	invalidate_layout();
+	m_children.back()->invalidate_geometry();
+}
+
+auto widget::measure_tree() -> sf::Vector2f {
+	if (!m_layout_dirty) { return m_desired; }
+	if (!m_visible) {
+		// never placed while hidden, so settle here; dirty descendants stay dirty and are laid out once shown
+		m_layout_dirty = false;
+		return m_desired = {};
+	}
+	for (auto& c : m_children) { c->measure_tree(); }
+	auto const size = measure();
+	m_desired = {std::max(size.x, m_min_size.x), std::max(size.y, m_min_size.y)};
+	return m_desired;
+}
+
+void widget::place(sf::FloatRect const& bounds) {
+	if (!m_layout_dirty && bounds == m_bounds) { return; }
+	m_bounds = bounds;
+	m_layout_dirty = false;
+	arrange(bounds);
+	invalidate_geometry();
+}
+
+void widget::rebuild() {
+	if (m_geometry_dirty) {
+		m_geometry.clear();
+		if (m_visible) { build(m_geometry); }
+		m_geometry_dirty = false;
+	}
+	if (!m_children_dirty) { return; }
+	for (auto& c : m_children) { c->rebuild(); }
+	m_children_dirty = false;
+}
+
+void widget::collect(geometry& out) const {
+	if (!m_visible) { return; }
+	out.append(m_geometry);
+	for (auto const& c : m_children) { c->collect(out); }
+}
+} // namespace carise::ui
@@ -0,0 +1,90 @@
+#pragma once
+#include <carise/ui/geometry.hpp>
+#include <SFML/Graphics.hpp>
+#include <concepts>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace carise::ui {
+class canvas;
+
+///
+/// \brief Node of a retained UI tree that owns its cached geometry.
+///
+/// Nothing is recomputed per frame. Changing a widget's size or content calls invalidate_layout(), and
+/// only the invalidated path is measured again on the next canvas::update(); widgets whose bounds did not
+/// move keep their geometry. Appearance-only changes call invalidate_geometry() and rebuild that widget
+/// alone. An untouched tree costs the canvas one flag check.
+///
+class widget {
+  public:
+	widget() = default;
+	widget(widget const&) = delete;
+	widget& operator=(widget const&) = delete;
+	virtual ~widget() = default;
+
+	template <std::derived_from<widget> Type, typename... Args>
+	auto add(Args&&... args) -> Type& {
+		auto child = std::make_unique<Type>(std::forward<Args>(args)...);
+		auto& ret = *child;
+		adopt(std::move(child));
+		return ret;
+	}
+	void remove(widget const& child);
+	void clear();
+
+	/// \brief Hidden widgets take no space and draw nothing.
+	void set_visible(bool visible);
+	/// \brief Offset from the parent's content origin, honoured by panel::layout::free.
+	void set_position(sf::Vector2f position);
+	/// \brief Lower bound on the measured size.
+	void set_min_size(sf::Vector2f size);
+
+	[[nodiscard]] auto is_visible() const -> bool { return m_visible; }
+	[[nodiscard]] auto position() const -> sf::Vector2f { return m_position; }
+	/// \brief Absolute bounds from the last layout.
+	[[nodiscard]] auto bounds() const -> sf::FloatRect const& { return m_bounds; }
+	[[nodiscard]] auto parent() const -> widget* { return m_parent; }
+	[[nodiscard]] auto child_count() const -> std::size_t { return m_children.size(); }
+	[[nodiscard]] auto child(std::size_t const index) const -> widget& { return *m_children[index]; }
+
+  protected:
+	/// \brief Size or children changed: measure and arrange again on the next update.
+	void invalidate_layout();
+	/// \brief Only appearance changed: rebuild this widget's geometry on the next update.
+	void invalidate_geometry();
+
+	/// \brief Preferred size of the content; children have already been measured (desired_size()).
+	[[nodiscard]] virtual auto measure() -> sf::Vector2f = 0;
+	/// \brief Place children within bounds with place_child(); leaves have nothing to do.
+	virtual void arrange(sf::FloatRect const& /*bounds*/) {}
+	/// \brief Emit this widget's own geometry (not its children's) in absolute coordinates.
+	virtual void build(geometry& out) const = 0;
+
+	[[nodiscard]] static auto desired_size(widget const& w) -> sf::Vector2f { return w.m_desired; }
+	static void place_child(widget& child, sf::FloatRect const& bounds) { child.place(bounds); }
+
+  private:
+	friend class canvas;
+
+	void adopt(std::unique_ptr<widget> child);
+	auto measure_tree() -> sf::Vector2f;
+	void place(sf::FloatRect const& bounds);
+	void rebuild();
+	void collect(geometry& out) const;
+
+	widget* m_parent{};
+	std::vector<std::unique_ptr<widget>> m_children{};
+	geometry m_geometry{};
+	sf::FloatRect m_bounds{};
+	sf::Vector2f m_desired{};
+	sf::Vector2f m_position{};
+	sf::Vector2f m_min_size{};
+	bool m_visible{true};
+	bool m_layout_dirty{true};
+	bool m_geometry_dirty{true};
+	/// \brief Some descendant's geometry is dirty.
+	bool m_children_dirty{};
+};
+} // namespace carise::ui
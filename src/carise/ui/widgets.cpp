@@ -0,0 +1,133 @@
+#include <carise/ui/widgets.hpp>
+#include <algorithm>
+
+namespace carise::ui {
+void panel::set_style(style const& s) {
+	m_style = s;
+	invalidate_layout();
+	invalidate_geometry();
+}
+
+void panel::set_background(sf::Color const colour) {
+	if (m_style.background == colour) { return; }
+	m_style.background = colour;
+	invalidate_geometry();
+}
+
+auto panel::measure() -> sf::Vector2f {
+	auto content = sf::Vector2f{};
+	auto visible = std::size_t{};
+	for (std::size_t i = 0; i < child_count(); ++i) {
+		auto const& c = child(i);
+		if (!c.is_visible()) { continue; }
+		auto const size = desired_size(c);
+		++visible;
+		switch (m_layout) {
+		case layout::column: content = {std::max(content.x, size.x), content.y + size.y}; break;
+		case layout::row: content = {content.x + size.x, std::max(content.y, size.y)}; break;
+		case layout::free: content = {std::max(content.x, c.position().x + size.x), std::max(content.y, c.position().y + size.y)}; break;
+		}
+	}
+	auto const gaps = visible > 1 && m_layout != layout::free ? m_style.spacing * static_cast<float>(visible - 1) : 0.0f;
+	if (m_layout == layout::column) { content.y += gaps; }
+	if (m_layout == layout::row) { content.x += gaps; }
+	return content + sf::Vector2f{m_style.padding, m_style.padding} * 2.0f;
+}
+
+void panel::arrange(sf::FloatRect const& bounds) {
+	auto const origin = sf::Vector2f{bounds.left + m_style.padding, bounds.top + m_style.padding};
+	auto const inner = sf::Vector2f{std::max(bounds.width - 2.0f * m_style.padding, 0.0f), std::max(bounds.height - 2.0f * m_style.padding, 0.0f)};
+	auto cursor = origin;
+	for (std::size_t i = 0; i < child_count(); ++i) {
+		auto& c = child(i);
+		if (!c.is_visible()) { continue; }
+		auto const size = desired_size(c);
+		switch (m_layout) {
+		case layout::column:
+			place_child(c, sf::FloatRect{cursor, {inner.x, size.y}});
+			cursor.y += size.y + m_style.spacing;
+			break;
+		case layout::row:
+			place_child(c, sf::FloatRect{cursor, {size.x, inner.y}});
+			cursor.x += size.x + m_style.spacing;
+			break;
+		case layout::free: place_child(c, sf::FloatRect{origin + c.position(), size}); break;
+		}
+	}
+}
+
+void panel::build(geometry& out) const {
+	auto const& b = bounds();
+	out.rectangle(b, m_style.background);
+	auto const t = m_style.border_thickness;
+	if (t <= 0.0f) { return; }
+	out.rectangle({{b.left, b.top}, {b.width, t}}, m_style.border);
+	out.rectangle({{b.left, b.top + b.height - t}, {b.width, t}}, m_style.border);
+	out.rectangle({{b.left, b.top + t}, {t, b.height - 2.0f * t}}, m_style.border);
+	out.rectangle({{b.left + b.width - t, b.top + t}, {t, b.height - 2.0f * t}}, m_style.border);
+}
+
+label::label(sf::Font const* font, std::string_view const text, unsigned int const character_size)
+	: m_font(font), m_text(text), m_character_size(character_size) {
+	reshape();
+}
+
+void label::set_text(std::string_view const text) {
+	if (text == m_text) { return; }
+	m_text.assign(text);
+	reshape();
+}
+
+void label::set_font(sf::Font const* font, unsigned int const character_size) {
+	if (font == m_font && character_size == m_character_size) { return; }
+	m_font = font;
+	m_character_size = character_size;
+	reshape();
+}
+
+void label::set_text_style(std::uint32_t const style) {
+	if (style == m_style) { return; }
+	m_style = style;
+	reshape();
+}
+
+void label::set_colour(sf::Color const colour) {
+	if (colour == m_colour) { return; }
+	m_colour = colour;
+	invalidate_geometry();
+}
+
+void label::build(geometry& out) const { out.text(m_run, {bounds().left, bounds().top}, m_colour); }
+
+void label::reshape() {
+	auto const old_size = m_run.size;
+	m_run = m_font ? shape_text(*m_font, m_text, m_character_size, m_style) : glyph_run{};
+	// a counter or log line that changes without changing extent leaves the layout alone
+	if (m_run.size == old_size) {
+		invalidate_geometry();
+	} else {
+		invalidate_layout();
+	}
+}
+
+bar::bar(sf::Vector2f const size, sf::Color const fill, sf::Color const background) : m_size(size), m_fill(fill), m_background(background) {}
+
+void bar::set_value(float fraction) {
+	fraction = std::clamp(fraction, 0.0f, 1.0f);
+	if (fraction == m_value) { return; }
+	m_value = fraction;
+	invalidate_geometry();
+}
+
+void bar::set_fill(sf::Color const colour) {
+	if (colour == m_fill) { return; }
+	m_fill = colour;
+	invalidate_geometry();
+}
+
+void bar::build(geometry& out) const {
+	auto const& b = bounds();
+	out.rectangle(b, m_background);
+	out.rectangle({{b.left, b.top}, {b.width * m_value, b.height}}, m_fill);
+}
+} // namespace carise::ui
@@ -0,0 +1,95 @@
+#pragma once
+#include <carise/render/glyph_run.hpp>
+#include <carise/ui/widget.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace carise::ui {
+///
+/// \brief Container with an optional background and border that stacks or freely places its children.
+///
+/// Column and row layouts stretch children across the panel; free layout puts each child at its
+/// position() with its measured size.
+///
+class panel : public widget {
+  public:
+	enum class layout : std::uint8_t { column, row, free };
+
+	struct style {
+		sf::Color background{sf::Color::Transparent};
+		sf::Color border{sf::Color::Transparent};
+		float border_thickness{};
+		float padding{};
+		float spacing{};
+	};
+
+	explicit panel(layout const l = layout::column) : panel(l, style{}) {}
+	panel(layout l, style const& s) : m_layout(l), m_style(s) {}
+
+	void set_style(style const& s);
+	void set_background(sf::Color colour);
+
+  protected:
+	auto measure() -> sf::Vector2f override;
+	void arrange(sf::FloatRect const& bounds) override;
+	void build(geometry& out) const override;
+
+  private:
+	layout m_layout;
+	style m_style;
+};
+
+///
+/// \brief Text shaped once and reused until its string, font, size or style changes.
+///
+/// Recolouring only rewrites vertex colours; new text of the same extent does not even re-run layout.
+///
+class label : public widget {
+  public:
+	explicit label(sf::Font const* font, std::string_view text = {}, unsigned int character_size = 14);
+
+	void set_text(std::string_view text);
+	void set_font(sf::Font const* font, unsigned int character_size);
+	void set_text_style(std::uint32_t style);
+	void set_colour(sf::Color colour);
+
+	[[nodiscard]] auto text() const -> std::string const& { return m_text; }
+
+  protected:
+	auto measure() -> sf::Vector2f override { return m_run.size; }
+	void build(geometry& out) const override;
+
+  private:
+	void reshape();
+
+	sf::Font const* m_font;
+	std::string m_text;
+	glyph_run m_run{};
+	unsigned int m_character_size;
+	std::uint32_t m_style{sf::Text::Regular};
+	sf::Color m_colour{sf::Color::White};
+};
+
+/// \brief Horizontal gauge (health, progress), filled to a fraction of its width.
+class bar : public widget {
+  public:
+	bar(sf::Vector2f size, sf::Color fill, sf::Color background = sf::Color{40, 40, 40});
+
+	void set_value(float fraction);
+	void set_fill(sf::Color colour);
+
+	[[nodiscard]] auto value() const -> float { return m_value; }
+
+  protected:
+	auto measure() -> sf::Vector2f override { return m_size; }
+	void build(geometry& out) const override;
+
+  private:
+	sf::Vector2f m_size;
+	sf::Color m_fill;
+	sf::Color m_background;
+	float m_value{1.0f};
+};
+} // namespace carise::ui
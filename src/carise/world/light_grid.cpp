@@ -0,0 +1,41 @@
+#include <carise/world/light_grid.hpp>
+
+namespace carise {
+light_grid::light_grid(sf::Vector2i const size, sf::Color const ambient) : m_size(size) {
+	m_texels.resize(static_cast<std::size_t>(size.x * size.y) * 4);
+	for (auto i = std::size_t{}; i < m_texels.size(); i += 4) {
+		m_texels[i] = ambient.r;
+		m_texels[i + 1] = ambient.g;
+		m_texels[i + 2] = ambient.b;
+		m_texels[i + 3] = 255;
+	}
+	m_chunks = {(size.x + tile_map::chunk_size_v - 1) / tile_map::chunk_size_v, (size.y + tile_map::chunk_size_v - 1) / tile_map::chunk_size_v};
+	m_chunk_revisions.assign(static_cast<std::size_t>(m_chunks.x * m_chunks.y), 0);
+}
+
+auto light_grid::light(sf::Vector2i const pos) const -> sf::Color {
+	auto const* texel = texels(pos);
+	return sf::Color{texel[0], texel[1], texel[2]};
+}
+
+void light_grid::set_light(sf::Vector2i const pos, sf::Color const colour) {
+	auto* texel = m_texels.data() + index(pos) * 4;
+	if (texel[0] == colour.r && texel[1] == colour.g && texel[2] == colour.b) { return; }
+	texel[0] = colour.r;
+	texel[1] = colour.g;
+	texel[2] = colour.b;
+	touch(pos);
+}
+
+void light_grid::fill(sf::Color const colour) {
+	for (int y = 0; y < m_size.y; ++y) {
+		for (int x = 0; x < m_size.x; ++x) { set_light({x, y}, colour); }
+	}
+}
+
+void light_grid::touch(sf::Vector2i const pos) {
+	++m_revision;
+	auto const chunk = sf::Vector2i{pos.x / tile_map::chunk_size_v, pos.y / tile_map::chunk_size_v};
+	m_chunk_revisions[static_cast<std::size_t>(chunk.y * m_chunks.x + chunk.x)] = m_revision;
+}
+} // namespace carise
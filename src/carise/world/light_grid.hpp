@@ -0,0 +1,48 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <carise/world/tile_map.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+namespace carise {
+///
+/// \brief Light reaching each tile, computed by the game on the CPU, with per-chunk change revisions.
+///
+/// Chunks line up with tile_map's, and setting a tile to the value it already holds is not a change, so a
+/// lighting pass that rewrites the whole area around a flickering torch only dirties the chunks whose light
+/// actually moved. Texels are stored RGBA, ready to upload.
+///
+class light_grid {
+  public:
+	light_grid() = default;
+	explicit light_grid(sf::Vector2i size, sf::Color ambient = sf::Color::White);
+
+	[[nodiscard]] auto size() const -> sf::Vector2i { return m_size; }
+	[[nodiscard]] auto in_bounds(sf::Vector2i const pos) const -> bool { return pos.x >= 0 && pos.y >= 0 && pos.x < m_size.x && pos.y < m_size.y; }
+
+	[[nodiscard]] auto light(sf::Vector2i pos) const -> sf::Color;
+	void set_light(sf::Vector2i pos, sf::Color colour);
+	/// \brief Set every tile, touching only chunks that held something else.
+	void fill(sf::Color colour);
+
+	/// \brief RGBA bytes of the tile at pos, followed by the rest of its row.
+	[[nodiscard]] auto texels(sf::Vector2i const pos) const -> std::uint8_t const* { return m_texels.data() + index(pos) * 4; }
+
+	[[nodiscard]] auto chunk_count() const -> sf::Vector2i { return m_chunks; }
+	[[nodiscard]] auto chunk_revision(sf::Vector2i const chunk) const -> std::uint64_t {
+		return m_chunk_revisions[static_cast<std::size_t>(chunk.y * m_chunks.x + chunk.x)];
+	}
+	/// \brief Incremented on every change anywhere in the grid.
+	[[nodiscard]] auto revision() const -> std::uint64_t { return m_revision; }
+
+  private:
+	[[nodiscard]] auto index(sf::Vector2i const pos) const -> std::size_t { return static_cast<std::size_t>(pos.y * m_size.x + pos.x); }
+	void touch(sf::Vector2i pos);
+
+	memory::tagged_vector<std::uint8_t, memory::tag::map> m_texels{};
+	memory::tagged_vector<std::uint64_t, memory::tag::map> m_chunk_revisions{};
+	sf::Vector2i m_size{};
+	sf::Vector2i m_chunks{};
+	std::uint64_t m_revision{};
+};
+} // namespace carise
@@ -0,0 +1,31 @@
+#include <carise/world/tile_map.hpp>
+
+namespace carise {
+tile_map::tile_map(sf::Vector2i const size, tile_id const floor) : m_size(size) {
+	auto const count = static_cast<std::size_t>(size.x * size.y);
+	m_floors.assign(count, floor);
+	m_walls.assign(count, no_tile_v);
+	m_chunks = {(size.x + chunk_size_v - 1) / chunk_size_v, (size.y + chunk_size_v - 1) / chunk_size_v};
+	m_chunk_revisions.assign(static_cast<std::size_t>(m_chunks.x * m_chunks.y), 0);
+}
+
+void tile_map::set_floor(sf::Vector2i const pos, tile_id const id) {
+	auto& target = m_floors[index(pos)];
+	if (target == id) { return; }
+	target = id;
+	touch(pos);
+}
+
+void tile_map::set_wall(sf::Vector2i const pos, tile_id const id) {
+	auto& target = m_walls[index(pos)];
+	if (target == id) { return; }
+	target = id;
+	touch(pos);
+}
+
+void tile_map::touch(sf::Vector2i const pos) {
+	++m_revision;
+	auto const chunk = chunk_of(pos);
+	m_chunk_revisions[static_cast<std::size_t>(chunk.y * m_chunks.x + chunk.x)] = m_revision;
+}
+} // namespace carise
@@ -0,0 +1,55 @@
+#pragma once
+#include <carise/core/memory.hpp>
+#include <SFML/System.hpp>
+#include <cstdint>
+
+namespace carise {
+using tile_id = std::uint16_t;
+
+/// \brief Wall value meaning "no wall".
+inline constexpr tile_id no_tile_v{0xffff};
+
+///
+/// \brief Grid of floor and wall tiles, split into square chunks with change revisions.
+///
+/// Every edit bumps the revision of the chunk it lands in (and the map's), so caches derived from the map
+/// (static layer textures, minimap pixels, propagation fields, ...) only rebuild chunks that actually changed.
+///
+class tile_map {
+  public:
+	static constexpr int chunk_size_v{32};
+
+	tile_map() = default;
+	explicit tile_map(sf::Vector2i size, tile_id floor = 0);
+
+	[[nodiscard]] auto size() const -> sf::Vector2i { return m_size; }
+	[[nodiscard]] auto in_bounds(sf::Vector2i const pos) const -> bool { return pos.x >= 0 && pos.y >= 0 && pos.x < m_size.x && pos.y < m_size.y; }
+
+	[[nodiscard]] auto floor(sf::Vector2i const pos) const -> tile_id { return m_floors[index(pos)]; }
+	[[nodiscard]] auto wall(sf::Vector2i const pos) const -> tile_id { return m_walls[index(pos)]; }
+	/// \brief Walls block movement, sight and sound; out of bounds counts as a wall.
+	[[nodiscard]] auto is_wall(sf::Vector2i const pos) const -> bool { return !in_bounds(pos) || m_walls[index(pos)] != no_tile_v; }
+
+	void set_floor(sf::Vector2i pos, tile_id id);
+	void set_wall(sf::Vector2i pos, tile_id id);
+
+	[[nodiscard]] auto chunk_count() const -> sf::Vector2i { return m_chunks; }
+	[[nodiscard]] auto chunk_of(sf::Vector2i const pos) const -> sf::Vector2i { return {pos.x / chunk_size_v, pos.y / chunk_size_v}; }
+	[[nodiscard]] auto chunk_revision(sf::Vector2i const chunk) const -> std::uint64_t {
+		return m_chunk_revisions[static_cast<std::size_t>(chunk.y * m_chunks.x + chunk.x)];
+	}
+	/// \brief Incremented on every edit anywhere in the map.
+	[[nodiscard]] auto revision() const -> std::uint64_t { return m_revision; }
+
+  private:
+	[[nodiscard]] auto index(sf::Vector2i const pos) const -> std::size_t { return static_cast<std::size_t>(pos.y * m_size.x + pos.x); }
+	void touch(sf::Vector2i pos);
+
+	memory::tagged_vector<tile_id, memory::tag::map> m_floors{};
+	memory::tagged_vector<tile_id, memory::tag::map> m_walls{};
+	memory::tagged_vector<std::uint64_t, memory::tag::map> m_chunk_revisions{};
+	sf::Vector2i m_size{};
+	sf::Vector2i m_chunks{};
+	std::uint64_t m_revision{};
+};
+} // namespace carise
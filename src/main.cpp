@@ -1,20 +1,130 @@
+#include <carise/audio/audio_thread.hpp>
+#include <carise/audio/sound_library.hpp>
+#include <carise/core/log.hpp>
+#include <carise/core/main_thread_queue.hpp>
+#include <carise/core/memory.hpp>
+#include <carise/core/metrics.hpp>
+#include <carise/debug/memory_overlay.hpp>
+#include <carise/debug/metrics_overlay.hpp>
+#include <carise/render/pixel_target.hpp>
+#include <carise/render/shape_batcher.hpp>
+#include <carise/ui/canvas.hpp>
 #include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+
+namespace {
+constexpr char const* debug_font_path_v{"assets/fonts/debug.ttf"};
+constexpr char const* memory_budgets_path_v{"memory_budgets.txt"};
+constexpr char const* memory_dump_path_v{"carise-memory.txt"};
+// unreferenced sound buffers are kept for reuse until this much audio is resident, unless memory_budgets.txt says otherwise
+constexpr std::size_t default_audio_budget_v{64 * 1024 * 1024};
+
+void load_memory_budgets(carise::memory::tracker& tracker) {
+	auto file = std::ifstream{memory_budgets_path_v};
+	if (!file) { return; }
+	auto const text = std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	CARISE_LOG_INFO("loaded {} memory budgets from {}", tracker.load_budgets(text), memory_budgets_path_v);
+}
+
+void dump_memory(carise::memory::tracker& tracker) {
+	auto report = std::string{};
+	tracker.write_report(report);
+	auto file = std::ofstream{memory_dump_path_v};
+	file << report;
+	CARISE_LOG_INFO("memory report written to {}", memory_dump_path_v);
+}
+} // namespace
 
 int main() {
+	carise::log::logger logger{};
+	CARISE_LOG_INFO("carise starting");
+
+	auto& metrics = carise::metrics::global();
+	auto& frame_time = metrics.get_histogram("carise_frame_seconds", "Wall time of one main loop iteration");
+	auto& frames = metrics.get_counter("carise_frames_total", "Frames presented");
+	// opt-in: point CARISE_METRICS_FILE at a node_exporter textfile collector directory to scrape in production
+	std::optional<carise::metrics::file_exporter> exporter{};
+	if (auto const* path = std::getenv("CARISE_METRICS_FILE")) { exporter.emplace(metrics, path); }
+
+	auto& memory = carise::memory::global();
+	load_memory_budgets(memory);
+	if (memory.budget(carise::memory::tag::audio) == 0) { memory.set_budget(carise::memory::tag::audio, default_audio_budget_v); }
+
 	sf::RenderWindow window(sf::VideoMode({200, 200}), "SFML works!");
-	sf::CircleShape shape(100.f);
-	shape.setFillColor(sf::Color::Green);
+	carise::shape_batcher shapes{};
+	// the world renders at a fixed resolution and is scaled up to the window; UI and overlays stay native
+	carise::pixel_target world{carise::pixel_target::config{.resolution = {200, 200}, .upscale = carise::pixel_target::filter::integer}};
 
+	carise::metrics_overlay overlay{metrics};
+	carise::memory_overlay memory_overlay{memory};
+	sf::Font debug_font{};
+	auto const has_font = std::filesystem::exists(debug_font_path_v) && debug_font.loadFromFile(debug_font_path_v);
+	if (has_font) {
+		overlay.set_font(debug_font);
+		memory_overlay.set_font(debug_font);
+	} else {
+		CARISE_LOG_WARN("debug font {} not found, metrics overlay shows the frame graph only", debug_font_path_v);
+	}
+
+	// retained: laid out and uploaded once, then replayed from a vertex buffer until a widget changes
+	carise::ui::canvas ui{{200.0f, 200.0f}};
+	auto const help_style = carise::ui::panel::style{.background = sf::Color{0, 0, 0, 160}, .padding = 4.0f};
+	auto& help = ui.root().add<carise::ui::panel>(carise::ui::panel::layout::column, help_style);
+	help.set_position({0.0f, 178.0f});
+	help.add<carise::ui::label>(has_font ? &debug_font : nullptr, "F3 metrics  F4 memory  F5 dump", 11);
+
+	// every sf::Sound lives on the audio thread; the game only posts commands
+	carise::audio::audio_thread audio{};
+	carise::audio::sound_library sounds{audio};
+
+	// work posted by other threads (loaders, audio, network) that must touch main-thread state
+	carise::main_thread_queue main_thread{};
+
+	sf::Clock frame_clock{};
+	float since_publish{};
 	while (window.isOpen()) {
+		auto const dt = frame_clock.restart();
+		frame_time.record(std::chrono::microseconds{dt.asMicroseconds()});
+		frames.add();
+		overlay.push_frame_time(dt.asSeconds());
+
 		sf::Event event;
 		while (window.pollEvent(event)) {
 			if (event.type == sf::Event::Closed) window.close();
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Key::F3) overlay.toggle();
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Key::F4) memory_overlay.toggle();
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Key::F5) dump_memory(memory);
+		}
+
+		main_thread.run_pending();
+		memory.enforce_budgets();
+		since_publish += dt.asSeconds();
+		if (since_publish >= 1.0f) {
+			memory.publish(metrics);
+			since_publish = 0.0f;
 		}
+		overlay.update(dt.asSeconds());
+		memory_overlay.update(dt.asSeconds());
+		ui.update();
 
-		window.clear();
-		window.draw(shape);
+		if (auto* target = world.begin()) {
+			shapes.circle({100.0f, 100.0f}, 100.0f, sf::Color::Green);
+			shapes.flush(*target);
+		}
+		world.present(window);
+		ui.draw(window);
+		overlay.draw(window);
+		memory_overlay.draw(window);
 		window.display();
+		audio.end_frame();
 	}
 
+	CARISE_LOG_INFO("carise shutting down");
 	return 0;
 }
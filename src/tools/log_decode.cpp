@@ -0,0 +1,134 @@
+#include <carise/core/log_format.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Decodes a binary log written by carise::log::logger into text on stdout.
+// usage: carise-logdecode <file.clog> [min-level]
+
+namespace {
+using namespace carise::log;
+
+struct reader {
+	template <typename Type>
+	auto read(Type& out) -> bool {
+		if (bytes.size() < sizeof(Type)) { return false; }
+		std::memcpy(&out, bytes.data(), sizeof(Type));
+		bytes = bytes.subspan(sizeof(Type));
+		return true;
+	}
+
+	auto read_bytes(std::size_t const count, std::span<std::byte const>& out) -> bool {
+		if (bytes.size() < count) { return false; }
+		out = bytes.first(count);
+		bytes = bytes.subspan(count);
+		return true;
+	}
+
+	auto read_string(std::string& out) -> bool {
+		auto length = std::uint16_t{};
+		auto str = std::span<std::byte const>{};
+		if (!read(length) || !read_bytes(length, str)) { return false; }
+		out.assign(reinterpret_cast<char const*>(str.data()), str.size());
+		return true;
+	}
+
+	std::span<std::byte const> bytes{};
+};
+
+/// \brief Site with owned strings: the file outlives the process that wrote it.
+struct owned_site {
+	site info{};
+	std::string file{};
+	std::string format{};
+};
+
+auto parse_level(std::string_view const str) -> level {
+	for (auto lvl : {level::trace, level::debug, level::info, level::warn, level::error}) {
+		if (to_string(lvl) == str) { return lvl; }
+	}
+	auto value = int{};
+	std::from_chars(str.data(), str.data() + str.size(), value);
+	return static_cast<level>(std::clamp(value, 0, static_cast<int>(level::error)));
+}
+} // namespace
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::fprintf(stderr, "usage: %s <file.clog> [min-level]\n", argv[0]);
+		return 1;
+	}
+	auto const min_level = argc > 2 ? parse_level(argv[2]) : level::trace;
+
+	auto file = std::ifstream{argv[1], std::ios::binary};
+	if (!file) {
+		std::fprintf(stderr, "failed to open %s\n", argv[1]);
+		return 1;
+	}
+	auto const data = std::vector<char>{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	auto in = reader{std::as_bytes(std::span{data})};
+
+	auto magic = std::array<char, 4>{};
+	auto version = std::uint32_t{};
+	auto start = std::int64_t{};
+	if (!in.read(magic) || magic != file::magic_v || !in.read(version) || version != file::version_v || !in.read(start)) {
+		std::fprintf(stderr, "%s is not a carise log (or unsupported version)\n", argv[1]);
+		return 1;
+	}
+
+	auto sites = std::unordered_map<std::uint32_t, owned_site>{};
+	auto line = std::string{};
+	auto type = file::chunk_type{};
+	while (in.read(type)) {
+		switch (type) {
+		case file::chunk_type::site: {
+			auto entry = owned_site{};
+			if (!in.read(entry.info.id) || !in.read(entry.info.lvl) || !in.read(entry.info.line) || !in.read_string(entry.file) ||
+				!in.read_string(entry.format)) {
+				break;
+			}
+			sites.insert_or_assign(entry.info.id, std::move(entry));
+			continue;
+		}
+		case file::chunk_type::entry: {
+			auto id = std::uint32_t{};
+			auto thread = std::uint16_t{};
+			auto timestamp = std::int64_t{};
+			auto size = std::uint16_t{};
+			auto payload = std::span<std::byte const>{};
+			if (!in.read(id) || !in.read(thread) || !in.read(timestamp) || !in.read(size) || !in.read_bytes(size, payload)) { break; }
+			auto it = sites.find(id);
+			if (it == sites.end()) {
+				std::fprintf(stderr, "entry references unknown site %u\n", id);
+				continue;
+			}
+			auto& entry = it->second;
+			if (entry.info.lvl < min_level) { continue; }
+			entry.info.file = entry.file;
+			entry.info.format = entry.format;
+			line.clear();
+			format_line(line, entry.info, timestamp, thread, payload);
+			std::fwrite(line.data(), 1, line.size(), stdout);
+			continue;
+		}
+		case file::chunk_type::dropped: {
+			auto thread = std::uint16_t{};
+			auto count = std::uint64_t{};
+			if (!in.read(thread) || !in.read(count)) { break; }
+			std::printf("-- t%u dropped %llu records (ring buffer full)\n", thread, static_cast<unsigned long long>(count));
+			continue;
+		}
+		default: break;
+		}
+		std::fprintf(stderr, "corrupt or truncated chunk, stopping\n");
+		return 1;
+	}
+	return 0;
+}
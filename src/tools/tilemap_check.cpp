@@ -0,0 +1,108 @@
+#include <carise/core/random.hpp>
+#include <carise/render/shader_tile_map.hpp>
+#include <carise/render/tile_atlas.hpp>
+#include <carise/render/tile_map_renderer.hpp>
+#include <carise/world/tile_map.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Renders the same map through tile_map_renderer and shader_tile_map at several zoom levels and compares the
+// images pixel by pixel. Exit code 0 if they match, 1 if not, 2 if shaders are unavailable.
+// Runs headless on Mesa's software rasterizer: xvfb-run -a env LIBGL_ALWAYS_SOFTWARE=1 carise-tilemap-check
+// usage: carise-tilemap-check [output-prefix]  (writes <prefix>-<zoom>-{vertex,shader}.png on mismatch)
+
+namespace {
+using namespace carise;
+
+constexpr sf::Vector2u target_size_v{640, 480};
+constexpr int channel_tolerance_v{8};
+// edge pixels may legitimately round differently between rasterizing tile quads and computing tiles per pixel
+constexpr double max_mismatch_ratio_v{0.002};
+
+auto make_map(tile_atlas const& atlas) -> tile_map {
+	auto ret = tile_map{{150, 110}};
+	auto random = rng{42};
+	auto const last = static_cast<int>(atlas.tile_count()) - 1;
+	for (int y = 0; y < ret.size().y; ++y) {
+		for (int x = 0; x < ret.size().x; ++x) {
+			ret.set_floor({x, y}, static_cast<tile_id>(random.range(0, last)));
+			if (random.chance(0.2f)) { ret.set_wall({x, y}, static_cast<tile_id>(random.range(0, last))); }
+		}
+	}
+	return ret;
+}
+
+auto mismatch_ratio(sf::Image const& a, sf::Image const& b) -> double {
+	auto const size = a.getSize();
+	auto const* pa = a.getPixelsPtr();
+	auto const* pb = b.getPixelsPtr();
+	std::size_t mismatched{};
+	for (std::size_t i = 0; i < std::size_t{size.x} * size.y; ++i) {
+		for (std::size_t c = 0; c < 4; ++c) {
+			if (std::abs(static_cast<int>(pa[i * 4 + c]) - static_cast<int>(pb[i * 4 + c])) > channel_tolerance_v) {
+				++mismatched;
+				break;
+			}
+		}
+	}
+	return static_cast<double>(mismatched) / static_cast<double>(std::size_t{size.x} * size.y);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+	auto const prefix = std::string{argc > 1 ? argv[1] : "tilemap-check"};
+	if (!shader_tile_map::is_available()) {
+		std::fputs("shaders unavailable\n", stderr);
+		return 2;
+	}
+
+	auto atlas_texture = sf::Texture{};
+	if (!atlas_texture.loadFromImage(make_debug_atlas_image({16, 16}, 64))) { return 2; }
+	auto const atlas = tile_atlas{atlas_texture, {16, 16}};
+	auto map = make_map(atlas);
+
+	auto vertex = tile_map_renderer{atlas};
+	vertex.update(map);
+	auto shader = shader_tile_map{atlas};
+	if (!shader.create(map)) {
+		std::fputs("failed to create shader tile map\n", stderr);
+		return 2;
+	}
+	auto vertex_target = sf::RenderTexture{};
+	auto shader_target = sf::RenderTexture{};
+	if (!vertex_target.create(target_size_v) || !shader_target.create(target_size_v)) { return 2; }
+
+	// edit after creation so the incremental upload path is covered too
+	map.set_wall({5, 5}, 1);
+	map.set_floor({70, 60}, 2);
+	vertex.update(map);
+	shader.update(map);
+
+	auto failed = false;
+	for (auto const zoom : {1.0f, 2.0f, 0.5f, 3.7f}) {
+		auto const view = sf::View{{640.0f, 480.0f}, sf::Vector2f{static_cast<float>(target_size_v.x), static_cast<float>(target_size_v.y)} * zoom};
+		vertex_target.clear();
+		vertex_target.setView(view);
+		vertex.draw(vertex_target, tile_layer::floor);
+		vertex.draw(vertex_target, tile_layer::walls);
+		vertex_target.display();
+		shader_target.clear();
+		shader_target.setView(view);
+		shader.draw(shader_target);
+		shader_target.display();
+
+		auto const a = vertex_target.getTexture().copyToImage();
+		auto const b = shader_target.getTexture().copyToImage();
+		auto const ratio = mismatch_ratio(a, b);
+		auto const ok = ratio <= max_mismatch_ratio_v;
+		std::printf("zoom %.1f: %.3f%% pixels differ %s\n", static_cast<double>(zoom), ratio * 100.0, ok ? "ok" : "FAIL");
+		if (!ok) {
+			failed = true;
+			auto const name = prefix + "-" + std::to_string(static_cast<int>(zoom * 10.0f));
+			static_cast<void>(a.saveToFile(name + "-vertex.png"));
+			static_cast<void>(b.saveToFile(name + "-shader.png"));
+		}
+	}
+	return failed ? 1 : 0;
+}